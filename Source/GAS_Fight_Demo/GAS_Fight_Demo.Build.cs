@@ -13,13 +13,19 @@ public class GAS_Fight_Demo : ModuleRules
 			"Core", "CoreUObject", "Engine", "InputCore", "EnhancedInput",
             "GameplayAbilities", "GameplayTags", "GameplayTasks",
             "AnimGraphRuntime", "MotionWarping", "Niagara",
-			"NavigationSystem", "AIModule",
+			"NavigationSystem", "AIModule", "NetCore",
             "UMG",
             "MoviePlayer"
         });
 
 		PrivateDependencyModuleNames.AddRange(new string[] {  });
 
+		// Editor automation tests start multi-client PIE sessions
+		if (Target.bBuildEditor)
+		{
+			PrivateDependencyModuleNames.Add("UnrealEd");
+		}
+
 		// Uncomment if you are using Slate UI
 		// PrivateDependencyModuleNames.AddRange(new string[] { "Slate", "SlateCore" });
 		
@@ -3,4 +3,6 @@
 #include "GAS_Fight_Demo.h"
 #include "Modules/ModuleManager.h"
 
+DEFINE_LOG_CATEGORY(LogFight);
+
 IMPLEMENT_PRIMARY_GAME_MODULE( FDefaultGameModuleImpl, GAS_Fight_Demo, "GAS_Fight_Demo" );
@@ -4,3 +4,5 @@
 
 #include "CoreMinimal.h"
 
+GAS_FIGHT_DEMO_API DECLARE_LOG_CATEGORY_EXTERN(LogFight, Log, All);
+
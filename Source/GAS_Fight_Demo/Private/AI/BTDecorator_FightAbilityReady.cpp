@@ -0,0 +1,80 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "AI/BTDecorator_FightAbilityReady.h"
+#include "AI/FightBTStats.h"
+#include "AIController.h"
+#include "AbilitySystemBlueprintLibrary.h"
+#include "GAS/FightAbilitySystemComponent.h"
+
+
+DECLARE_CYCLE_STAT(TEXT("Decorator AbilityReady"), STAT_FightBT_DecoratorAbilityReady, STATGROUP_FightBT);
+
+
+UBTDecorator_FightAbilityReady::UBTDecorator_FightAbilityReady()
+{
+	NodeName = TEXT("Native Ability Ready");
+
+	INIT_DECORATOR_NODE_NOTIFY_FLAGS();
+
+	MinReselectInterval = 0.f;
+
+	// 冷却结束没有对应的黑板变化可观察，只在选择分支时判断
+	bAllowAbortLowerPri = false;
+	bAllowAbortChildNodes = false;
+	FlowAbortMode = EBTFlowAbortMode::None;
+}
+
+uint16 UBTDecorator_FightAbilityReady::GetInstanceMemorySize() const
+{
+	return sizeof(FFightAbilityReadyDecoratorMemory);
+}
+
+void UBTDecorator_FightAbilityReady::InitializeMemory(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory,
+	EBTMemoryInit::Type InitType) const
+{
+	InitializeNodeMemory<FFightAbilityReadyDecoratorMemory>(NodeMemory, InitType);
+}
+
+void UBTDecorator_FightAbilityReady::CleanupMemory(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory,
+	EBTMemoryClear::Type CleanupType) const
+{
+	CleanupNodeMemory<FFightAbilityReadyDecoratorMemory>(NodeMemory, CleanupType);
+}
+
+FString UBTDecorator_FightAbilityReady::GetStaticDescription() const
+{
+	return FString::Printf(TEXT("%s: %s ready, reselect after %ss"), *Super::GetStaticDescription(),
+		*AbilityTag.ToString(), *FString::SanitizeFloat(MinReselectInterval));
+}
+
+bool UBTDecorator_FightAbilityReady::CalculateRawConditionValue(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory) const
+{
+	SCOPE_CYCLE_COUNTER(STAT_FightBT_DecoratorAbilityReady);
+
+	const FFightAbilityReadyDecoratorMemory* Memory = CastInstanceNodeMemory<FFightAbilityReadyDecoratorMemory>(NodeMemory);
+
+	if (Memory->bHasActivated && OwnerComp.GetWorld()->GetTimeSeconds() - Memory->LastActivationTime < MinReselectInterval)
+	{
+		return false;
+	}
+
+	APawn* OwningPawn = OwnerComp.GetAIOwner() ? OwnerComp.GetAIOwner()->GetPawn() : nullptr;
+	if (!OwningPawn)
+	{
+		return false;
+	}
+
+	UFightAbilitySystemComponent* AbilitySystemComponent = Cast<UFightAbilitySystemComponent>(
+		UAbilitySystemBlueprintLibrary::GetAbilitySystemComponent(OwningPawn));
+
+	return AbilitySystemComponent && AbilitySystemComponent->HasActivatableAbilityByTag(AbilityTag);
+}
+
+void UBTDecorator_FightAbilityReady::OnNodeActivation(FBehaviorTreeSearchData& SearchData)
+{
+	FFightAbilityReadyDecoratorMemory* Memory = GetNodeMemory<FFightAbilityReadyDecoratorMemory>(SearchData);
+
+	Memory->LastActivationTime = SearchData.OwnerComp.GetWorld()->GetTimeSeconds();
+	Memory->bHasActivated = true;
+}
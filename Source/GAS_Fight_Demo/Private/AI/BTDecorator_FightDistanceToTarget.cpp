@@ -0,0 +1,70 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "AI/BTDecorator_FightDistanceToTarget.h"
+#include "AI/FightBTStats.h"
+#include "AIController.h"
+#include "BehaviorTree/BlackboardComponent.h"
+#include "BehaviorTree/BlackboardData.h"
+#include "BehaviorTree/Blackboard/BlackboardKeyType_Object.h"
+
+
+DECLARE_CYCLE_STAT(TEXT("Decorator DistanceToTarget"), STAT_FightBT_DecoratorDistanceToTarget, STATGROUP_FightBT);
+
+
+UBTDecorator_FightDistanceToTarget::UBTDecorator_FightDistanceToTarget()
+{
+	NodeName = TEXT("Native Distance To Target");
+
+	INIT_DECORATOR_NODE_NOTIFY_FLAGS();
+
+	MinDistance = 0.f;
+	MaxDistance = 300.f;
+	bUse2DDistance = true;
+
+	InTargetActorKey.AddObjectFilter(this, GET_MEMBER_NAME_CHECKED(ThisClass, InTargetActorKey), AActor::StaticClass());
+}
+
+void UBTDecorator_FightDistanceToTarget::InitializeFromAsset(UBehaviorTree& Asset)
+{
+	Super::InitializeFromAsset(Asset);
+
+	if (UBlackboardData* BBAsset = GetBlackboardAsset())
+	{
+		InTargetActorKey.ResolveSelectedKey(*BBAsset);
+	}
+
+	// 不需要中断时无需每帧重新判断
+	bNotifyTick = FlowAbortMode != EBTFlowAbortMode::None;
+}
+
+FString UBTDecorator_FightDistanceToTarget::GetStaticDescription() const
+{
+	return FString::Printf(TEXT("%s: %s Key distance in [%s, %s]"), *Super::GetStaticDescription(),
+		*InTargetActorKey.SelectedKeyName.ToString(), *FString::SanitizeFloat(MinDistance), *FString::SanitizeFloat(MaxDistance));
+}
+
+bool UBTDecorator_FightDistanceToTarget::CalculateRawConditionValue(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory) const
+{
+	SCOPE_CYCLE_COUNTER(STAT_FightBT_DecoratorDistanceToTarget);
+
+	const APawn* OwningPawn = OwnerComp.GetAIOwner() ? OwnerComp.GetAIOwner()->GetPawn() : nullptr;
+	const AActor* TargetActor = Cast<AActor>(
+		OwnerComp.GetBlackboardComponent()->GetValue<UBlackboardKeyType_Object>(InTargetActorKey.GetSelectedKeyID()));
+
+	if (!OwningPawn || !TargetActor)
+	{
+		return false;
+	}
+
+	// 比较距离的平方，省去开方
+	const FVector Offset = TargetActor->GetActorLocation() - OwningPawn->GetActorLocation();
+	const double DistanceSquared = bUse2DDistance ? Offset.SizeSquared2D() : Offset.SizeSquared();
+
+	return DistanceSquared >= FMath::Square(MinDistance) && DistanceSquared <= FMath::Square(MaxDistance);
+}
+
+void UBTDecorator_FightDistanceToTarget::TickNode(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, float DeltaSeconds)
+{
+	ConditionalFlowAbort(OwnerComp, EBTDecoratorAbortRequest::ConditionResultChanged);
+}
@@ -0,0 +1,109 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "AI/BTService_FightDistanceToTarget.h"
+#include "AI/FightBTStats.h"
+#include "AIController.h"
+#include "BehaviorTree/BlackboardComponent.h"
+#include "BehaviorTree/BlackboardData.h"
+#include "BehaviorTree/Blackboard/BlackboardKeyType_Object.h"
+#include "BehaviorTree/Blackboard/BlackboardKeyType_Float.h"
+#include "BehaviorTree/Blackboard/BlackboardKeyType_Bool.h"
+
+
+DECLARE_CYCLE_STAT(TEXT("Service DistanceToTarget"), STAT_FightBT_ServiceDistanceToTarget, STATGROUP_FightBT);
+
+
+UBTService_FightDistanceToTarget::UBTService_FightDistanceToTarget()
+{
+	NodeName = TEXT("Native Distance To Target");
+
+	INIT_SERVICE_NODE_NOTIFY_FLAGS();
+
+	Interval = 0.2f;
+	RandomDeviation = 0.05f;
+
+	InRangeDistance = 200.f;
+	DistanceWriteTolerance = 10.f;
+	bUse2DDistance = true;
+
+	InTargetActorKey.AddObjectFilter(this, GET_MEMBER_NAME_CHECKED(ThisClass, InTargetActorKey), AActor::StaticClass());
+
+	OutDistanceKey.AddFloatFilter(this, GET_MEMBER_NAME_CHECKED(ThisClass, OutDistanceKey));
+	OutDistanceKey.AllowNoneAsValue(true);
+
+	OutIsInRangeKey.AddBoolFilter(this, GET_MEMBER_NAME_CHECKED(ThisClass, OutIsInRangeKey));
+	OutIsInRangeKey.AllowNoneAsValue(true);
+}
+
+void UBTService_FightDistanceToTarget::InitializeFromAsset(UBehaviorTree& Asset)
+{
+	Super::InitializeFromAsset(Asset);
+
+	if (UBlackboardData* BBAsset = GetBlackboardAsset())
+	{
+		InTargetActorKey.ResolveSelectedKey(*BBAsset);
+		OutDistanceKey.ResolveSelectedKey(*BBAsset);
+		OutIsInRangeKey.ResolveSelectedKey(*BBAsset);
+	}
+}
+
+uint16 UBTService_FightDistanceToTarget::GetInstanceMemorySize() const
+{
+	return sizeof(FFightDistanceToTargetServiceMemory);
+}
+
+void UBTService_FightDistanceToTarget::InitializeMemory(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory,
+	EBTMemoryInit::Type InitType) const
+{
+	InitializeNodeMemory<FFightDistanceToTargetServiceMemory>(NodeMemory, InitType);
+}
+
+void UBTService_FightDistanceToTarget::CleanupMemory(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory,
+	EBTMemoryClear::Type CleanupType) const
+{
+	CleanupNodeMemory<FFightDistanceToTargetServiceMemory>(NodeMemory, CleanupType);
+}
+
+FString UBTService_FightDistanceToTarget::GetStaticDescription() const
+{
+	return FString::Printf(TEXT("Distance to %s Key -> %s, in range (%s) -> %s\n%s"),
+		*InTargetActorKey.SelectedKeyName.ToString(), *OutDistanceKey.SelectedKeyName.ToString(),
+		*FString::SanitizeFloat(InRangeDistance), *OutIsInRangeKey.SelectedKeyName.ToString(), *GetStaticServiceDescription());
+}
+
+void UBTService_FightDistanceToTarget::TickNode(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, float DeltaSeconds)
+{
+	SCOPE_CYCLE_COUNTER(STAT_FightBT_ServiceDistanceToTarget);
+
+	Super::TickNode(OwnerComp, NodeMemory, DeltaSeconds);
+
+	UBlackboardComponent* Blackboard = OwnerComp.GetBlackboardComponent();
+	const APawn* OwningPawn = OwnerComp.GetAIOwner()->GetPawn();
+	const AActor* TargetActor = Cast<AActor>(
+		Blackboard->GetValue<UBlackboardKeyType_Object>(InTargetActorKey.GetSelectedKeyID()));
+
+	if (!OwningPawn || !TargetActor)
+	{
+		return;
+	}
+
+	const FVector Offset = TargetActor->GetActorLocation() - OwningPawn->GetActorLocation();
+	const float Distance = bUse2DDistance ? Offset.Size2D() : Offset.Size();
+
+	FFightDistanceToTargetServiceMemory* Memory = CastInstanceNodeMemory<FFightDistanceToTargetServiceMemory>(NodeMemory);
+
+	if (OutDistanceKey.IsSet() &&
+		(Memory->LastWrittenDistance < 0.f || FMath::Abs(Distance - Memory->LastWrittenDistance) > DistanceWriteTolerance))
+	{
+		Memory->LastWrittenDistance = Distance;
+		Blackboard->SetValue<UBlackboardKeyType_Float>(OutDistanceKey.GetSelectedKeyID(), Distance);
+	}
+
+	const int8 bIsInRange = Distance <= InRangeDistance ? 1 : 0;
+	if (OutIsInRangeKey.IsSet() && Memory->LastWrittenInRange != bIsInRange)
+	{
+		Memory->LastWrittenInRange = bIsInRange;
+		Blackboard->SetValue<UBlackboardKeyType_Bool>(OutIsInRangeKey.GetSelectedKeyID(), bIsInRange != 0);
+	}
+}
@@ -5,7 +5,7 @@
 #include "AIController.h"
 #include "BehaviorTree/BlackboardComponent.h"
 #include "BehaviorTree/BlackboardData.h"
-#include "Kismet/KismetMathLibrary.h"
+#include "AI/FightOrientationSubsystem.h"
 
 
 UBTService_OrientToTargetActor::UBTService_OrientToTargetActor()
@@ -13,14 +13,10 @@ UBTService_OrientToTargetActor::UBTService_OrientToTargetActor()
 	// 设置节点名称，这个名称会在行为树编辑器中显示
 	NodeName = TEXT("Native Orient Rotation To Target Actor");
 
-	// 初始化服务节点通知标志 --> 这个宏通常设置节点是否需要特定的通知或回调
+	// 初始化服务节点通知标志 --> 这个宏根据重写的函数设置通知标志，这里只会开启BecomeRelevant/CeaseRelevant
 	INIT_SERVICE_NODE_NOTIFY_FLAGS();
 
 	RotationInterpSpeed = 5.0f;
-	// 设置服务执行间隔为0，表示每帧都执行
-	Interval = 0.f;
-	// 随机偏差为0，表示执行时间没有随机变化
-	RandomDeviation = 0.f;
 
 	// 配置黑板键选择器的过滤器 --> AddObjectFilter为黑板键添加对象类型过滤器
 	// 参数说明：
@@ -52,27 +48,27 @@ FString UBTService_OrientToTargetActor::GetStaticDescription() const
 	return FString::Printf(TEXT("Orient rotation to %s Key %s"), *KeyDescription, *GetStaticServiceDescription());
 }
 
-void UBTService_OrientToTargetActor::TickNode(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, float DeltaSeconds)
+void UBTService_OrientToTargetActor::OnBecomeRelevant(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory)
 {
-	Super::TickNode(OwnerComp, NodeMemory, DeltaSeconds);
-
-	UObject* ActorObject = OwnerComp.GetBlackboardComponent()->GetValueAsObject(InTargetActorKey.SelectedKeyName);
-	AActor* TargetActor = Cast<AActor>(ActorObject);
+	Super::OnBecomeRelevant(OwnerComp, NodeMemory);
 
 	APawn* OwningPawn = OwnerComp.GetAIOwner()->GetPawn();
+	UFightOrientationSubsystem* OrientationSubsystem = UWorld::GetSubsystem<UFightOrientationSubsystem>(OwnerComp.GetWorld());
 
-	if (OwningPawn && TargetActor)
+	if (OwningPawn && OrientationSubsystem)
 	{
-		// 计算从AI当前位置看向目标位置所需的旋转 --> 这个旋转会使AI的正面（X轴正方向）指向目标
-		// FindLookAtRotation(起始位置, 目标位置): 返回看向目标所需的旋转值
-		const FRotator LookAtRot = UKismetMathLibrary::FindLookAtRotation(OwningPawn->GetActorLocation(),
-			TargetActor->GetActorLocation());
-
-		// 使用插值计算平滑的旋转过渡 --> RInterpTo(当前旋转, 目标旋转, 时间增量, 插值速度)
-		// 根据插值速度和时间增量，从当前旋转平滑过渡到目标旋转 --> 这样可以避免AI突然转向，实现自然的旋转动画
-		const FRotator TargetRot = FMath::RInterpTo(OwningPawn->GetActorRotation(), LookAtRot,
-			DeltaSeconds, RotationInterpSpeed);
+		// 目标由子系统每帧从黑板键读取，黑板中的目标变化后无需重新注册
+		OrientationSubsystem->RegisterOrientationRequest(OwningPawn, OwnerComp.GetBlackboardComponent(),
+			InTargetActorKey.GetSelectedKeyID(), RotationInterpSpeed, this);
+	}
+}
 
-		OwningPawn->SetActorRotation(TargetRot);
+void UBTService_OrientToTargetActor::OnCeaseRelevant(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory)
+{
+	if (UFightOrientationSubsystem* OrientationSubsystem = UWorld::GetSubsystem<UFightOrientationSubsystem>(OwnerComp.GetWorld()))
+	{
+		OrientationSubsystem->UnregisterOrientationRequest(OwnerComp.GetAIOwner()->GetPawn(), this);
 	}
+
+	Super::OnCeaseRelevant(OwnerComp, NodeMemory);
 }
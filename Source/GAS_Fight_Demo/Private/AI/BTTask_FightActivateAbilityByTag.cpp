@@ -0,0 +1,127 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "AI/BTTask_FightActivateAbilityByTag.h"
+#include "AI/FightBTStats.h"
+#include "AIController.h"
+#include "AbilitySystemBlueprintLibrary.h"
+#include "GAS/FightAbilitySystemComponent.h"
+
+
+DECLARE_CYCLE_STAT(TEXT("Task ActivateAbilityByTag"), STAT_FightBT_TaskActivateAbilityByTag, STATGROUP_FightBT);
+
+
+UBTTask_FightActivateAbilityByTag::UBTTask_FightActivateAbilityByTag()
+{
+	NodeName = TEXT("Native Activate Ability By Tag");
+
+	bWaitForAbilityEnd = true;
+	TimeLimit = 0.f;
+	bCancelAbilityOnAbort = true;
+
+	bNotifyTick = true;
+	bCreateNodeInstance = false;
+
+	INIT_TASK_NODE_NOTIFY_FLAGS();
+}
+
+uint16 UBTTask_FightActivateAbilityByTag::GetInstanceMemorySize() const
+{
+	return sizeof(FFightActivateAbilityByTagTaskMemory);
+}
+
+void UBTTask_FightActivateAbilityByTag::InitializeMemory(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory,
+	EBTMemoryInit::Type InitType) const
+{
+	InitializeNodeMemory<FFightActivateAbilityByTagTaskMemory>(NodeMemory, InitType);
+}
+
+void UBTTask_FightActivateAbilityByTag::CleanupMemory(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory,
+	EBTMemoryClear::Type CleanupType) const
+{
+	CleanupNodeMemory<FFightActivateAbilityByTagTaskMemory>(NodeMemory, CleanupType);
+}
+
+FString UBTTask_FightActivateAbilityByTag::GetStaticDescription() const
+{
+	return FString::Printf(TEXT("Activate %s%s"), *AbilityTag.ToString(),
+		bWaitForAbilityEnd ? TEXT(" and wait for end") : TEXT(""));
+}
+
+EBTNodeResult::Type UBTTask_FightActivateAbilityByTag::ExecuteTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory)
+{
+	SCOPE_CYCLE_COUNTER(STAT_FightBT_TaskActivateAbilityByTag);
+
+	APawn* OwningPawn = OwnerComp.GetAIOwner() ? OwnerComp.GetAIOwner()->GetPawn() : nullptr;
+	if (!OwningPawn || !AbilityTag.IsValid())
+	{
+		return EBTNodeResult::Failed;
+	}
+
+	// 棋子可能正在销毁或还没有初始化能力系统 --> 不使用会断言的NativeGetFighterASCFromActor
+	UFightAbilitySystemComponent* AbilitySystemComponent = Cast<UFightAbilitySystemComponent>(
+		UAbilitySystemBlueprintLibrary::GetAbilitySystemComponent(OwningPawn));
+	if (!AbilitySystemComponent)
+	{
+		return EBTNodeResult::Failed;
+	}
+
+	FFightActivateAbilityByTagTaskMemory* Memory = CastInstanceNodeMemory<FFightActivateAbilityByTagTaskMemory>(NodeMemory);
+	Memory->AbilitySystemComponent = AbilitySystemComponent;
+	Memory->ActivatedSpecHandle = FGameplayAbilitySpecHandle();
+	Memory->ElapsedTime = 0.f;
+
+	if (!AbilitySystemComponent->NativeTryActivateAbilityByTag(AbilityTag, Memory->ActivatedSpecHandle))
+	{
+		return EBTNodeResult::Failed;
+	}
+
+	if (!bWaitForAbilityEnd)
+	{
+		return EBTNodeResult::Succeeded;
+	}
+
+	// 能力可能在激活过程中就已经结束
+	const FGameplayAbilitySpec* AbilitySpec = AbilitySystemComponent->FindAbilitySpecFromHandle(Memory->ActivatedSpecHandle);
+	return AbilitySpec && AbilitySpec->IsActive() ? EBTNodeResult::InProgress : EBTNodeResult::Succeeded;
+}
+
+EBTNodeResult::Type UBTTask_FightActivateAbilityByTag::AbortTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory)
+{
+	FFightActivateAbilityByTagTaskMemory* Memory = CastInstanceNodeMemory<FFightActivateAbilityByTagTaskMemory>(NodeMemory);
+
+	if (bCancelAbilityOnAbort && Memory->AbilitySystemComponent.IsValid())
+	{
+		Memory->AbilitySystemComponent->CancelAbilityHandle(Memory->ActivatedSpecHandle);
+	}
+
+	return Super::AbortTask(OwnerComp, NodeMemory);
+}
+
+void UBTTask_FightActivateAbilityByTag::TickTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, float DeltaSeconds)
+{
+	SCOPE_CYCLE_COUNTER(STAT_FightBT_TaskActivateAbilityByTag);
+
+	FFightActivateAbilityByTagTaskMemory* Memory = CastInstanceNodeMemory<FFightActivateAbilityByTagTaskMemory>(NodeMemory);
+
+	UFightAbilitySystemComponent* AbilitySystemComponent = Memory->AbilitySystemComponent.Get();
+	if (!AbilitySystemComponent)
+	{
+		FinishLatentTask(OwnerComp, EBTNodeResult::Failed);
+		return;
+	}
+
+	const FGameplayAbilitySpec* AbilitySpec = AbilitySystemComponent->FindAbilitySpecFromHandle(Memory->ActivatedSpecHandle);
+	if (!AbilitySpec || !AbilitySpec->IsActive())
+	{
+		FinishLatentTask(OwnerComp, EBTNodeResult::Succeeded);
+		return;
+	}
+
+	Memory->ElapsedTime += DeltaSeconds;
+	if (TimeLimit > 0.f && Memory->ElapsedTime >= TimeLimit)
+	{
+		AbilitySystemComponent->CancelAbilityHandle(Memory->ActivatedSpecHandle);
+		FinishLatentTask(OwnerComp, EBTNodeResult::Failed);
+	}
+}
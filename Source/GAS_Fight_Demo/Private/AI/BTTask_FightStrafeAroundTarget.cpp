@@ -0,0 +1,192 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "AI/BTTask_FightStrafeAroundTarget.h"
+#include "AI/FightBTStats.h"
+#include "AIController.h"
+#include "BehaviorTree/BlackboardComponent.h"
+#include "BehaviorTree/BlackboardData.h"
+#include "BehaviorTree/Blackboard/BlackboardKeyType_Object.h"
+#include "GameFramework/Character.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "FightFunctionLibrary.h"
+#include "GAS/FightGameplayTags.h"
+#include "Game/FightBaseGameMode.h"
+
+
+DECLARE_CYCLE_STAT(TEXT("Task StrafeAroundTarget"), STAT_FightBT_TaskStrafeAroundTarget, STATGROUP_FightBT);
+
+
+UBTTask_FightStrafeAroundTarget::UBTTask_FightStrafeAroundTarget()
+{
+	NodeName = TEXT("Native Strafe Around Target");
+
+	StrafeRadius = 0.f;
+	StrafeDuration = 2.f;
+	StrafeDurationDeviation = 0.5f;
+	RadiusCorrectionStrength = 1.f;
+	bRandomDirection = true;
+
+	bNotifyTick = true;
+	bNotifyTaskFinished = true;
+	bCreateNodeInstance = false;
+
+	INIT_TASK_NODE_NOTIFY_FLAGS();
+
+	InTargetActorKey.AddObjectFilter(this, GET_MEMBER_NAME_CHECKED(ThisClass, InTargetActorKey), AActor::StaticClass());
+}
+
+void UBTTask_FightStrafeAroundTarget::InitializeFromAsset(UBehaviorTree& Asset)
+{
+	Super::InitializeFromAsset(Asset);
+
+	if (UBlackboardData* BBAsset = GetBlackboardAsset())
+	{
+		InTargetActorKey.ResolveSelectedKey(*BBAsset);
+	}
+}
+
+uint16 UBTTask_FightStrafeAroundTarget::GetInstanceMemorySize() const
+{
+	return sizeof(FFightStrafeAroundTargetTaskMemory);
+}
+
+void UBTTask_FightStrafeAroundTarget::InitializeMemory(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory,
+	EBTMemoryInit::Type InitType) const
+{
+	InitializeNodeMemory<FFightStrafeAroundTargetTaskMemory>(NodeMemory, InitType);
+}
+
+void UBTTask_FightStrafeAroundTarget::CleanupMemory(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory,
+	EBTMemoryClear::Type CleanupType) const
+{
+	CleanupNodeMemory<FFightStrafeAroundTargetTaskMemory>(NodeMemory, CleanupType);
+}
+
+FString UBTTask_FightStrafeAroundTarget::GetStaticDescription() const
+{
+	return FString::Printf(TEXT("Strafe around %s Key for %s+-%ss"), *InTargetActorKey.SelectedKeyName.ToString(),
+		*FString::SanitizeFloat(StrafeDuration), *FString::SanitizeFloat(StrafeDurationDeviation));
+}
+
+EBTNodeResult::Type UBTTask_FightStrafeAroundTarget::ExecuteTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory)
+{
+	SCOPE_CYCLE_COUNTER(STAT_FightBT_TaskStrafeAroundTarget);
+
+	AAIController* AIController = OwnerComp.GetAIOwner();
+	APawn* OwningPawn = AIController->GetPawn();
+	AActor* TargetActor = Cast<AActor>(
+		OwnerComp.GetBlackboardComponent()->GetValue<UBlackboardKeyType_Object>(InTargetActorKey.GetSelectedKeyID()));
+
+	if (!OwningPawn || !TargetActor)
+	{
+		return EBTNodeResult::Failed;
+	}
+
+	FFightStrafeAroundTargetTaskMemory* Memory = CastInstanceNodeMemory<FFightStrafeAroundTargetTaskMemory>(NodeMemory);
+	Memory->OwningPawn = OwningPawn;
+	Memory->TargetActor = TargetActor;
+	// 使用游戏模式的玩法随机流 --> 确定性模式下扫射时长与方向可以随输入日志一起复现
+	float DurationDeviation = 0.f;
+	bool bReverseDirection = false;
+
+	if (AFightBaseGameMode* BaseGameMode = OwningPawn->GetWorld()->GetAuthGameMode<AFightBaseGameMode>())
+	{
+		FRandomStream& RandomStream = BaseGameMode->GetGameplayRandomStream();
+		DurationDeviation = RandomStream.FRandRange(-StrafeDurationDeviation, StrafeDurationDeviation);
+		bReverseDirection = bRandomDirection && RandomStream.FRand() < 0.5f;
+	}
+	else
+	{
+		DurationDeviation = FMath::FRandRange(-StrafeDurationDeviation, StrafeDurationDeviation);
+		bReverseDirection = bRandomDirection && FMath::RandBool();
+	}
+
+	Memory->RemainingTime = FMath::Max(StrafeDuration + DurationDeviation, 0.f);
+	Memory->DirectionSign = bReverseDirection ? -1.f : 1.f;
+	Memory->DesiredRadius = StrafeRadius > 0.f ?
+		StrafeRadius : FVector::Dist2D(OwningPawn->GetActorLocation(), TargetActor->GetActorLocation());
+
+	// 扫射时始终面向目标，朝向改为跟随控制器的聚焦方向
+	if (const ACharacter* OwningCharacter = Cast<ACharacter>(OwningPawn))
+	{
+		UCharacterMovementComponent* MovementComponent = OwningCharacter->GetCharacterMovement();
+		Memory->bSavedOrientRotationToMovement = MovementComponent->bOrientRotationToMovement;
+		Memory->bSavedUseControllerDesiredRotation = MovementComponent->bUseControllerDesiredRotation;
+
+		MovementComponent->bOrientRotationToMovement = false;
+		MovementComponent->bUseControllerDesiredRotation = true;
+	}
+
+	AIController->SetFocus(TargetActor);
+	UFightFunctionLibrary::AddGameplayTagToActorIfNone(OwningPawn, FightGameplayTags::Enemy_Status_Strafing);
+
+	return EBTNodeResult::InProgress;
+}
+
+void UBTTask_FightStrafeAroundTarget::TickTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, float DeltaSeconds)
+{
+	SCOPE_CYCLE_COUNTER(STAT_FightBT_TaskStrafeAroundTarget);
+
+	FFightStrafeAroundTargetTaskMemory* Memory = CastInstanceNodeMemory<FFightStrafeAroundTargetTaskMemory>(NodeMemory);
+
+	APawn* OwningPawn = Memory->OwningPawn.Get();
+	const AActor* TargetActor = Memory->TargetActor.Get();
+
+	if (!OwningPawn || !TargetActor)
+	{
+		FinishLatentTask(OwnerComp, EBTNodeResult::Failed);
+		return;
+	}
+
+	Memory->RemainingTime -= DeltaSeconds;
+	if (Memory->RemainingTime <= 0.f)
+	{
+		FinishLatentTask(OwnerComp, EBTNodeResult::Succeeded);
+		return;
+	}
+
+	const FVector ToTarget = (TargetActor->GetActorLocation() - OwningPawn->GetActorLocation()) * FVector(1.f, 1.f, 0.f);
+	const float Distance = ToTarget.Size();
+	if (Distance <= UE_KINDA_SMALL_NUMBER)
+	{
+		return;
+	}
+
+	const FVector ToTargetDirection = ToTarget / Distance;
+
+	// 切线方向绕圈，再按半径偏差向内（过远）或向外（过近）修正
+	const FVector TangentDirection = FVector::CrossProduct(FVector::UpVector, ToTargetDirection) * Memory->DirectionSign;
+	const float RadiusError = (Distance - Memory->DesiredRadius) / FMath::Max(Memory->DesiredRadius, 1.f);
+	const FVector CorrectionDirection = ToTargetDirection * FMath::Clamp(RadiusError * RadiusCorrectionStrength, -1.f, 1.f);
+
+	OwningPawn->AddMovementInput((TangentDirection + CorrectionDirection).GetSafeNormal());
+}
+
+void UBTTask_FightStrafeAroundTarget::OnTaskFinished(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory,
+	EBTNodeResult::Type TaskResult)
+{
+	FFightStrafeAroundTargetTaskMemory* Memory = CastInstanceNodeMemory<FFightStrafeAroundTargetTaskMemory>(NodeMemory);
+
+	if (APawn* OwningPawn = Memory->OwningPawn.Get())
+	{
+		if (const ACharacter* OwningCharacter = Cast<ACharacter>(OwningPawn))
+		{
+			UCharacterMovementComponent* MovementComponent = OwningCharacter->GetCharacterMovement();
+			MovementComponent->bOrientRotationToMovement = Memory->bSavedOrientRotationToMovement;
+			MovementComponent->bUseControllerDesiredRotation = Memory->bSavedUseControllerDesiredRotation;
+		}
+
+		UFightFunctionLibrary::RemoveGameplayTagFromActorIfFound(OwningPawn, FightGameplayTags::Enemy_Status_Strafing);
+	}
+
+	if (AAIController* AIController = OwnerComp.GetAIOwner())
+	{
+		AIController->ClearFocus(EAIFocusPriority::Gameplay);
+	}
+
+	Memory->OwningPawn.Reset();
+	Memory->TargetActor.Reset();
+
+	Super::OnTaskFinished(OwnerComp, NodeMemory, TaskResult);
+}
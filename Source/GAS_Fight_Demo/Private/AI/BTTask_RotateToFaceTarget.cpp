@@ -2,11 +2,15 @@
 
 
 #include "AI/BTTask_RotateToFaceTarget.h"
+#include "AI/FightOrientationSubsystem.h"
+#include "AI/FightBTStats.h"
 #include "AIController.h"
-#include "Kismet/KismetMathLibrary.h"
 #include"BehaviorTree/BlackboardComponent.h"
 
 
+DECLARE_CYCLE_STAT(TEXT("Task RotateToFaceTarget"), STAT_FightBT_TaskRotateToFaceTarget, STATGROUP_FightBT);
+
+
 bool FRotateToFaceTargetTaskMemory::IsValid() const
 {
 	return OwningPawn.IsValid() && TargetActor.IsValid();
@@ -23,6 +27,7 @@ UBTTask_RotateToFaceTarget::UBTTask_RotateToFaceTarget()
 	NodeName = TEXT("Native Rotate to Face Target Actor");
 	AnglePrecision = 10.0f;
 	RotationInterpSpeed = 5.0f;
+	AnglePrecisionCos = FMath::Cos(FMath::DegreesToRadians(AnglePrecision));
 
 	bNotifyTick = true;          // 需要每帧Tick更新
 	bNotifyTaskFinished = true;  // 任务完成时需要通知
@@ -45,6 +50,9 @@ void UBTTask_RotateToFaceTarget::InitializeFromAsset(UBehaviorTree& Asset)
 		// 解析选中的黑板键，建立与黑板数据的关联
 		InTargetToFaceKey.ResolveSelectedKey(*BBAsset);
 	}
+
+	// 每帧的精度判断直接与余弦值比较，省去反余弦
+	AnglePrecisionCos = FMath::Cos(FMath::DegreesToRadians(FMath::Clamp(AnglePrecision, 0.f, 180.f)));
 }
 
 uint16 UBTTask_RotateToFaceTarget::GetInstanceMemorySize() const
@@ -61,6 +69,8 @@ FString UBTTask_RotateToFaceTarget::GetStaticDescription() const
 
 EBTNodeResult::Type UBTTask_RotateToFaceTarget::ExecuteTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory)
 {
+	SCOPE_CYCLE_COUNTER(STAT_FightBT_TaskRotateToFaceTarget);
+
 	UObject* ActorObject = OwnerComp.GetBlackboardComponent()->GetValueAsObject(InTargetToFaceKey.SelectedKeyName);
 	AActor* TargetActor = Cast<AActor>(ActorObject);
 
@@ -86,12 +96,24 @@ EBTNodeResult::Type UBTTask_RotateToFaceTarget::ExecuteTask(UBehaviorTreeCompone
 		return EBTNodeResult::Succeeded;
 	}
 
+	// 旋转交给朝向子系统批量处理，任务在TickTask中只检查是否达到精度
+	UFightOrientationSubsystem* OrientationSubsystem = OwnerComp.GetWorld()->GetSubsystem<UFightOrientationSubsystem>();
+	if (!OrientationSubsystem)
+	{
+		Memory->Reset();
+		return EBTNodeResult::Failed;
+	}
+
+	OrientationSubsystem->RegisterOrientationRequest(OwningPawn, TargetActor, RotationInterpSpeed, this);
+
 	// 任务需要继续执行，返回进行中状态 --> 行为树系统随后会开始调用TickTask
 	return EBTNodeResult::InProgress;
 }
 
 void UBTTask_RotateToFaceTarget::TickTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, float DeltaSeconds)
 {
+	SCOPE_CYCLE_COUNTER(STAT_FightBT_TaskRotateToFaceTarget);
+
 	// 获取任务内存数据
 	FRotateToFaceTargetTaskMemory* Memory = CastInstanceNodeMemory<FRotateToFaceTargetTaskMemory>(NodeMemory);
 
@@ -103,41 +125,33 @@ void UBTTask_RotateToFaceTarget::TickTask(UBehaviorTreeComponent& OwnerComp, uin
 	}
 
 	// 检查是否已达到角度精度 --> 已达到精度要求，重置内存并结束任务（成功）
+	// 未达到时不做任何事，旋转由朝向子系统在本帧统一完成
 	if (HasReachedAnglePrecision(Memory->OwningPawn.Get(), Memory->TargetActor.Get()))
 	{
 		Memory->Reset();
 		FinishLatentTask(OwnerComp, EBTNodeResult::Succeeded);
 	}
-	// 还未达到精度，执行旋转逻辑
-	else
-	{
-		// 计算从AI位置看向目标位置所需的旋转
-		const FRotator LookAtRot = UKismetMathLibrary::FindLookAtRotation(
-			Memory->OwningPawn->GetActorLocation(), Memory->TargetActor->GetActorLocation());
-		// 使用插值计算平滑的旋转过渡
-		const FRotator TargetRot = FMath::RInterpTo(
-			Memory->OwningPawn->GetActorRotation(), LookAtRot, DeltaSeconds, RotationInterpSpeed);
+}
 
-		// 应用计算出的旋转到AI角色
-		Memory->OwningPawn->SetActorRotation(TargetRot);
+void UBTTask_RotateToFaceTarget::OnTaskFinished(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, EBTNodeResult::Type TaskResult)
+{
+	// 请求者匹配时才会移除 --> 未注册（执行时已面向目标）或已被其它请求者覆盖时不影响其它请求
+	const APawn* OwningPawn = OwnerComp.GetAIOwner() ? OwnerComp.GetAIOwner()->GetPawn() : nullptr;
+	UFightOrientationSubsystem* OrientationSubsystem = OwnerComp.GetWorld()->GetSubsystem<UFightOrientationSubsystem>();
 
-		// 注意：没有调用FinishLatentTask，任务继续执行（下一帧继续TickTask）
+	if (OwningPawn && OrientationSubsystem)
+	{
+		OrientationSubsystem->UnregisterOrientationRequest(OwningPawn, this);
 	}
+
+	CastInstanceNodeMemory<FRotateToFaceTargetTaskMemory>(NodeMemory)->Reset();
+
+	Super::OnTaskFinished(OwnerComp, NodeMemory, TaskResult);
 }
 
 bool UBTTask_RotateToFaceTarget::HasReachedAnglePrecision(APawn* QueryPawn, AActor* TargetActor) const
 {
-	// 获取AI角色的前向向量（当前朝向）
-	const FVector OwnerForward = QueryPawn->GetActorForwardVector();
-	// 计算从AI到目标的归一化方向向量 --> GetSafeNormal(): 获取单位向量（长度为1），自动处理零向量情况
-	const FVector OwnerToTargetNormalized = (TargetActor->GetActorLocation() - QueryPawn->GetActorLocation()).GetSafeNormal();
-
-	// 计算两个向量的点积 --> (A·B = |A||B|cosθ) --> 因为两个都是单位向量（长度为1），所以点积等于cosθ
-	const float DotResult = FVector::DotProduct(OwnerForward, OwnerToTargetNormalized);
-
-	// 通过反余弦函数计算角度（弧度转角度）--> (θ = arccos(A·B))
-	const float AngleDiff = UKismetMathLibrary::DegAcos(DotResult);
-
-	// 比较当前角度差与预设精度 --> 如果角度差小于等于精度要求，返回true（已足够面向目标）
-	return AngleDiff <= AnglePrecision;
+	// 只比较水平朝向，与朝向子系统只旋转Yaw保持一致 --> 预先计算的余弦阈值让判断只需要几次乘法
+	return UFightOrientationSubsystem::IsFacingWithinCosine(QueryPawn->GetActorForwardVector(),
+		TargetActor->GetActorLocation() - QueryPawn->GetActorLocation(), AnglePrecisionCos);
 }
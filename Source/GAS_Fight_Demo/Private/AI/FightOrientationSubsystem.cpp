@@ -0,0 +1,265 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "AI/FightOrientationSubsystem.h"
+#include "BehaviorTree/BlackboardComponent.h"
+#include "BehaviorTree/Blackboard/BlackboardKeyType_Object.h"
+#include "Components/SceneComponent.h"
+
+// Yaw变化小于该值（度）时不再提交旋转，避免无意义的变换更新
+static constexpr float FightOrientationYawTolerance = 0.01f;
+
+void UFightOrientationSubsystem::Deinitialize()
+{
+	RequestPawns.Empty();
+	RequestPawnKeys.Empty();
+	RequestTargetActors.Empty();
+	RequestBlackboards.Empty();
+	RequestTargetKeyIDs.Empty();
+	RequestInterpSpeeds.Empty();
+	RequestOwners.Empty();
+	RequestIndexByPawn.Empty();
+	SuspendedRequests.Empty();
+
+	Super::Deinitialize();
+}
+
+bool UFightOrientationSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId UFightOrientationSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UFightOrientationSubsystem, STATGROUP_Tickables);
+}
+
+void UFightOrientationSubsystem::RegisterOrientationRequest(APawn* InPawn, UBlackboardComponent* InBlackboard,
+	FBlackboard::FKey InTargetKeyID, float InInterpSpeed, const UObject* InRequester)
+{
+	if (!InPawn || !InBlackboard)
+	{
+		return;
+	}
+
+	const int32 Index = FindOrAddRequest(InPawn);
+	SuspendRequest(Index, InRequester);
+
+	RequestTargetActors[Index] = nullptr;
+	RequestBlackboards[Index] = InBlackboard;
+	RequestTargetKeyIDs[Index] = InTargetKeyID;
+	RequestInterpSpeeds[Index] = InInterpSpeed;
+	RequestOwners[Index] = InRequester;
+}
+
+void UFightOrientationSubsystem::RegisterOrientationRequest(APawn* InPawn, AActor* InTargetActor,
+	float InInterpSpeed, const UObject* InRequester)
+{
+	if (!InPawn || !InTargetActor)
+	{
+		return;
+	}
+
+	const int32 Index = FindOrAddRequest(InPawn);
+	SuspendRequest(Index, InRequester);
+
+	RequestTargetActors[Index] = InTargetActor;
+	RequestBlackboards[Index] = nullptr;
+	RequestTargetKeyIDs[Index] = FBlackboard::InvalidKey;
+	RequestInterpSpeeds[Index] = InInterpSpeed;
+	RequestOwners[Index] = InRequester;
+}
+
+void UFightOrientationSubsystem::UnregisterOrientationRequest(const APawn* InPawn, const UObject* InRequester)
+{
+	const int32 Index = FindRequestIndex(InPawn);
+	if (Index != INDEX_NONE && RequestOwners[Index] == InRequester)
+	{
+		RemoveRequestAtSwap(Index);
+		ResumeSuspendedRequest(InPawn);
+		return;
+	}
+
+	SuspendedRequests.RemoveAllSwap([InPawn, InRequester](const FFightSuspendedOrientationRequest& Suspended)
+	{
+		return Suspended.Pawn.Get() == InPawn && Suspended.Requester == InRequester;
+	}, EAllowShrinking::No);
+}
+
+int32 UFightOrientationSubsystem::FindRequestIndex(const APawn* InPawn) const
+{
+	const int32* FoundIndex = RequestIndexByPawn.Find(TObjectKey<APawn>(InPawn));
+	return FoundIndex ? *FoundIndex : INDEX_NONE;
+}
+
+int32 UFightOrientationSubsystem::FindOrAddRequest(APawn* InPawn)
+{
+	const int32 ExistingIndex = FindRequestIndex(InPawn);
+	if (ExistingIndex != INDEX_NONE)
+	{
+		return ExistingIndex;
+	}
+
+	RequestTargetActors.AddDefaulted();
+	RequestBlackboards.AddDefaulted();
+	RequestTargetKeyIDs.Add(FBlackboard::InvalidKey);
+	RequestInterpSpeeds.Add(0.f);
+	RequestOwners.Add(nullptr);
+	RequestPawnKeys.Add(TObjectKey<APawn>(InPawn));
+
+	const int32 NewIndex = RequestPawns.Add(InPawn);
+	RequestIndexByPawn.Add(TObjectKey<APawn>(InPawn), NewIndex);
+	return NewIndex;
+}
+
+void UFightOrientationSubsystem::RemoveRequestAtSwap(int32 InIndex)
+{
+	// 末尾的请求会被交换到InIndex，同步更新它的下标
+	const int32 LastIndex = RequestPawns.Num() - 1;
+	RequestIndexByPawn.Remove(RequestPawnKeys[InIndex]);
+	if (InIndex != LastIndex)
+	{
+		RequestIndexByPawn.Add(RequestPawnKeys[LastIndex], InIndex);
+	}
+
+	RequestPawns.RemoveAtSwap(InIndex, 1, EAllowShrinking::No);
+	RequestPawnKeys.RemoveAtSwap(InIndex, 1, EAllowShrinking::No);
+	RequestTargetActors.RemoveAtSwap(InIndex, 1, EAllowShrinking::No);
+	RequestBlackboards.RemoveAtSwap(InIndex, 1, EAllowShrinking::No);
+	RequestTargetKeyIDs.RemoveAtSwap(InIndex, 1, EAllowShrinking::No);
+	RequestInterpSpeeds.RemoveAtSwap(InIndex, 1, EAllowShrinking::No);
+	RequestOwners.RemoveAtSwap(InIndex, 1, EAllowShrinking::No);
+}
+
+void UFightOrientationSubsystem::SuspendRequest(int32 InIndex, const UObject* InNewRequester)
+{
+	// 新请求的请求者为空；同一请求者重复注册只是更新参数
+	const UObject* ExistingRequester = RequestOwners[InIndex];
+	if (!ExistingRequester || ExistingRequester == InNewRequester)
+	{
+		return;
+	}
+
+	FFightSuspendedOrientationRequest& Suspended = SuspendedRequests.AddDefaulted_GetRef();
+	Suspended.Pawn = RequestPawns[InIndex];
+	Suspended.TargetActor = RequestTargetActors[InIndex];
+	Suspended.Blackboard = RequestBlackboards[InIndex];
+	Suspended.TargetKeyID = RequestTargetKeyIDs[InIndex];
+	Suspended.InterpSpeed = RequestInterpSpeeds[InIndex];
+	Suspended.Requester = ExistingRequester;
+}
+
+void UFightOrientationSubsystem::ResumeSuspendedRequest(const APawn* InPawn)
+{
+	for (int32 SuspendedIndex = SuspendedRequests.Num() - 1; SuspendedIndex >= 0; --SuspendedIndex)
+	{
+		if (SuspendedRequests[SuspendedIndex].Pawn.Get() != InPawn)
+		{
+			continue;
+		}
+
+		const FFightSuspendedOrientationRequest Suspended = SuspendedRequests[SuspendedIndex];
+		SuspendedRequests.RemoveAt(SuspendedIndex, 1, EAllowShrinking::No);
+
+		// 恢复的请求是新增的一条，请求者为空，不会再次挂起其它请求
+		const int32 Index = FindOrAddRequest(Suspended.Pawn.Get());
+		RequestTargetActors[Index] = Suspended.TargetActor;
+		RequestBlackboards[Index] = Suspended.Blackboard;
+		RequestTargetKeyIDs[Index] = Suspended.TargetKeyID;
+		RequestInterpSpeeds[Index] = Suspended.InterpSpeed;
+		RequestOwners[Index] = Suspended.Requester;
+		return;
+	}
+}
+
+void UFightOrientationSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	// 与RInterpTo保持一致：DeltaTime为0时不做任何旋转
+	if (RequestPawns.IsEmpty() || DeltaTime <= 0.f)
+	{
+		return;
+	}
+
+	FramePawns.Reset();
+	FrameDeltaX.Reset();
+	FrameDeltaY.Reset();
+	FrameInterpSpeeds.Reset();
+	FrameCurrentYaws.Reset();
+
+	// 1. 收集阶段：清理失效请求，把本帧有效的请求写入连续数组
+	for (int32 Index = RequestPawns.Num() - 1; Index >= 0; --Index)
+	{
+		APawn* OwningPawn = RequestPawns[Index].Get();
+		if (!OwningPawn)
+		{
+			RemoveRequestAtSwap(Index);
+			SuspendedRequests.RemoveAllSwap([](const FFightSuspendedOrientationRequest& Suspended)
+			{
+				return !Suspended.Pawn.IsValid();
+			}, EAllowShrinking::No);
+			continue;
+		}
+
+		const AActor* TargetActor = RequestTargetActors[Index].Get();
+		if (const UBlackboardComponent* BlackboardComp = RequestBlackboards[Index].Get())
+		{
+			TargetActor = Cast<AActor>(
+				BlackboardComp->GetValue<UBlackboardKeyType_Object>(RequestTargetKeyIDs[Index]));
+		}
+
+		if (!TargetActor)
+		{
+			continue;
+		}
+
+		const FVector OwnerLocation = OwningPawn->GetActorLocation();
+		const FVector TargetLocation = TargetActor->GetActorLocation();
+
+		FramePawns.Add(OwningPawn);
+		FrameDeltaX.Add(static_cast<float>(TargetLocation.X - OwnerLocation.X));
+		FrameDeltaY.Add(static_cast<float>(TargetLocation.Y - OwnerLocation.Y));
+		FrameInterpSpeeds.Add(RequestInterpSpeeds[Index]);
+		FrameCurrentYaws.Add(static_cast<float>(OwningPawn->GetActorRotation().Yaw));
+	}
+
+	const int32 FrameCount = FramePawns.Num();
+	FrameNewYaws.SetNumUninitialized(FrameCount, EAllowShrinking::No);
+
+	// 2. 计算阶段：只处理Yaw，逐元素独立计算，无分支依赖
+	const float* DeltaX = FrameDeltaX.GetData();
+	const float* DeltaY = FrameDeltaY.GetData();
+	const float* InterpSpeeds = FrameInterpSpeeds.GetData();
+	const float* CurrentYaws = FrameCurrentYaws.GetData();
+	float* NewYaws = FrameNewYaws.GetData();
+	for (int32 Index = 0; Index < FrameCount; ++Index)
+	{
+		const float DesiredYaw = FMath::RadiansToDegrees(FMath::Atan2(DeltaY[Index], DeltaX[Index]));
+		const float DeltaYaw = FMath::FindDeltaAngleDegrees(CurrentYaws[Index], DesiredYaw);
+
+		// 插值速度<=0时直接到达目标，与RInterpTo行为一致
+		const float Alpha = InterpSpeeds[Index] > 0.f ? FMath::Min(DeltaTime * InterpSpeeds[Index], 1.f) : 1.f;
+		NewYaws[Index] = CurrentYaws[Index] + DeltaYaw * Alpha;
+	}
+
+	// 3. 应用阶段：跳过基本没变化的Pawn，只对其余Pawn提交旋转
+	// 不使用FScopedMovementUpdate --> 它只作用于单个组件，在逐Pawn的循环中每次都会立即提交，并不能合并多个Pawn的更新
+	for (int32 Index = 0; Index < FrameCount; ++Index)
+	{
+		if (FMath::Abs(NewYaws[Index] - CurrentYaws[Index]) <= FightOrientationYawTolerance)
+		{
+			continue;
+		}
+
+		USceneComponent* RootComp = FramePawns[Index]->GetRootComponent();
+		if (!RootComp)
+		{
+			continue;
+		}
+
+		FRotator NewRotation = RootComp->GetComponentRotation();
+		NewRotation.Yaw = NewYaws[Index];
+		RootComp->SetWorldRotation(NewRotation, false, nullptr, ETeleportType::None);
+	}
+}
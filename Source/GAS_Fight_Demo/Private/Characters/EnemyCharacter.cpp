@@ -6,12 +6,15 @@
 #include "DataAsset/StartUpData/DataAsset_EnemyStartUpData.h"
 #include "Engine/AssetManager.h"
 #include "Components/UI/EnemyUIComponent.h"
+#include "Components/UI/EnemyHealthBarOverlayComponent.h"
 #include "Components/Combat/EnemyCombatComponent.h"
 #include "Components/WidgetComponent.h"
 #include "Widgets/FightWidgetBase.h"
 #include "Components/BoxComponent.h"
 #include "FightFunctionLibrary.h"
 #include "Game/FightBaseGameMode.h"
+#include "GAS/FightAbilitySystemComponent.h"
+#include "Game/FightHitValidationSubsystem.h"
 
 #include "GASDebugHelper.h"
 
@@ -37,6 +40,12 @@ AEnemyCharacter::AEnemyCharacter()
 	// 设置制动减速度
 	GetCharacterMovement()->BrakingDecelerationWalking = 1000.0f;
 
+	// 远离所有玩家的敌人不复制给该连接 --> 服务器每个连接的开销随附近敌人数量而非敌人总数增长
+	SetNetCullDistanceSquared(FMath::Square(8000.f));
+
+	// 敌人没有拥有者客户端，只需要复制标签与提示 --> 效果不逐个复制，大幅降低每个敌人的带宽
+	GetFightAbilitySystemComponent()->SetReplicationMode(EGameplayEffectReplicationMode::Minimal);
+
 	// 创建默认子对象：敌人战斗组件
 	EnemyCombatComponent = CreateDefaultSubobject<UEnemyCombatComponent>("EnemyCombatComponent");
 
@@ -73,13 +82,55 @@ UEnemyUIComponent* AEnemyCharacter::GetEnemyUIComponent() const
 
 void AEnemyCharacter::BeginPlay()
 {
+	// 使用共享覆盖层时，在组件BeginPlay创建控件之前停用血条组件 --> 敌人数量再多，血条控件数量也保持不变
+	// 只清空控件类并隐藏、停止Tick，组件本身保留，蓝图中对它的引用仍然有效
+	UEnemyHealthBarOverlayComponent* HealthBarOverlay = bUseSharedHealthBarOverlay ?
+		UEnemyHealthBarOverlayComponent::FindLocalOverlay(this) : nullptr;
+
+	if (HealthBarOverlay && HealthBarOverlay->IsOverlayEnabled())
+	{
+		EnemyHealthWidgetComponent->SetWidgetClass(nullptr);
+		EnemyHealthWidgetComponent->SetTickMode(ETickMode::Disabled);
+		EnemyHealthWidgetComponent->SetHiddenInGame(true);
+		EnemyHealthWidgetComponent->Deactivate();
+
+		HealthBarOverlay->RegisterEnemy(this);
+	}
+
 	Super::BeginPlay();
 
-	// 手动调用函数, 初始化敌人血量UI小部件
-	if (UFightWidgetBase* HealthWidget = Cast<UFightWidgetBase>(EnemyHealthWidgetComponent->GetUserWidgetObject()))
+	// 服务器记录位置历史，用于回溯校验客户端上报的近战命中
+	if (HasAuthority())
+	{
+		if (UFightHitValidationSubsystem* HitValidationSubsystem = GetWorld()->GetSubsystem<UFightHitValidationSubsystem>())
+		{
+			HitValidationSubsystem->RegisterHitTarget(this);
+		}
+	}
+
+	// 手动调用函数, 初始化敌人血量UI小部件 --> 由覆盖层绘制时组件没有控件，这里自然跳过
+	if (EnemyHealthWidgetComponent)
+	{
+		if (UFightWidgetBase* HealthWidget = Cast<UFightWidgetBase>(EnemyHealthWidgetComponent->GetUserWidgetObject()))
+		{
+			HealthWidget->InitEnemyCreatedWidget(this);
+		}
+	}
+}
+
+void AEnemyCharacter::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UEnemyHealthBarOverlayComponent* HealthBarOverlay = UEnemyHealthBarOverlayComponent::FindLocalOverlay(this))
 	{
-		HealthWidget->InitEnemyCreatedWidget(this);
+		HealthBarOverlay->UnregisterEnemy(this);
 	}
+
+	if (UFightHitValidationSubsystem* HitValidationSubsystem = GetWorld()->GetSubsystem<UFightHitValidationSubsystem>())
+	{
+		HitValidationSubsystem->UnregisterHitTarget(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
 }
 
 void AEnemyCharacter::PossessedBy(AController* NewController)
@@ -128,27 +179,15 @@ void AEnemyCharacter::InitEnemyStartUpData()
 		return;
 	}
 
-	int32 AbilityApplyLevel = 1;
+	// 等级由游戏模式初始化时解析并缓存的难度配置给出
+	const AFightBaseGameMode* BaseGameMode = GetWorld()->GetAuthGameMode<AFightBaseGameMode>();
+	const int32 AbilityApplyLevel = BaseGameMode ? BaseGameMode->GetEnemyAbilityApplyLevel() : 1;
 
-	if (AFightBaseGameMode* BaseGameMode = GetWorld()->GetAuthGameMode<AFightBaseGameMode>())
+	// 同类敌人的数据资产在第一个实例加载后就已常驻内存，直接授予，不再经过流式管理器
+	if (UDataAsset_StartUpDataBase* ResidentData = CharacterStartUpData.Get())
 	{
-		switch (BaseGameMode->GetCurrentGameDifficulty())
-		{
-		case EFightGameDifficulty::Easy:
-			AbilityApplyLevel = 1;
-			break;
-		case EFightGameDifficulty::Normal:
-			AbilityApplyLevel = 2;
-			break;
-		case EFightGameDifficulty::Hard:
-			AbilityApplyLevel = 3;
-			break;
-		case EFightGameDifficulty::Hell:
-			AbilityApplyLevel = 4;
-			break;
-		default:
-			break;
-		}
+		ResidentData->GiveToAbilitySystemComponent(FightAbilitySystemComponent, AbilityApplyLevel);
+		return;
 	}
 
 	// 使用Unreal的资源管理器异步加载 CharacterStartUpData 指定的资源（通常是 DataAsset）--> 异步加载避免阻塞游戏主线程，提高性能
@@ -4,6 +4,7 @@
 #include "Characters/GASBasicCharacter.h"
 #include "GAS/FightAbilitySystemComponent.h"
 #include "MotionWarpingComponent.h"
+#include "Game/FightBaseGameMode.h"
 
 
 /**
@@ -31,6 +32,10 @@ AGASBasicCharacter::AGASBasicCharacter()
 	// CreateDefaultSubobject用于在构造函数中创建组件，确保组件在编辑器和运行时都正确初始化
 	FightAbilitySystemComponent = CreateDefaultSubobject<UFightAbilitySystemComponent>(TEXT("FightAbilitySystemComponent"));
 
+	// 合作模式下能力系统需要复制 --> Mixed：效果只复制给拥有者，其余客户端只收到标签与提示；敌人在子类中改为Minimal
+	FightAbilitySystemComponent->SetIsReplicated(true);
+	FightAbilitySystemComponent->SetReplicationMode(EGameplayEffectReplicationMode::Mixed);
+
 	// 创建默认子对象：属性集组件
 	// 属性集组件包含角色的所有属性，如生命值、怒气值等
 	BasicAttributeSet = CreateDefaultSubobject<UBasicAttributeSet>(TEXT("BasicAttributeSet"));
@@ -55,14 +60,36 @@ UPawnUIComponent* AGASBasicCharacter::GetPawnUIComponent() const
 	return nullptr;
 }
 
-void AGASBasicCharacter::PossessedBy(AController* NewController)
+void AGASBasicCharacter::PostInitializeComponents()
 {
-	Super::PossessedBy(NewController);
+	Super::PostInitializeComponents();
 
 	if (FightAbilitySystemComponent)
 	{
 		// 初始化能力Actor信息 --> 第一个参数是拥有能力的Actor，第二个参数是AvatarActor（通常为角色本身）
+		// 拥有者与化身都是角色自身，所有网络模式下都在这里初始化 --> AI控制器与其他玩家的控制器不会复制到客户端，
+		// 依赖控制器复制时，这些角色的ASC在客户端上永远没有Actor信息
 		FightAbilitySystemComponent->InitAbilityActorInfo(this, this);
+	}
+}
+
+void AGASBasicCharacter::PossessedBy(AController* NewController)
+{
+	Super::PossessedBy(NewController);
+
+	if (FightAbilitySystemComponent)
+	{
+		// Actor信息中缓存的玩家控制器随占有刷新
+		FightAbilitySystemComponent->RefreshAbilityActorInfo();
+
+		// 确定性模式下能力选择的随机流也由游戏模式派生种子
+		if (AFightBaseGameMode* BaseGameMode = GetWorld()->GetAuthGameMode<AFightBaseGameMode>())
+		{
+			if (BaseGameMode->IsDeterministicMode())
+			{
+				FightAbilitySystemComponent->SetAbilitySelectionSeed(BaseGameMode->GenerateGameplaySeed());
+			}
+		}
 
 		// 确保AttributeSet已正确注册到AbilitySystemComponent
 		// 这是解决Attribute.Get()断言失败的关键步骤
@@ -78,4 +105,15 @@ void AGASBasicCharacter::PossessedBy(AController* NewController)
 	}
 }
 
+void AGASBasicCharacter::OnRep_Controller()
+{
+	Super::OnRep_Controller();
+
+	// 只有本地玩家会收到自己的控制器，刷新后Actor信息才能识别本地控制，能力预测依赖于此
+	if (FightAbilitySystemComponent)
+	{
+		FightAbilitySystemComponent->RefreshAbilityActorInfo();
+	}
+}
+
 
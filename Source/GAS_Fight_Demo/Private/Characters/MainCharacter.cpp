@@ -21,8 +21,11 @@
 #include "GAS/FightAbilitySystemComponent.h"
 #include "DataAsset/StartUpData/DataAsset_StartUpDataBase.h"
 #include "Components/Combat/PlayerCombatComponent.h"
+#include "Components/Combat/FightHitStopComponent.h"
+#include "Items/PickUps/FightStoneBase.h"
 #include "Components/UI/PlayerUIComponent.h"
-#include "AbilitySystemBlueprintLibrary.h"
+#include "Game/FightEventBusSubsystem.h"
+#include "Game/FightHitValidationSubsystem.h"
 
 
 AMainCharacter::AMainCharacter()
@@ -70,6 +73,9 @@ AMainCharacter::AMainCharacter()
 	// 创建英雄战斗组件 --> 用于处理英雄特有的战斗逻辑
 	PlayerCombatComponent = CreateDefaultSubobject<UPlayerCombatComponent>(TEXT("PlayerCombatComponent"));
 
+	// 创建顿帧调度组件 --> 多次命中合并为一个时间膨胀窗口，不再每次命中激活顿帧能力
+	FightHitStopComponent = CreateDefaultSubobject<UFightHitStopComponent>(TEXT("FightHitStopComponent"));
+
 	// 创建玩家UI组件
 	PlayerUIComponent = CreateDefaultSubobject<UPlayerUIComponent>(TEXT("PlayerUIComponent"));
 }
@@ -92,6 +98,80 @@ UPlayerUIComponent* AMainCharacter::GetPlayerUIComponent() const
 void AMainCharacter::BeginPlay()
 {
 	Super::BeginPlay();
+
+	// 服务器同样记录玩家的位置历史 --> 校验命中时攻击者也回溯到上报时刻
+	if (HasAuthority())
+	{
+		if (UFightHitValidationSubsystem* HitValidationSubsystem = GetWorld()->GetSubsystem<UFightHitValidationSubsystem>())
+		{
+			HitValidationSubsystem->RegisterHitTarget(this);
+		}
+	}
+}
+
+void AMainCharacter::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	if (CachedFightInputComponent && CachedFightInputComponent->IsReplayingInput() && !CachedFightInputComponent->TickInputReplay())
+	{
+		CachedFightInputComponent->StopInputReplay();
+
+		if (AFightBaseGameMode* BaseGameMode = GetWorld()->GetAuthGameMode<AFightBaseGameMode>())
+		{
+			BaseGameMode->NotifyInputReplayFinished();
+		}
+	}
+}
+
+void AMainCharacter::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (CachedFightInputComponent && CachedFightInputComponent->IsRecordingInput())
+	{
+		if (const AFightBaseGameMode* BaseGameMode = GetWorld()->GetAuthGameMode<AFightBaseGameMode>())
+		{
+			CachedFightInputComponent->StopInputRecording(BaseGameMode->GetInputRecordFilePath());
+		}
+	}
+
+	if (UFightHitValidationSubsystem* HitValidationSubsystem = GetWorld()->GetSubsystem<UFightHitValidationSubsystem>())
+	{
+		HitValidationSubsystem->UnregisterHitTarget(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void AMainCharacter::RegisterOverlappingStone(AFightStoneBase* InStone)
+{
+	OverlappingStones.AddUnique(InStone);
+
+	// 能力在激活时读取整个重叠集合，同一帧内多块石头只需尝试激活一次
+	if (LastPickUpStonesActivationFrame != GFrameCounter)
+	{
+		LastPickUpStonesActivationFrame = GFrameCounter;
+		GetFightAbilitySystemComponent()->TryActivateAbilityByTag(FightGameplayTags::Player_Ability_PickUp_Stones);
+	}
+}
+
+void AMainCharacter::UnregisterOverlappingStone(AFightStoneBase* InStone)
+{
+	OverlappingStones.RemoveSwap(InStone, EAllowShrinking::No);
+}
+
+void AMainCharacter::GetOverlappingStones(TArray<AFightStoneBase*>& OutStones)
+{
+	// 已被销毁或回收到对象池中的石头不再算作重叠
+	OverlappingStones.RemoveAllSwap([](const TWeakObjectPtr<AFightStoneBase>& Stone)
+		{
+			return !Stone.IsValid() || !Stone->IsPickUpActive();
+		}, EAllowShrinking::No);
+
+	OutStones.Reset(OverlappingStones.Num());
+	for (const TWeakObjectPtr<AFightStoneBase>& Stone : OverlappingStones)
+	{
+		OutStones.Add(Stone.Get());
+	}
 }
 
 void AMainCharacter::SetupPlayerInputComponent(UInputComponent* PlayerInputComponent)
@@ -131,6 +211,65 @@ void AMainCharacter::SetupPlayerInputComponent(UInputComponent* PlayerInputCompo
 	// 这允许处理复杂的输入事件，如技能释放
 	FightInputComponent->BindAbilityInputAction(InputConfigDataAsset, this,
 		&ThisClass::Input_AbilityInputPressed, &ThisClass::Input_AbilityInputReleased);
+
+	InitInputRecordingAndReplay(FightInputComponent);
+}
+
+void AMainCharacter::InitInputRecordingAndReplay(UPlayerInputComponent* InFightInputComponent)
+{
+	CachedFightInputComponent = InFightInputComponent;
+
+	// 录制与回放只在单机确定性运行中使用，客户端拿不到游戏模式
+	const AFightBaseGameMode* BaseGameMode = GetWorld()->GetAuthGameMode<AFightBaseGameMode>();
+	if (!BaseGameMode || !BaseGameMode->IsDeterministicMode())
+	{
+		return;
+	}
+
+	if (TSharedPtr<const FFightInputLog> ReplayInputLog = BaseGameMode->GetReplayInputLog())
+	{
+		InFightInputComponent->OnReplayInputEvent.BindUObject(this, &ThisClass::HandleReplayInputEvent);
+		InFightInputComponent->StartInputReplay(ReplayInputLog.ToSharedRef());
+
+		// 基类默认不开启Tick，回放事件由Tick逐帧派发
+		SetActorTickEnabled(true);
+	}
+	else if (!BaseGameMode->GetInputRecordFilePath().IsEmpty())
+	{
+		InFightInputComponent->StartInputRecording(BaseGameMode->GetDeterministicSeed(), BaseGameMode->GetFixedSimulationDeltaTime());
+	}
+}
+
+void AMainCharacter::HandleReplayInputEvent(const FFightInputLogEvent& InEvent, const FGameplayTag& InInputTag)
+{
+	const FInputActionValue ReplayValue(FVector2D(InEvent.Value));
+
+	switch (InEvent.Type)
+	{
+	case EFightInputLogEventType::Move:
+		Input_Move(ReplayValue);
+		break;
+	case EFightInputLogEventType::Look:
+		Input_Look(ReplayValue);
+		break;
+	case EFightInputLogEventType::SwitchTargetTriggered:
+		Input_SwitchTargetTriggered(ReplayValue);
+		break;
+	case EFightInputLogEventType::SwitchTargetCompleted:
+		Input_SwitchTargetCompleted(ReplayValue);
+		break;
+	case EFightInputLogEventType::PickUpStones:
+		Input_PickUpStonesStarted(ReplayValue);
+		break;
+	case EFightInputLogEventType::AbilityPressed:
+		Input_AbilityInputPressed(InInputTag);
+		break;
+	case EFightInputLogEventType::AbilityReleased:
+		Input_AbilityInputReleased(InInputTag);
+		break;
+	default:
+		break;
+	}
 }
 
 void AMainCharacter::PossessedBy(AController* NewController)
@@ -144,28 +283,9 @@ void AMainCharacter::PossessedBy(AController* NewController)
 			// 同步加载启动数据资产 --> LoadSynchronous会阻塞直到资源加载完成，适用于初始化阶段
 			if (UDataAsset_StartUpDataBase* LoadedData = CharacterStartUpData.LoadSynchronous())
 			{
-				int32 AbilityApplyLevel = 1;
-
-				if (AFightBaseGameMode* BaseGameMode = GetWorld()->GetAuthGameMode<AFightBaseGameMode>())
-				{
-					switch (BaseGameMode->GetCurrentGameDifficulty())
-					{
-					case EFightGameDifficulty::Easy:
-						AbilityApplyLevel = 4;
-						break;
-					case EFightGameDifficulty::Normal:
-						AbilityApplyLevel = 3;
-						break;
-					case EFightGameDifficulty::Hard:
-						AbilityApplyLevel = 2;
-						break;
-					case EFightGameDifficulty::Hell:
-						AbilityApplyLevel = 1;
-						break;
-					default:
-						break;
-					}
-				}
+				// 等级由游戏模式初始化时解析并缓存的难度配置给出
+				const AFightBaseGameMode* BaseGameMode = GetWorld()->GetAuthGameMode<AFightBaseGameMode>();
+				const int32 AbilityApplyLevel = BaseGameMode ? BaseGameMode->GetPlayerAbilityApplyLevel() : 1;
 
 				// 将加载的数据应用到能力系统组件
 				LoadedData->GiveToAbilitySystemComponent(FightAbilitySystemComponent, AbilityApplyLevel);
@@ -179,6 +299,11 @@ void AMainCharacter::Input_Move(const FInputActionValue& InputActionValue)
 	// 获取二维移动向量(X轴和Y轴) --> FVector2D的X分量表示左右移动，Y分量表示前后移动
 	const FVector2D MovementVector = InputActionValue.Get<FVector2D>();
 
+	if (!CachedFightInputComponent->PreprocessInputEvent(EFightInputLogEventType::Move, FVector2f(MovementVector)))
+	{
+		return;
+	}
+
 	// 获取控制器的Yaw旋转(水平旋转)，用于确定移动方向 --> 仅使用偏航旋转，忽略俯仰和翻滚
 	const FRotator MovementRotation(0.f, Controller->GetControlRotation().Yaw, 0.f);
 
@@ -202,6 +327,11 @@ void AMainCharacter::Input_Look(const FInputActionValue& InputActionValue)
 	// FVector2D的X分量表示水平旋转，Y分量表示垂直旋转
 	const FVector2D LookAxisVector = InputActionValue.Get<FVector2D>();
 
+	if (!CachedFightInputComponent->PreprocessInputEvent(EFightInputLogEventType::Look, FVector2f(LookAxisVector)))
+	{
+		return;
+	}
+
 	if (LookAxisVector.X != 0.f)
 	{
 		AddControllerYawInput(LookAxisVector.X);
@@ -214,36 +344,57 @@ void AMainCharacter::Input_Look(const FInputActionValue& InputActionValue)
 
 void AMainCharacter::Input_SwitchTargetTriggered(const FInputActionValue& InputActionValue)
 {
+	if (!CachedFightInputComponent->PreprocessInputEvent(EFightInputLogEventType::SwitchTargetTriggered,
+		FVector2f(InputActionValue.Get<FVector2D>())))
+	{
+		return;
+	}
+
 	SwitchDirection = InputActionValue.Get<FVector2D>();
 }
 
 void AMainCharacter::Input_SwitchTargetCompleted(const FInputActionValue& InputActionValue)
 {
-	FGameplayEventData Data;
+	if (!CachedFightInputComponent->PreprocessInputEvent(EFightInputLogEventType::SwitchTargetCompleted))
+	{
+		return;
+	}
 
-	UAbilitySystemBlueprintLibrary::SendGameplayEventToActor(
+	// 玩家输入影响玩法，立即派发 --> 延迟派发会多一帧输入延迟，连续按键还可能被合并
+	UFightEventBusSubsystem::SendFightEvent(
 		this,
-		SwitchDirection.X > 0.f ? FightGameplayTags::Player_Event_SwitchTarget_Right : FightGameplayTags::Player_Event_SwitchTarget_Left,
-		Data
+		SwitchDirection.X > 0.f ? FightGameplayTags::Player_Event_SwitchTarget_Right : FightGameplayTags::Player_Event_SwitchTarget_Left
 	);
 }
 
 void AMainCharacter::Input_PickUpStonesStarted(const FInputActionValue& InputActionValue)
 {
-	FGameplayEventData Data;
+	if (!CachedFightInputComponent->PreprocessInputEvent(EFightInputLogEventType::PickUpStones))
+	{
+		return;
+	}
 
-	UAbilitySystemBlueprintLibrary::SendGameplayEventToActor(
-		this, FightGameplayTags::Player_Event_ConsumeStones, Data);
+	UFightEventBusSubsystem::SendFightEvent(this, FightGameplayTags::Player_Event_ConsumeStones);
 }
 
 void AMainCharacter::Input_AbilityInputPressed(FGameplayTag InInputTag)
 {
+	if (!CachedFightInputComponent->PreprocessInputEvent(EFightInputLogEventType::AbilityPressed, FVector2f::ZeroVector, InInputTag))
+	{
+		return;
+	}
+
 	// 通知能力系统组件输入被按下 --> OnAbilityInputPressed会查找与输入标签匹配的能力并尝试激活
 	FightAbilitySystemComponent->OnAbilityInputPressed(InInputTag);
 }
 
 void AMainCharacter::Input_AbilityInputReleased(FGameplayTag InInputTag)
 {
+	if (!CachedFightInputComponent->PreprocessInputEvent(EFightInputLogEventType::AbilityReleased, FVector2f::ZeroVector, InInputTag))
+	{
+		return;
+	}
+
 	// 通知能力系统组件输入被释放 --> OnAbilityInputReleased会处理能力的释放逻辑
 	FightAbilitySystemComponent->OnAbilityInputReleased(InInputTag);
 }
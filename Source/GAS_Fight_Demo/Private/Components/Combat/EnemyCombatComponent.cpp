@@ -2,11 +2,11 @@
 
 
 #include "Components/Combat/EnemyCombatComponent.h"
-#include "AbilitySystemBlueprintLibrary.h"
 #include "FightFunctionLibrary.h"
 #include "GAS/FightGameplayTags.h"
 #include "Characters/EnemyCharacter.h"
 #include "Components/BoxComponent.h"
+#include "Game/FightEventBusSubsystem.h"
 
 #include "GASDebugHelper.h"
 
@@ -32,19 +32,15 @@ void UEnemyCombatComponent::OnHitTargetActor(AActor* HitActor)
 		bIsValidBlock = UFightFunctionLibrary::IsValidBlock(GetOwningPawn(), HitActor);
 	}
 
-	FGameplayEventData EventData;
-	EventData.Instigator = GetOwningPawn();
-	EventData.Target = HitActor;
-
 	if (bIsValidBlock)
 	{
-		UAbilitySystemBlueprintLibrary::SendGameplayEventToActor(HitActor,
-			FightGameplayTags::Player_Event_SuccessfulBlock, EventData);
+		UFightEventBusSubsystem::SendFightEvent(HitActor,
+			FightGameplayTags::Player_Event_SuccessfulBlock, GetOwningPawn(), HitActor);
 	}
 	else
 	{
-		UAbilitySystemBlueprintLibrary::SendGameplayEventToActor(GetOwningPawn(),
-			FightGameplayTags::Shared_Event_MeleeHit, EventData);
+		UFightEventBusSubsystem::SendFightEvent(GetOwningPawn(),
+			FightGameplayTags::Shared_Event_MeleeHit, GetOwningPawn(), HitActor);
 	}
 }
 
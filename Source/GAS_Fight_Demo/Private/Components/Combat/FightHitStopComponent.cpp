@@ -0,0 +1,153 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Components/Combat/FightHitStopComponent.h"
+#include "Game/FightTimerSubsystem.h"
+#include "Components/SkeletalMeshComponent.h"
+
+
+UFightHitStopComponent::UFightHitStopComponent()
+{
+	PrimaryComponentTick.bCanEverTick = false;
+}
+
+void UFightHitStopComponent::RequestHitStop(AActor* InHitActor)
+{
+	if (!GetOwningPawn()->IsLocallyControlled())
+	{
+		return;
+	}
+
+	UFightTimerSubsystem* TimerSubsystem = GetWorld()->GetSubsystem<UFightTimerSubsystem>();
+	if (!TimerSubsystem)
+	{
+		return;
+	}
+
+	const double CurrentTime = GetWorld()->GetTimeSeconds();
+
+	if (!IsHitStopActive())
+	{
+		WindowStartTime = CurrentTime;
+		WindowEndTime = CurrentTime;
+
+		AddDilatedActor(GetOwner());
+	}
+
+	if (bDilateHitTargets && InHitActor)
+	{
+		AddDilatedActor(InHitActor);
+	}
+
+	// 新请求只能把窗口延长到上限为止，已覆盖的请求直接并入当前窗口
+	const double NewWindowEndTime = FMath::Min(CurrentTime + HitStopDuration, WindowStartTime + MaxHitStopDuration);
+	if (NewWindowEndTime <= WindowEndTime)
+	{
+		return;
+	}
+
+	WindowEndTime = NewWindowEndTime;
+
+	TimerSubsystem->ClearTimer(EndHitStopTimerHandle);
+	EndHitStopTimerHandle = TimerSubsystem->SetTimer(
+		FFightTimerDelegate::CreateUObject(this, &ThisClass::EndHitStop), WindowEndTime - CurrentTime);
+}
+
+void UFightHitStopComponent::EndHitStop()
+{
+	if (UFightTimerSubsystem* TimerSubsystem = GetWorld()->GetSubsystem<UFightTimerSubsystem>())
+	{
+		TimerSubsystem->ClearTimer(EndHitStopTimerHandle);
+	}
+
+	for (const FFightHitStopActor& DilatedActor : DilatedActors)
+	{
+		RestoreDilatedActor(DilatedActor);
+	}
+
+	DilatedActors.Reset();
+	WindowEndTime = 0.0;
+}
+
+void UFightHitStopComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	EndHitStop();
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void UFightHitStopComponent::AddDilatedActor(AActor* InActor)
+{
+	const bool bAlreadyDilated = DilatedActors.ContainsByPredicate(
+		[InActor](const FFightHitStopActor& DilatedActor) { return DilatedActor.Actor == InActor; });
+
+	if (bAlreadyDilated)
+	{
+		return;
+	}
+
+	FFightHitStopActor& NewDilatedActor = DilatedActors.AddDefaulted_GetRef();
+	NewDilatedActor.Actor = InActor;
+
+	if (!ShouldDilateVisualsOnly())
+	{
+		NewDilatedActor.OriginalTimeDilation = InActor->CustomTimeDilation;
+		InActor->CustomTimeDilation = HitStopTimeDilation;
+		return;
+	}
+
+	// 只改动画播放倍率 --> 移动组件与能力仍按正常时间运行，本地预测与服务器保持一致
+	NewDilatedActor.bDilatedVisualsOnly = true;
+
+	TArray<USkeletalMeshComponent*> SkeletalMeshComponents;
+	InActor->GetComponents(SkeletalMeshComponents);
+
+	for (USkeletalMeshComponent* SkeletalMeshComponent : SkeletalMeshComponents)
+	{
+		FFightHitStopMesh& NewDilatedMesh = NewDilatedActor.Meshes.AddDefaulted_GetRef();
+		NewDilatedMesh.Mesh = SkeletalMeshComponent;
+		NewDilatedMesh.OriginalAnimRateScale = SkeletalMeshComponent->GlobalAnimRateScale;
+
+		SkeletalMeshComponent->GlobalAnimRateScale = HitStopTimeDilation;
+	}
+}
+
+void UFightHitStopComponent::RestoreDilatedActor(const FFightHitStopActor& InDilatedActor) const
+{
+	AActor* Actor = InDilatedActor.Actor.Get();
+	if (!Actor)
+	{
+		return;
+	}
+
+	// 期间被其他逻辑改写过的时间膨胀与动画倍率保持不动
+	if (!InDilatedActor.bDilatedVisualsOnly)
+	{
+		if (Actor->CustomTimeDilation == HitStopTimeDilation)
+		{
+			Actor->CustomTimeDilation = InDilatedActor.OriginalTimeDilation;
+		}
+		return;
+	}
+
+	for (const FFightHitStopMesh& DilatedMesh : InDilatedActor.Meshes)
+	{
+		USkeletalMeshComponent* SkeletalMeshComponent = DilatedMesh.Mesh.Get();
+		if (SkeletalMeshComponent && SkeletalMeshComponent->GlobalAnimRateScale == HitStopTimeDilation)
+		{
+			SkeletalMeshComponent->GlobalAnimRateScale = DilatedMesh.OriginalAnimRateScale;
+		}
+	}
+}
+
+bool UFightHitStopComponent::ShouldDilateVisualsOnly() const
+{
+#if WITH_DEV_AUTOMATION_TESTS
+	if (bForceDilateVisualsOnlyForTesting)
+	{
+		return true;
+	}
+#endif
+
+	return GetWorld()->GetNetMode() != NM_Standalone;
+}
@@ -4,10 +4,28 @@
 #include "Components/Combat/PawnCombatComponent.h"
 #include "Items/Weapons/FightWeaponBase.h"
 #include "Components/BoxComponent.h"
-#include "Items/Weapons/FightWeaponBase.h"
+#include "Net/UnrealNetwork.h"
+#include "Net/Core/PushModel/PushModel.h"
 
 #include "GASDebugHelper.h"
 
+UPawnCombatComponent::UPawnCombatComponent()
+{
+	SetIsReplicatedByDefault(true);
+}
+
+void UPawnCombatComponent::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+	// 推送模式 --> 武器映射与装备标签很少变化，不必每次网络更新都比较
+	FDoRepLifetimeParams PushParams;
+	PushParams.bIsPushBased = true;
+
+	DOREPLIFETIME_WITH_PARAMS_FAST(ThisClass, CurrentEquippedWeaponTag, PushParams);
+	DOREPLIFETIME_WITH_PARAMS_FAST(ThisClass, ReplicatedCarriedWeapons, PushParams);
+}
+
 void UPawnCombatComponent::RegisterSpawnedWeapon(FGameplayTag InWeaponTagToRegister, 
 	AFightWeaponBase* InWeaponToRegister, bool bRegisterAsEquippedWeapon)
 {
@@ -18,15 +36,27 @@ void UPawnCombatComponent::RegisterSpawnedWeapon(FGameplayTag InWeaponTagToRegis
 	// 将武器标签和武器实例添加到角色携带的武器映射表中
 	CharacterCarriedWeaponMap.Emplace(InWeaponTagToRegister, InWeaponToRegister);
 
-	// 绑定武器的击中目标事件到本组件的OnHitTargetActor处理函数 --> BindUObject用于将 UObject 的成员函数绑定到委托
-	InWeaponToRegister->OnWeaponHitTarget.BindUObject(this, &ThisClass::OnHitTargetActor);
-	// 绑定武器的从目标拔出事件到本组件的OnWeaponPulledFromTarget处理函数
-	InWeaponToRegister->OnWeaponPulledFromTarget.BindUObject(this, &ThisClass::OnWeaponPulledFromTarget);
+	FFightCarriedWeaponEntry& ReplicatedEntry = ReplicatedCarriedWeapons.AddDefaulted_GetRef();
+	ReplicatedEntry.WeaponTag = InWeaponTagToRegister;
+	ReplicatedEntry.Weapon = InWeaponToRegister;
+
+	// 休眠中的角色不会再比较推送属性，先唤醒一次才能把新条目发出去
+	GetOwner()->FlushNetDormancy();
+	MARK_PROPERTY_DIRTY_FROM_NAME(ThisClass, ReplicatedCarriedWeapons, this);
+
+	BindWeaponDelegates(InWeaponToRegister);
 
 	if (bRegisterAsEquippedWeapon)
 	{
-		CurrentEquippedWeaponTag = InWeaponTagToRegister;
+		SetCurrentEquippedWeaponTag(InWeaponTagToRegister);
 	}
+	else if (GetOwner()->HasAuthority())
+	{
+		// 未装备的武器挂在角色身上不再变化
+		InWeaponToRegister->SetWeaponNetDormant(true);
+	}
+
+	OnWeaponRegistered(InWeaponTagToRegister, InWeaponToRegister);
 }
 
 AFightWeaponBase* UPawnCombatComponent::GetCharacterCarriedWeaponByTag(FGameplayTag InWeaponTagToGet) const
@@ -43,6 +73,35 @@ AFightWeaponBase* UPawnCombatComponent::GetCharacterCarriedWeaponByTag(FGameplay
 	return nullptr;
 }
 
+void UPawnCombatComponent::SetCurrentEquippedWeaponTag(FGameplayTag InWeaponTag)
+{
+	if (CurrentEquippedWeaponTag == InWeaponTag)
+	{
+		return;
+	}
+
+	AFightWeaponBase* PreviousEquippedWeapon = GetCharacterCurrentEquippedWeapon();
+
+	CurrentEquippedWeaponTag = InWeaponTag;
+	GetOwner()->FlushNetDormancy();
+	MARK_PROPERTY_DIRTY_FROM_NAME(ThisClass, CurrentEquippedWeaponTag, this);
+
+	if (!GetOwner()->HasAuthority())
+	{
+		return;
+	}
+
+	if (PreviousEquippedWeapon)
+	{
+		PreviousEquippedWeapon->SetWeaponNetDormant(true);
+	}
+
+	if (AFightWeaponBase* NewEquippedWeapon = GetCharacterCurrentEquippedWeapon())
+	{
+		NewEquippedWeapon->SetWeaponNetDormant(false);
+	}
+}
+
 AFightWeaponBase* UPawnCombatComponent::GetCharacterCurrentEquippedWeapon() const
 {
 	// 检查当前装备武器标签是否有效 --> IsValid是FGameplayTag的方法，用于检查标签是否有效
@@ -112,3 +171,41 @@ void UPawnCombatComponent::ToggleBodyCollisionBoxCollision(bool bShouldEnable, E
 {
 
 }
+
+void UPawnCombatComponent::BindWeaponDelegates(AFightWeaponBase* InWeapon)
+{
+	// 服务器注册与客户端复制都会走到这里，已绑定到本组件时跳过
+	if (!InWeapon->OnWeaponHitTarget.IsBoundToObject(this))
+	{
+		// 绑定武器的击中目标事件到本组件的OnHitTargetActor处理函数 --> BindUObject用于将 UObject 的成员函数绑定到委托
+		InWeapon->OnWeaponHitTarget.BindUObject(this, &ThisClass::OnHitTargetActor);
+	}
+
+	if (!InWeapon->OnWeaponPulledFromTarget.IsBoundToObject(this))
+	{
+		// 绑定武器的从目标拔出事件到本组件的OnWeaponPulledFromTarget处理函数
+		InWeapon->OnWeaponPulledFromTarget.BindUObject(this, &ThisClass::OnWeaponPulledFromTarget);
+	}
+}
+
+void UPawnCombatComponent::OnRep_CarriedWeapons()
+{
+	// 客户端重建映射表，并绑定武器的命中事件 --> 本地检测到的命中由客户端上报，服务器回溯校验
+	const TMap<FGameplayTag, AFightWeaponBase*> PreviousWeaponMap = MoveTemp(CharacterCarriedWeaponMap);
+	CharacterCarriedWeaponMap.Reset();
+
+	for (const FFightCarriedWeaponEntry& Entry : ReplicatedCarriedWeapons)
+	{
+		if (Entry.Weapon)
+		{
+			CharacterCarriedWeaponMap.Emplace(Entry.WeaponTag, Entry.Weapon);
+			BindWeaponDelegates(Entry.Weapon);
+
+			// 新复制来的武器同样通知子类，客户端的玩家也能记录武器解锁
+			if (PreviousWeaponMap.FindRef(Entry.WeaponTag) != Entry.Weapon)
+			{
+				OnWeaponRegistered(Entry.WeaponTag, Entry.Weapon);
+			}
+		}
+	}
+}
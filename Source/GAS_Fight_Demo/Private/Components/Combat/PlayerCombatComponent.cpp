@@ -4,7 +4,13 @@
 #include "Components/Combat/PlayerCombatComponent.h"
 #include "Items/Weapons/FightPlayerWeapon.h"
 #include "GAS/FightGameplayTags.h"
-#include "AbilitySystemBlueprintLibrary.h"
+#include "SaveGame/FightSaveGameSubsystem.h"
+#include "Kismet/GameplayStatics.h"
+#include "GameFramework/GameStateBase.h"
+#include "Game/FightHitValidationSubsystem.h"
+#include "Game/FightEventBusSubsystem.h"
+#include "Components/Combat/FightHitStopComponent.h"
+#include "Characters/MainCharacter.h"
 
 #include "GASDebugHelper.h"
 
@@ -34,23 +40,125 @@ void UPlayerCombatComponent::OnHitTargetActor(AActor* HitActor)
 	// 将目标添加到已处理列表中
 	OverlappedActors.AddUnique(HitActor);
 
-	// 创建游戏事件数据
-	FGameplayEventData Data;
-	Data.Instigator = GetOwningPawn(); // 设置事件发起者为拥有该组件的Pawn
-	Data.Target = HitActor;            // 设置事件目标为被命中的Actor
+	const APawn* OwningPawn = GetOwningPawn();
 
-	// 发送近战命中事件给拥有该组件的Pawn
-	UAbilitySystemBlueprintLibrary::SendGameplayEventToActor(GetOwningPawn(),
-		FightGameplayTags::Shared_Event_MeleeHit, Data);
+	// 远端客户端的角色在服务器上的重叠不作数 --> 以该客户端上报、经过回溯校验的命中为准
+	if (OwningPawn->HasAuthority() && !OwningPawn->IsLocallyControlled())
+	{
+		return;
+	}
+
+	// 客户端：本地立即顿帧保证手感，命中本身交给服务器校验
+	if (!OwningPawn->HasAuthority())
+	{
+		// 其他玩家的模拟代理同样绑定了武器委托，但只有拥有者客户端能上报
+		if (!OwningPawn->IsLocallyControlled())
+		{
+			return;
+		}
+
+		RequestHitPause(HitActor);
+
+		const AGameStateBase* GameState = GetWorld()->GetGameState();
+		Server_ConfirmMeleeHit(HitActor, CurrentSwingId,
+			GameState ? GameState->GetServerWorldTimeSeconds() : GetWorld()->GetTimeSeconds());
+		return;
+	}
+
+	ApplyConfirmedMeleeHit(HitActor);
+}
+
+void UPlayerCombatComponent::ApplyConfirmedMeleeHit(AActor* HitActor)
+{
+	// 发送近战命中事件给拥有该组件的Pawn --> 发起者为该Pawn，目标为被命中的Actor，伤害立即结算
+	UFightEventBusSubsystem::SendFightEvent(GetOwningPawn(),
+		FightGameplayTags::Shared_Event_MeleeHit, GetOwningPawn(), HitActor);
+
+	RequestHitPause(HitActor);
+}
 
-	UAbilitySystemBlueprintLibrary::SendGameplayEventToActor(GetOwningPawn(),
-		FightGameplayTags::Player_Event_HitPause, FGameplayEventData());
+void UPlayerCombatComponent::RequestHitPause(AActor* InHitActor)
+{
+	const AMainCharacter* MainCharacter = Cast<AMainCharacter>(GetOwner());
+	UFightHitStopComponent* HitStopComponent = MainCharacter ? MainCharacter->GetFightHitStopComponent() : nullptr;
+
+	if (HitStopComponent && HitStopComponent->IsHitStopSchedulerEnabled())
+	{
+		HitStopComponent->RequestHitStop(InHitActor);
+		return;
+	}
+
+	// 顿帧只影响表现，放到帧末批量派发
+	UFightEventBusSubsystem::SendFightEvent(GetOwningPawn(),
+		FightGameplayTags::Player_Event_HitPause, nullptr, nullptr, EFightEventDispatch::Deferred);
 }
 
 void UPlayerCombatComponent::OnWeaponPulledFromTarget(AActor* InteractedActor)
 {
-	UAbilitySystemBlueprintLibrary::SendGameplayEventToActor(GetOwningPawn(),
-		FightGameplayTags::Player_Event_HitPause, FGameplayEventData());
+	RequestHitPause(InteractedActor);
 
 	// TODO: 在此处添加武器从目标上移开时的处理逻辑
 }
+
+void UPlayerCombatComponent::OnWeaponRegistered(FGameplayTag InWeaponTag, AFightWeaponBase* InWeapon)
+{
+	Super::OnWeaponRegistered(InWeaponTag, InWeapon);
+
+	// 只记录本地玩家自己获得的玩家武器 --> 服务器上其他玩家的武器、敌人授予的武器与非玩家武器标签的临时武器都不算解锁
+	if (!GetOwningPawn()->IsLocallyControlled() || !Cast<AFightPlayerWeapon>(InWeapon) ||
+		!InWeaponTag.MatchesTag(FightGameplayTags::Player_Weapon))
+	{
+		return;
+	}
+
+	if (UGameInstance* GameInstance = UGameplayStatics::GetGameInstance(this))
+	{
+		GameInstance->GetSubsystem<UFightSaveGameSubsystem>()->RecordWeaponUnlocked(InWeaponTag);
+	}
+}
+
+void UPlayerCombatComponent::ToggleCurrentEquippedWeaponCollision(bool bShouldEnable)
+{
+	if (bShouldEnable)
+	{
+		CurrentSwingId++;
+	}
+
+	Super::ToggleCurrentEquippedWeaponCollision(bShouldEnable);
+}
+
+void UPlayerCombatComponent::Server_ConfirmMeleeHit_Implementation(AActor* HitActor, int32 InSwingId, double InClaimServerTime)
+{
+	if (!HitActor)
+	{
+		return;
+	}
+
+	// 挥砍ID只能递增 --> 客户端预测了服务器没有执行的挥砍时，两端的计数不再一致，因此不与服务器的计数比较
+	if (InSwingId < LastConfirmedSwingId)
+	{
+		return;
+	}
+
+	if (InSwingId != LastConfirmedSwingId)
+	{
+		LastConfirmedSwingId = InSwingId;
+		ConfirmedTargetsThisSwing.Reset();
+	}
+
+	// 同一次挥砍对同一目标只确认一次
+	if (ConfirmedTargetsThisSwing.Contains(HitActor))
+	{
+		return;
+	}
+
+	const UFightHitValidationSubsystem* HitValidationSubsystem = GetWorld()->GetSubsystem<UFightHitValidationSubsystem>();
+	if (!HitValidationSubsystem || !HitValidationSubsystem->ValidateMeleeHit(GetOwningPawn(), HitActor, InClaimServerTime))
+	{
+		return;
+	}
+
+	ConfirmedTargetsThisSwing.Add(HitActor);
+
+	ApplyConfirmedMeleeHit(HitActor);
+}
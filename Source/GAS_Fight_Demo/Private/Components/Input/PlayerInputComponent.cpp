@@ -3,3 +3,82 @@
 
 #include "Components/Input/PlayerInputComponent.h"
 
+
+void UPlayerInputComponent::StartInputRecording(int32 InRandomSeed, float InFixedDeltaTime)
+{
+	RecordingInputLog = FFightInputLog();
+	RecordingInputLog.RandomSeed = InRandomSeed;
+	RecordingInputLog.FixedDeltaTime = InFixedDeltaTime;
+
+	InputStartFrameCounter = GetFrameCounter();
+	bIsRecordingInput = true;
+}
+
+bool UPlayerInputComponent::StopInputRecording(const FString& InFilePath)
+{
+	if (!bIsRecordingInput)
+	{
+		return false;
+	}
+
+	bIsRecordingInput = false;
+
+	return RecordingInputLog.SaveToFile(InFilePath);
+}
+
+void UPlayerInputComponent::StartInputReplay(const TSharedRef<const FFightInputLog>& InReplayLog)
+{
+	ReplayInputLog = InReplayLog;
+	NextReplayEventIndex = 0;
+
+	InputStartFrameCounter = GetFrameCounter();
+}
+
+void UPlayerInputComponent::StopInputReplay()
+{
+	ReplayInputLog.Reset();
+	NextReplayEventIndex = 0;
+}
+
+bool UPlayerInputComponent::TickInputReplay()
+{
+	if (!ReplayInputLog.IsValid())
+	{
+		return false;
+	}
+
+	const uint32 CurrentFrame = GetInputFrame();
+	const TArray<FFightInputLogEvent>& Events = ReplayInputLog->Events;
+
+	// 事件按帧序号有序，逐个派发到当前帧为止
+	TGuardValue<bool> DispatchGuard(bIsDispatchingReplayEvent, true);
+
+	while (Events.IsValidIndex(NextReplayEventIndex) && Events[NextReplayEventIndex].Frame <= CurrentFrame)
+	{
+		const FFightInputLogEvent& Event = Events[NextReplayEventIndex++];
+		OnReplayInputEvent.ExecuteIfBound(Event, ReplayInputLog->GetEventTag(Event));
+	}
+
+	return Events.IsValidIndex(NextReplayEventIndex);
+}
+
+bool UPlayerInputComponent::PreprocessInputEvent(EFightInputLogEventType InType, const FVector2f& InValue, const FGameplayTag& InTag)
+{
+	if (ReplayInputLog.IsValid())
+	{
+		return bIsDispatchingReplayEvent;
+	}
+
+	if (bIsRecordingInput)
+	{
+		RecordingInputLog.AddEvent(GetInputFrame(), InType, InValue, InTag);
+	}
+
+	return true;
+}
+
+uint32 UPlayerInputComponent::GetInputFrame() const
+{
+	return static_cast<uint32>(GetFrameCounter() - InputStartFrameCounter);
+}
+
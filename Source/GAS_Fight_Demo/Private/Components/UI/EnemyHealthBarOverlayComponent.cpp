@@ -0,0 +1,181 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Components/UI/EnemyHealthBarOverlayComponent.h"
+#include "Characters/EnemyCharacter.h"
+#include "Widgets/FightEnemyHealthBarWidget.h"
+#include "Engine/LocalPlayer.h"
+#include "Engine/GameViewportClient.h"
+#include "SceneView.h"
+
+
+UEnemyHealthBarOverlayComponent::UEnemyHealthBarOverlayComponent()
+{
+	PrimaryComponentTick.bCanEverTick = true;
+	// 在所有角色移动完成后再投影，避免血条落后一帧
+	PrimaryComponentTick.TickGroup = TG_PostUpdateWork;
+}
+
+UEnemyHealthBarOverlayComponent* UEnemyHealthBarOverlayComponent::FindLocalOverlay(const UObject* WorldContextObject)
+{
+	const UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+	const APlayerController* LocalPlayerController = World ? World->GetFirstPlayerController() : nullptr;
+
+	if (!LocalPlayerController || !LocalPlayerController->IsLocalController())
+	{
+		return nullptr;
+	}
+
+	return LocalPlayerController->FindComponentByClass<UEnemyHealthBarOverlayComponent>();
+}
+
+void UEnemyHealthBarOverlayComponent::BeginPlay()
+{
+	Super::BeginPlay();
+
+	APlayerController* OwningPlayerController = Cast<APlayerController>(GetOwner());
+	if (!IsOverlayEnabled() || !OwningPlayerController || !OwningPlayerController->IsLocalController())
+	{
+		SetComponentTickEnabled(false);
+		return;
+	}
+
+	// 一次性创建全部控件，之后只切换可见性与位置
+	HealthBarWidgetPool.Reserve(HealthBarPoolSize);
+	for (int32 Index = 0; Index < HealthBarPoolSize; ++Index)
+	{
+		UFightEnemyHealthBarWidget* HealthBarWidget = CreateWidget<UFightEnemyHealthBarWidget>(OwningPlayerController, HealthBarWidgetClass);
+		check(HealthBarWidget);
+
+		HealthBarWidget->SetAlignmentInViewport(FVector2D(0.5f, 1.f));
+		HealthBarWidget->SetVisibility(ESlateVisibility::Collapsed);
+		HealthBarWidget->AddToViewport();
+
+		HealthBarWidgetPool.Add(HealthBarWidget);
+	}
+}
+
+void UEnemyHealthBarOverlayComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	for (UFightEnemyHealthBarWidget* HealthBarWidget : HealthBarWidgetPool)
+	{
+		if (HealthBarWidget)
+		{
+			HealthBarWidget->RemoveFromParent();
+		}
+	}
+
+	HealthBarWidgetPool.Empty();
+	TrackedEnemies.Empty();
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void UEnemyHealthBarOverlayComponent::RegisterEnemy(AEnemyCharacter* InEnemy)
+{
+	if (InEnemy)
+	{
+		TrackedEnemies.AddUnique(InEnemy);
+	}
+}
+
+void UEnemyHealthBarOverlayComponent::UnregisterEnemy(const AEnemyCharacter* InEnemy)
+{
+	const int32 FoundIndex = TrackedEnemies.IndexOfByKey(InEnemy);
+	if (FoundIndex != INDEX_NONE)
+	{
+		TrackedEnemies.RemoveAtSwap(FoundIndex, 1, EAllowShrinking::No);
+	}
+}
+
+void UEnemyHealthBarOverlayComponent::TickComponent(float DeltaTime, ELevelTick TickType,
+	FActorComponentTickFunction* ThisTickFunction)
+{
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+	FrameCandidates.Reset();
+
+	const APlayerController* OwningPlayerController = CastChecked<APlayerController>(GetOwner());
+	const ULocalPlayer* LocalPlayer = OwningPlayerController->GetLocalPlayer();
+
+	// 整帧只获取一次投影矩阵，之后对所有敌人复用
+	FSceneViewProjectionData ProjectionData;
+	const bool bHasProjection = LocalPlayer && LocalPlayer->ViewportClient &&
+		LocalPlayer->GetProjectionData(LocalPlayer->ViewportClient->Viewport, ProjectionData);
+
+	if (bHasProjection && !TrackedEnemies.IsEmpty())
+	{
+		const FMatrix ViewProjectionMatrix = ProjectionData.ComputeViewProjectionMatrix();
+		const FIntRect ViewRect = ProjectionData.GetConstrainedViewRect();
+		const FVector ViewOrigin = ProjectionData.ViewOrigin;
+		const float MaxDrawDistSquared = FMath::Square(MaxDrawDistance);
+
+		for (int32 Index = TrackedEnemies.Num() - 1; Index >= 0; --Index)
+		{
+			const AEnemyCharacter* TrackedEnemy = TrackedEnemies[Index].Get();
+			if (!TrackedEnemy)
+			{
+				TrackedEnemies.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+				continue;
+			}
+
+			const UBasicAttributeSet* AttributeSet = TrackedEnemy->GetBasicAttributeSet();
+			const float MaxHealth = AttributeSet->GetMaxHealth();
+			const float HealthPercent = MaxHealth > 0.f ? AttributeSet->GetCurrentHealth() / MaxHealth : 0.f;
+
+			if (HealthPercent <= 0.f || (bOnlyShowDamagedEnemies && HealthPercent >= 1.f))
+			{
+				continue;
+			}
+
+			const FVector WorldLocation = TrackedEnemy->GetActorLocation() + HealthBarWorldOffset;
+			const float DistSquared = static_cast<float>(FVector::DistSquared(ViewOrigin, WorldLocation));
+			if (DistSquared > MaxDrawDistSquared)
+			{
+				continue;
+			}
+
+			FVector2D ScreenPosition;
+			if (!FSceneView::ProjectWorldToScreen(WorldLocation, ViewRect, ViewProjectionMatrix, ScreenPosition))
+			{
+				continue;
+			}
+
+			// 转为相对玩家视口的坐标
+			ScreenPosition -= FVector2D(ViewRect.Min);
+
+			FrameCandidates.Add({ DistSquared, HealthPercent, ScreenPosition });
+		}
+	}
+
+	// 候选多于控件池时，只显示最近的若干个
+	if (FrameCandidates.Num() > HealthBarWidgetPool.Num())
+	{
+		FrameCandidates.Sort(
+			[](const FHealthBarCandidate& A, const FHealthBarCandidate& B)
+			{
+				return A.DistSquared < B.DistSquared;
+			}
+		);
+	}
+
+	const int32 NumToShow = FMath::Min(FrameCandidates.Num(), HealthBarWidgetPool.Num());
+	for (int32 Index = 0; Index < NumToShow; ++Index)
+	{
+		UFightEnemyHealthBarWidget* HealthBarWidget = HealthBarWidgetPool[Index];
+		HealthBarWidget->SetHealthPercent(FrameCandidates[Index].HealthPercent);
+		HealthBarWidget->SetPositionInViewport(FrameCandidates[Index].ScreenPosition, true);
+
+		if (Index >= NumVisibleWidgets)
+		{
+			HealthBarWidget->SetVisibility(ESlateVisibility::HitTestInvisible);
+		}
+	}
+
+	for (int32 Index = NumToShow; Index < NumVisibleWidgets; ++Index)
+	{
+		HealthBarWidgetPool[Index]->SetVisibility(ESlateVisibility::Collapsed);
+	}
+
+	NumVisibleWidgets = NumToShow;
+}
@@ -3,6 +3,8 @@
 
 #include "Components/UI/EnemyUIComponent.h"
 #include "Widgets/FightWidgetBase.h"
+#include "Components/UI/EnemyHealthBarOverlayComponent.h"
+#include "Characters/EnemyCharacter.h"
 
 
 void UEnemyUIComponent::RegisterEnemyDrawnWidget(UFightWidgetBase* InWidgetToRegister)
@@ -12,6 +14,12 @@ void UEnemyUIComponent::RegisterEnemyDrawnWidget(UFightWidgetBase* InWidgetToReg
 
 void UEnemyUIComponent::RemoveEnemyDrawnWidgetIfAny()
 {
+	// 敌人死亡时同时停止在共享覆盖层中绘制血条
+	if (UEnemyHealthBarOverlayComponent* HealthBarOverlay = UEnemyHealthBarOverlayComponent::FindLocalOverlay(this))
+	{
+		HealthBarOverlay->UnregisterEnemy(GetOwningPawn<AEnemyCharacter>());
+	}
+
 	if (EnemyDrawnWidgets.IsEmpty())
 	{
 		return;
@@ -2,4 +2,80 @@
 
 
 #include "Components/UI/PlayerUIComponent.h"
+#include "Widgets/FightUIAssetCacheSubsystem.h"
+#include "Engine/GameInstance.h"
+#include "Engine/Texture2D.h"
+#include "Materials/MaterialInterface.h"
 
+
+void UPlayerUIComponent::BeginPlay()
+{
+	Super::BeginPlay();
+
+	// 蓝图仍然广播软引用，这里统一解析后再转发给控件
+	OnEquippedWeaponChanged.AddDynamic(this, &ThisClass::HandleEquippedWeaponChanged);
+	OnAbilityIconSlotUpdated.AddDynamic(this, &ThisClass::HandleAbilityIconSlotUpdated);
+}
+
+void UPlayerUIComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UFightUIAssetCacheSubsystem* UIAssetCache = UGameInstance::GetSubsystem<UFightUIAssetCacheSubsystem>(GetWorld()->GetGameInstance()))
+	{
+		UIAssetCache->ReleaseAsset(DisplayedWeaponIconPath);
+
+		for (const TPair<FGameplayTag, FSoftObjectPath>& DisplayedAbilityIcon : DisplayedAbilityIconPaths)
+		{
+			UIAssetCache->ReleaseAsset(DisplayedAbilityIcon.Value);
+		}
+	}
+
+	DisplayedWeaponIconPath.Reset();
+	DisplayedAbilityIconPaths.Empty();
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void UPlayerUIComponent::HandleEquippedWeaponChanged(TSoftObjectPtr<UTexture2D> InSoftWeaponIcon)
+{
+	UFightUIAssetCacheSubsystem* UIAssetCache = UGameInstance::GetSubsystem<UFightUIAssetCacheSubsystem>(GetWorld()->GetGameInstance());
+
+	const FSoftObjectPath PreviousIconPath = DisplayedWeaponIconPath;
+	DisplayedWeaponIconPath = InSoftWeaponIcon.ToSoftObjectPath();
+
+	// 先获取新图标再释放旧图标，相同图标不会被卸载
+	UIAssetCache->AcquireAsset(DisplayedWeaponIconPath, FFightOnUIAssetLoadedDelegate::CreateWeakLambda(this,
+		[this, IconPath = DisplayedWeaponIconPath](UObject* LoadedAsset)
+		{
+			// 加载期间武器已再次切换
+			if (IconPath == DisplayedWeaponIconPath)
+			{
+				OnEquippedWeaponIconResolved.Broadcast(Cast<UTexture2D>(LoadedAsset));
+			}
+		}
+	));
+
+	UIAssetCache->ReleaseAsset(PreviousIconPath);
+}
+
+void UPlayerUIComponent::HandleAbilityIconSlotUpdated(FGameplayTag InAbilityInputTag,
+	TSoftObjectPtr<UMaterialInterface> InSoftAbilityIconMaterial)
+{
+	UFightUIAssetCacheSubsystem* UIAssetCache = UGameInstance::GetSubsystem<UFightUIAssetCacheSubsystem>(GetWorld()->GetGameInstance());
+
+	FSoftObjectPath& DisplayedIconPath = DisplayedAbilityIconPaths.FindOrAdd(InAbilityInputTag);
+	const FSoftObjectPath PreviousIconPath = DisplayedIconPath;
+	DisplayedIconPath = InSoftAbilityIconMaterial.ToSoftObjectPath();
+
+	UIAssetCache->AcquireAsset(DisplayedIconPath, FFightOnUIAssetLoadedDelegate::CreateWeakLambda(this,
+		[this, InAbilityInputTag, IconPath = DisplayedIconPath](UObject* LoadedAsset)
+		{
+			const FSoftObjectPath* CurrentIconPath = DisplayedAbilityIconPaths.Find(InAbilityInputTag);
+			if (CurrentIconPath && *CurrentIconPath == IconPath)
+			{
+				OnAbilityIconSlotResolved.Broadcast(InAbilityInputTag, Cast<UMaterialInterface>(LoadedAsset));
+			}
+		}
+	));
+
+	UIAssetCache->ReleaseAsset(PreviousIconPath);
+}
@@ -91,16 +91,17 @@ void AFightAIController::BeginPlay()
 	}
 }
 
+const FName AFightAIController::TargetActorKeyName(TEXT("TargetActor"));
+
 void AFightAIController::OnEnemyPerceptionUpdated(AActor* Actor, FAIStimulus Stimulus)
 {
 	if (UBlackboardComponent* BlackboardComponent = GetBlackboardComponent())
 	{
-		if (!BlackboardComponent->GetValueAsObject(FName("TargetActor")))
+		if (!BlackboardComponent->GetValueAsObject(TargetActorKeyName))
 		{
 			if (Stimulus.WasSuccessfullySensed() && Actor)
 			{
-				// 此处的FName("TargetActor")应与行为树黑板中的键名一致
-				BlackboardComponent->SetValueAsObject(FName("TargetActor"), Actor);
+				BlackboardComponent->SetValueAsObject(TargetActorKeyName, Actor);
 			}
 		}
 	}
@@ -3,11 +3,14 @@
 
 #include "Controllers/MainPlayerController.h"
 #include "EnhancedInputSubsystems.h"
+#include "Components/UI/EnemyHealthBarOverlayComponent.h"
 
 
 AMainPlayerController::AMainPlayerController()
 {
 	PlayerTeamId = FGenericTeamId(0);
+
+	EnemyHealthBarOverlayComponent = CreateDefaultSubobject<UEnemyHealthBarOverlayComponent>("EnemyHealthBarOverlayComponent");
 }
 
 FGenericTeamId AMainPlayerController::GetGenericTeamId() const
@@ -0,0 +1,47 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "DataAsset/Difficulty/DataAsset_DifficultyPolicy.h"
+
+
+bool UDataAsset_DifficultyPolicy::FindDifficultyPolicyEntry(EFightGameDifficulty InDifficulty,
+	FFightDifficultyPolicyEntry& OutEntry) const
+{
+	if (const FFightDifficultyPolicyEntry* FoundEntry = DifficultyPolicies.Find(InDifficulty))
+	{
+		OutEntry = *FoundEntry;
+		return true;
+	}
+
+	return false;
+}
+
+FFightDifficultyPolicyEntry UDataAsset_DifficultyPolicy::MakeDefaultDifficultyPolicyEntry(EFightGameDifficulty InDifficulty)
+{
+	FFightDifficultyPolicyEntry DefaultEntry;
+
+	// 难度越高玩家等级越低、敌人等级越高
+	switch (InDifficulty)
+	{
+	case EFightGameDifficulty::Easy:
+		DefaultEntry.PlayerAbilityApplyLevel = 4;
+		DefaultEntry.EnemyAbilityApplyLevel = 1;
+		break;
+	case EFightGameDifficulty::Normal:
+		DefaultEntry.PlayerAbilityApplyLevel = 3;
+		DefaultEntry.EnemyAbilityApplyLevel = 2;
+		break;
+	case EFightGameDifficulty::Hard:
+		DefaultEntry.PlayerAbilityApplyLevel = 2;
+		DefaultEntry.EnemyAbilityApplyLevel = 3;
+		break;
+	case EFightGameDifficulty::Hell:
+		DefaultEntry.PlayerAbilityApplyLevel = 1;
+		DefaultEntry.EnemyAbilityApplyLevel = 4;
+		break;
+	default:
+		break;
+	}
+
+	return DefaultEntry;
+}
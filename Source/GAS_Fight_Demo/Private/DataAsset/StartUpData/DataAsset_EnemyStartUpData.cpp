@@ -4,26 +4,18 @@
 #include "DataAsset/StartUpData/DataAsset_EnemyStartUpData.h"
 #include "GAS/FightAbilitySystemComponent.h"
 
-void UDataAsset_EnemyStartUpData::GiveToAbilitySystemComponent(UFightAbilitySystemComponent* InASCToGive, int32 ApplyLevel)
+void UDataAsset_EnemyStartUpData::BuildGrantBundle(FFightStartUpGrantBundle& OutBundle, int32 ApplyLevel) const
 {
-	Super::GiveToAbilitySystemComponent(InASCToGive, ApplyLevel);
+	Super::BuildGrantBundle(OutBundle, ApplyLevel);
 
-	if (!EnemyCombatAbilities.IsEmpty())
+	for (const TSubclassOf<UFightEnemyGameplayAbility>& AbilityClass : EnemyCombatAbilities)
 	{
-		for (const TSubclassOf<UFightEnemyGameplayAbility>& AbilityClass : EnemyCombatAbilities)
+		if (!AbilityClass)
 		{
-			if (!AbilityClass)
-			{
-				continue;
-			}
-
-			// 创建一个技能规格（AbilitySpec），指定技能类（AbilityClass）和应用等级（ApplyLevel），用于描述要赋予的技能
-			FGameplayAbilitySpec AbilitySpec(AbilityClass, ApplyLevel);
-			// 设置技能的来源对象为当前能力系统组件的 AvatarActor，通常代表技能的拥有者。
-			AbilitySpec.SourceObject = InASCToGive->GetAvatarActor();
-			AbilitySpec.Level = ApplyLevel;
-
-			InASCToGive->GiveAbility(AbilitySpec);
+			continue;
 		}
+
+		// 技能规格模板只描述技能类与应用等级，来源对象在授予时设置
+		OutBundle.AbilitySpecTemplates.Emplace(AbilityClass, ApplyLevel);
 	}
 }
@@ -6,20 +6,16 @@
 #include "GAS/FightAbilitySystemComponent.h"
 
 
-void UDataAsset_PlayerStartUpData::GiveToAbilitySystemComponent(UFightAbilitySystemComponent* InASCToGive, int32 ApplyLevel)
+void UDataAsset_PlayerStartUpData::BuildGrantBundle(FFightStartUpGrantBundle& OutBundle, int32 ApplyLevel) const
 {
-	Super::GiveToAbilitySystemComponent(InASCToGive, ApplyLevel);
+	Super::BuildGrantBundle(OutBundle, ApplyLevel);
 
 	for (const FFightPlayerAbilitySet& AbilitySet : PlayerStartUpAbilitySets)
 	{
 		if (!AbilitySet.IsValid()) continue;
 
-		FGameplayAbilitySpec AbilitySpec(AbilitySet.AbilityToGrant);
-		AbilitySpec.SourceObject = InASCToGive->GetAvatarActor();
-		AbilitySpec.Level = ApplyLevel;
+		FGameplayAbilitySpec& AbilitySpec = OutBundle.AbilitySpecTemplates.Emplace_GetRef(AbilitySet.AbilityToGrant, ApplyLevel);
 		// 用于存储运行时动态添加的Gameplay Tags --> 与静态配置的标签不同，这些标签可以在游戏运行时动态修改
 		AbilitySpec.GetDynamicSpecSourceTags().AddTag(AbilitySet.InputTag);
-
-		InASCToGive->GiveAbility(AbilitySpec);
 	}
 }
@@ -4,62 +4,147 @@
 #include "DataAsset/StartUpData/DataAsset_StartUpDataBase.h"
 #include "GAS/FightAbilitySystemComponent.h"
 #include "GAS/Abilities/FightGameplayAbility.h"
+#include "GAS/BasicAttributeSet.h"
+#include "GameplayEffectComponents/AssetTagsGameplayEffectComponent.h"
+#include "UObject/UObjectHash.h"
+
+
+/**
+ * @brief 效果上的所有组件是否都在快速路径的白名单中
+ *
+ * 白名单只包含不影响瞬时效果应用结果的组件 --> 提示、应用条件、移除其他效果、附加效果以及未知的（包括项目自定义的）组件都退回常规路径
+ */
+static bool AreAllComponentsSafeForFastInit(const UGameplayEffect* InEffect)
+{
+	// 组件是效果的实例化子对象，遍历效果的直接子对象即可，不访问效果内部的组件数组
+	bool bAllComponentsSafe = true;
+	ForEachObjectWithOuterBreakable(InEffect, [&bAllComponentsSafe](UObject* InSubObject)
+		{
+			// 精确匹配类 --> 白名单组件的子类可能重写应用逻辑
+			if (InSubObject->IsA<UGameplayEffectComponent>() && InSubObject->GetClass() != UAssetTagsGameplayEffectComponent::StaticClass())
+			{
+				bAllComponentsSafe = false;
+				return false;
+			}
+
+			return true;
+		}, false, RF_NoFlags, EInternalObjectFlags::Garbage);
+
+	return bAllComponentsSafe;
+}
 
 
 void UDataAsset_StartUpDataBase::GiveToAbilitySystemComponent(UFightAbilitySystemComponent* InASCToGive, int32 ApplyLevel)
 {
 	check(InASCToGive);
 
-	GrantAbilities(ActivateOnGivenAbilities, InASCToGive, ApplyLevel);
-	GrantAbilities(ReactiveAbilities, InASCToGive, ApplyLevel);
+	const FFightStartUpGrantBundle* GrantBundle = GrantBundleCache.Find(ApplyLevel);
+	if (!GrantBundle)
+	{
+		FFightStartUpGrantBundle& NewGrantBundle = GrantBundleCache.Add(ApplyLevel);
+		BuildGrantBundle(NewGrantBundle, ApplyLevel);
+		GrantBundle = &NewGrantBundle;
+	}
+
+	AActor* AvatarActor = InASCToGive->GetAvatarActor();
+
+	for (const FGameplayAbilitySpec& SpecTemplate : GrantBundle->AbilitySpecTemplates)
+	{
+		FGameplayAbilitySpec AbilitySpec = SpecTemplate;
+		// 模板中的句柄被所有实例共享，每次授予都需要生成新的句柄
+		AbilitySpec.Handle.GenerateNewHandle();
+		// 设置能力规范的源对象为能力系统组件的AvatarActor
+		AbilitySpec.SourceObject = AvatarActor;
+
+		// 将能力规范授予给能力系统组件 --> GiveAbility会将能力添加到能力系统组件中，使其可以被激活和使用
+		InASCToGive->GiveAbility(AbilitySpec);
+	}
+
+	// 初始化期间屏蔽属性集的UI通知 --> 角色尚未显示，中间值的广播没有意义
+	UBasicAttributeSet* BasicAttributeSet = nullptr;
+	for (UAttributeSet* SpawnedAttributeSet : InASCToGive->GetSpawnedAttributes())
+	{
+		if ((BasicAttributeSet = Cast<UBasicAttributeSet>(SpawnedAttributeSet)) != nullptr)
+		{
+			BasicAttributeSet->SetSuppressUINotifications(true);
+			break;
+		}
+	}
+
+	// 快速路径的写入按配置顺序穿插在常规效果之间 --> 结果与逐个应用启动效果一致
+	const TArray<FFightStartUpGrantBundle::FAttributeBaseValueWrite>& BaseValueWrites = GrantBundle->AttributeBaseValueWrites;
+	int32 WriteIndex = 0;
 
-	if (!StartUpGameplayEffects.IsEmpty())
+	for (int32 SpecIndex = 0; SpecIndex <= GrantBundle->EffectSpecTemplates.Num(); ++SpecIndex)
 	{
-		for (const TSubclassOf<UGameplayEffect>& EffectClass : StartUpGameplayEffects)
+		for (; WriteIndex < BaseValueWrites.Num() && BaseValueWrites[WriteIndex].NumEffectSpecsBefore <= SpecIndex; ++WriteIndex)
 		{
-			if (!EffectClass) continue;
+			ApplyAttributeBaseValueWrite(InASCToGive, BasicAttributeSet, BaseValueWrites[WriteIndex]);
+		}
 
-			// 创建一个GameplayEffectSpecHandle实例，使用指定的EffectClass和ApplyLevel
-			// MakeOutgoingSpec用于创建一个效果规范句柄，包含效果类、等级和效果上下文
-			FGameplayEffectSpecHandle EffectSpecHandle = InASCToGive->MakeOutgoingSpec(EffectClass, ApplyLevel, InASCToGive->MakeEffectContext());
-			if (EffectSpecHandle.IsValid())
-			{
-				// 应用效果规范到自身，而不是直接使用EffectCDO --> 这样可以确保所有属性都被正确初始化和处理
-				 if (EffectSpecHandle.Data.IsValid() && EffectSpecHandle.Data.Get())
-				 {
-				 	InASCToGive->ApplyGameplayEffectSpecToSelf(*EffectSpecHandle.Data.Get());
-				 }
-
-#pragma region Deprecated implementation
-			   /* 以下为原始实现方式（已废弃）
-				* // 通过 EffectClass（一个 UGameplayEffect 的子类类型），获取该类的默认对象 --> 即该效果的模板实例
-				* UGameplayEffect* EffectCDO = EffectClass->GetDefaultObject<UGameplayEffect>();
-				* if (EffectCDO)
-				* {
-				* 	// 调用能力系统组件的 ApplyGameplayEffectToSelf 方法
-				* 	// 将上一步获取到的 GameplayEffect 默认对象以 ApplyLevel 等级和指定的效果上下文（EffectContext）应用到自己身上
-				* 	InASCToGive->ApplyGameplayEffectToSelf(
-				* 		EffectCDO,
-				* 		ApplyLevel,
-				* 		InASCToGive->MakeEffectContext()
-				* 	);
-				* }
-				*/
-#pragma endregion
-			}
+		if (!GrantBundle->EffectSpecTemplates.IsValidIndex(SpecIndex))
+		{
+			break;
 		}
+
+		// 应用效果规范到自身，而不是直接使用EffectCDO --> 这样可以确保所有属性都被正确初始化和处理
+		FGameplayEffectSpec EffectSpec = GrantBundle->EffectSpecTemplates[SpecIndex];
+		EffectSpec.SetContext(InASCToGive->MakeEffectContext());
+		EffectSpec.CaptureDataFromSource();
+
+		InASCToGive->ApplyGameplayEffectSpecToSelf(EffectSpec);
+	}
+
+	if (BasicAttributeSet)
+	{
+		BasicAttributeSet->SetSuppressUINotifications(false);
+		BasicAttributeSet->BroadcastAttributesToUI(AvatarActor);
+	}
+}
+
+void UDataAsset_StartUpDataBase::SetUseFastAttributeInit(bool bInUseFastAttributeInit)
+{
+	if (bUseFastAttributeInit != bInUseFastAttributeInit)
+	{
+		bUseFastAttributeInit = bInUseFastAttributeInit;
+
+		// 已构建的授予包按旧的路径划分，需要重新构建
+		GrantBundleCache.Empty();
 	}
 }
 
-void UDataAsset_StartUpDataBase::GrantAbilities(const TArray<TSubclassOf<UFightGameplayAbility>>& InAbilitiesToGive,
-	UFightAbilitySystemComponent* InASCToGive, int32 ApplyLevel)
+#if WITH_EDITOR
+void UDataAsset_StartUpDataBase::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+
+	// 配置改动后丢弃已构建的授予包
+	GrantBundleCache.Empty();
+}
+#endif
+
+void UDataAsset_StartUpDataBase::BuildGrantBundle(FFightStartUpGrantBundle& OutBundle, int32 ApplyLevel) const
 {
-	if (InAbilitiesToGive.IsEmpty())
+	AddAbilitySpecTemplates(ActivateOnGivenAbilities, OutBundle, ApplyLevel);
+	AddAbilitySpecTemplates(ReactiveAbilities, OutBundle, ApplyLevel);
+
+	for (const TSubclassOf<UGameplayEffect>& EffectClass : StartUpGameplayEffects)
 	{
-		return;
+		if (!EffectClass) continue;
+
+		if (bUseFastAttributeInit && TryAddAttributeBaseValueWrites(EffectClass->GetDefaultObject<UGameplayEffect>(), OutBundle, ApplyLevel))
+		{
+			continue;
+		}
+
+		// 上下文在授予时才设置，模板中只保存效果定义与等级
+		OutBundle.EffectSpecTemplates.Emplace(EffectClass->GetDefaultObject<UGameplayEffect>(), FGameplayEffectContextHandle(), ApplyLevel);
 	}
+}
 
-	// 遍历要授予的能力数组
+void UDataAsset_StartUpDataBase::AddAbilitySpecTemplates(const TArray<TSubclassOf<UFightGameplayAbility>>& InAbilitiesToGive,
+	FFightStartUpGrantBundle& OutBundle, int32 ApplyLevel)
+{
 	for (const TSubclassOf<UFightGameplayAbility>& Ability : InAbilitiesToGive)
 	{
 		if (!Ability)
@@ -67,14 +152,65 @@ void UDataAsset_StartUpDataBase::GrantAbilities(const TArray<TSubclassOf<UFightG
 			continue;
 		}
 
-		// 创建能力规范，使用能力类作为参数
-		FGameplayAbilitySpec AbilitySpec(Ability);
-		// 设置能力规范的源对象为能力系统组件的AvatarActor
-		AbilitySpec.SourceObject = InASCToGive->GetAvatarActor();
-		// 设置能力规范的等级
-		AbilitySpec.Level = ApplyLevel;
+		OutBundle.AbilitySpecTemplates.Emplace(Ability, ApplyLevel);
+	}
+}
 
-		// 将能力规范授予给能力系统组件 --> GiveAbility会将能力添加到能力系统组件中，使其可以被激活和使用
-		InASCToGive->GiveAbility(AbilitySpec);
+bool UDataAsset_StartUpDataBase::TryAddAttributeBaseValueWrites(const UGameplayEffect* InEffect,
+	FFightStartUpGrantBundle& OutBundle, int32 ApplyLevel)
+{
+	// 只处理没有执行计算、没有提示、且所有组件都在白名单中的瞬时效果
+	if (!InEffect ||
+		InEffect->DurationPolicy != EGameplayEffectDurationType::Instant ||
+		!InEffect->Executions.IsEmpty() ||
+		!InEffect->GameplayCues.IsEmpty() ||
+		!AreAllComponentsSafeForFastInit(InEffect))
+	{
+		return false;
+	}
+
+	// 先完整检查并求值，任何一个修改器不满足条件都整体退回常规路径
+	TArray<FFightStartUpGrantBundle::FAttributeBaseValueWrite> BaseValueWrites;
+	BaseValueWrites.Reserve(InEffect->Modifiers.Num());
+
+	for (const FGameplayModifierInfo& Modifier : InEffect->Modifiers)
+	{
+		const bool bIsSupportedOp = Modifier.ModifierOp == EGameplayModOp::Override || Modifier.ModifierOp == EGameplayModOp::AddBase;
+
+		float Magnitude = 0.f;
+		if (!bIsSupportedOp ||
+			!Modifier.Attribute.IsValid() ||
+			!Modifier.SourceTags.IsEmpty() ||
+			!Modifier.TargetTags.IsEmpty() ||
+			Modifier.ModifierMagnitude.GetMagnitudeCalculationType() != EGameplayEffectMagnitudeCalculation::ScalableFloat ||
+			!Modifier.ModifierMagnitude.GetStaticMagnitudeIfPossible(ApplyLevel, Magnitude))
+		{
+			return false;
+		}
+
+		FFightStartUpGrantBundle::FAttributeBaseValueWrite& BaseValueWrite = BaseValueWrites.AddDefaulted_GetRef();
+		BaseValueWrite.Attribute = Modifier.Attribute;
+		BaseValueWrite.bOverride = Modifier.ModifierOp == EGameplayModOp::Override;
+		BaseValueWrite.Magnitude = Magnitude;
+		BaseValueWrite.NumEffectSpecsBefore = OutBundle.EffectSpecTemplates.Num();
+	}
+
+	OutBundle.AttributeBaseValueWrites.Append(BaseValueWrites);
+
+	return true;
+}
+
+void UDataAsset_StartUpDataBase::ApplyAttributeBaseValueWrite(UFightAbilitySystemComponent* InASC, UBasicAttributeSet* InBasicAttributeSet,
+	const FFightStartUpGrantBundle::FAttributeBaseValueWrite& InBaseValueWrite)
+{
+	const float NewBaseValue = InBaseValueWrite.bOverride ? InBaseValueWrite.Magnitude :
+		InASC->GetNumericAttributeBase(InBaseValueWrite.Attribute) + InBaseValueWrite.Magnitude;
+
+	InASC->SetNumericAttributeBase(InBaseValueWrite.Attribute, NewBaseValue);
+
+	// 直接写入不经过PostGameplayEffectExecute，由属性集补上同样的钳制
+	if (InBasicAttributeSet)
+	{
+		InBasicAttributeSet->ClampAttributeAfterBaseValueWrite(InBaseValueWrite.Attribute);
 	}
 }
@@ -9,9 +9,9 @@
 #include "Kismet/KismetMathLibrary.h"
 #include "GAS/FightGameplayTags.h"
 #include "FightTypes/FightCountDownAction.h"
+#include "Game/FightTimerSubsystem.h"
 #include "FightGameInstance.h"
-#include "Kismet/GameplayStatics.h"
-#include "SaveGame/FightSaveGame.h"
+#include "SaveGame/FightSaveGameSubsystem.h"
 
 #include "GASDebugHelper.h"
 
@@ -190,8 +190,15 @@ void UFightFunctionLibrary::CountDown(
 		// 如果不存在相同标识符的Action，则创建新的倒计时Action
 		if (!FoundAction)
 		{
+			// 实际计时交给世界内共享的时间轮
+			UFightTimerSubsystem* TimerSubsystem = World->GetSubsystem<UFightTimerSubsystem>();
+			if (!TimerSubsystem)
+			{
+				return;
+			}
+
 			LatentActionManager.AddNewAction(LatentInfo.CallbackTarget, LatentInfo.UUID,
-				new FFightCountDownAction(TotalTime, UpdateInterval, OutRemainingTime, CountDownOutput, LatentInfo));
+				new FFightCountDownAction(TimerSubsystem, TotalTime, UpdateInterval, OutRemainingTime, CountDownOutput, LatentInfo));
 		}
 		// Note：如果已经存在相同标识符的Action，忽略这次调用（防止重复启动）
 	}
@@ -249,33 +256,30 @@ void UFightFunctionLibrary::ToggleInputMode(const UObject* WorldContextObject, E
 	}
 }
 
-void UFightFunctionLibrary::SaveCurrentGameDifficulty(EFightGameDifficulty InDifficultyToSave)
+void UFightFunctionLibrary::SaveGameDifficulty(const UObject* WorldContextObject, EFightGameDifficulty InDifficultyToSave)
 {
-	USaveGame* SaveGameObject = UGameplayStatics::CreateSaveGameObject(UFightSaveGame::StaticClass());
-
-	if (UFightSaveGame* FightSaveGameObject = Cast<UFightSaveGame>(SaveGameObject))
+	if (UFightGameInstance* FightGameInstance = GetFightGameInstance(WorldContextObject))
 	{
-		FightSaveGameObject->SavedCurrentGameDifficulty = InDifficultyToSave;
-
-		const bool bWasSaved = UGameplayStatics::SaveGameToSlot(
-			FightSaveGameObject, FightGameplayTags::GameData_SaveGame_Slot_1.GetTag().ToString(), 0);
+		FightGameInstance->GetSubsystem<UFightSaveGameSubsystem>()->SetSavedGameDifficulty(InDifficultyToSave);
 	}
 }
 
-bool UFightFunctionLibrary::TryLoadSavedGameDifficulty(EFightGameDifficulty& OutSavedDifficulty)
+bool UFightFunctionLibrary::TryGetSavedGameDifficulty(const UObject* WorldContextObject, EFightGameDifficulty& OutSavedDifficulty)
 {
-	if (UGameplayStatics::DoesSaveGameExist(FightGameplayTags::GameData_SaveGame_Slot_1.GetTag().ToString(), 0))
+	if (UFightGameInstance* FightGameInstance = GetFightGameInstance(WorldContextObject))
 	{
-		USaveGame* SaveGameObject = UGameplayStatics::LoadGameFromSlot(
-			FightGameplayTags::GameData_SaveGame_Slot_1.GetTag().ToString(), 0);
-
-		if (UFightSaveGame* FightSaveGameObject = Cast<UFightSaveGame>(SaveGameObject))
-		{
-			OutSavedDifficulty = FightSaveGameObject->SavedCurrentGameDifficulty;
-
-			return true;
-		}
+		return FightGameInstance->GetSubsystem<UFightSaveGameSubsystem>()->TryGetSavedGameDifficulty(OutSavedDifficulty);
 	}
 
 	return false;
 }
+
+void UFightFunctionLibrary::SaveCurrentGameDifficulty(EFightGameDifficulty InDifficultyToSave)
+{
+	SaveGameDifficulty(GEngine ? GEngine->GetCurrentPlayWorld() : nullptr, InDifficultyToSave);
+}
+
+bool UFightFunctionLibrary::TryLoadSavedGameDifficulty(EFightGameDifficulty& OutSavedDifficulty)
+{
+	return TryGetSavedGameDifficulty(GEngine ? GEngine->GetCurrentPlayWorld() : nullptr, OutSavedDifficulty);
+}
@@ -2,7 +2,11 @@
 
 
 #include "FightGameInstance.h"
+#include "GAS_Fight_Demo.h"
 #include "MoviePlayer.h"
+#include "Engine/AssetManager.h"
+#include "Kismet/GameplayStatics.h"
+#include "Engine/StreamableManager.h"
 
 
 bool FFightGameLevelSet::IsValid() const
@@ -16,13 +20,32 @@ void UFightGameInstance::Init()
 
 	FCoreUObjectDelegates::PreLoadMap.AddUObject(this, &ThisClass::OnPreLoadMap);
 	FCoreUObjectDelegates::PostLoadMapWithWorld.AddUObject(this, &ThisClass::OnDestinationWorldLoaded);
+
+	// GameLevelSets在运行时不会再变化，这里只构建一次映射
+	GameLevelMap.Reset();
+	for (int32 LevelSetIndex = 0; LevelSetIndex < GameLevelSets.Num(); ++LevelSetIndex)
+	{
+		if (GameLevelSets[LevelSetIndex].IsValid())
+		{
+			GameLevelMap.Add(GameLevelSets[LevelSetIndex].LevelTag, LevelSetIndex);
+		}
+	}
 }
 
 void UFightGameInstance::OnPreLoadMap(const FString& MapName)
 {
+	// 没有经过TravelToGameLevelByTag的切换（如蓝图直接OpenLevel）也从这里开始计时
+	if (TransitionStartTime < 0.0)
+	{
+		TransitionStartTime = FPlatformTime::Seconds();
+	}
+
+	const UObject* PreloadedWorld = PreloadedLevelHandle.IsValid() ? PreloadedLevelHandle->GetLoadedAsset() : nullptr;
+	const bool bIsPreloadedLevel = PreloadedWorld && PreloadedWorld->GetOutermost()->GetName() == MapName;
+
 	FLoadingScreenAttributes LoadingScreenAttributes;
 	LoadingScreenAttributes.bAutoCompleteWhenLoadingCompletes = true;
-	LoadingScreenAttributes.MinimumLoadingScreenDisplayTime = .5f;
+	LoadingScreenAttributes.MinimumLoadingScreenDisplayTime = bIsPreloadedLevel ? 0.f : MinimumLoadingScreenDisplayTime;
 	LoadingScreenAttributes.WidgetLoadingScreen = FLoadingScreenAttributes::NewTestLoadingScreenWidget();
 
 	GetMoviePlayer()->SetupLoadingScreen(LoadingScreenAttributes);
@@ -31,22 +54,120 @@ void UFightGameInstance::OnPreLoadMap(const FString& MapName)
 void UFightGameInstance::OnDestinationWorldLoaded(UWorld* LoadedWorld)
 {
 	GetMoviePlayer()->StopMovie();
+
+	// 切换已完成，新关卡已经持有这些资源，释放预加载的引用
+	PreloadingLevelTag = FGameplayTag();
+	ReleasePreloadHandles();
+
+	if (LoadedWorld && TransitionStartTime >= 0.0)
+	{
+		LoadedWorld->OnWorldBeginPlay.AddUObject(this, &ThisClass::OnDestinationWorldBeginPlay);
+	}
+}
+
+void UFightGameInstance::OnDestinationWorldBeginPlay()
+{
+	if (TransitionStartTime < 0.0)
+	{
+		return;
+	}
+
+	LastTransitionTimeToInteractive = static_cast<float>(FPlatformTime::Seconds() - TransitionStartTime);
+	TransitionStartTime = -1.0;
+
+	UE_LOG(LogFight, Log, TEXT("Level transition to %s became interactive in %.3f s"),
+		*GetWorld()->GetMapName(), LastTransitionTimeToInteractive);
 }
 
 TSoftObjectPtr<UWorld> UFightGameInstance::GetGameLevelByTag(FGameplayTag InTag) const
 {
-	for (const FFightGameLevelSet& GameLevelSet : GameLevelSets)
+	if (const FFightGameLevelSet* FoundLevelSet = FindGameLevelSet(InTag))
 	{
-		if (!GameLevelSet.IsValid())
-		{
-			continue;
-		}
+		return FoundLevelSet->Level;
+	}
+
+	return TSoftObjectPtr<UWorld>();
+}
+
+void UFightGameInstance::PreloadGameLevelByTag(FGameplayTag InTag)
+{
+	if (InTag == PreloadingLevelTag)
+	{
+		return;
+	}
+
+	const FFightGameLevelSet* FoundLevelSet = FindGameLevelSet(InTag);
+	if (!FoundLevelSet)
+	{
+		return;
+	}
+
+	// 只保留一个预加载目标
+	ReleasePreloadHandles();
+
+	PreloadingLevelTag = InTag;
+
+	// 句柄持有加载出的UWorld，关卡中的对象在切换前都不会被回收
+	PreloadedLevelHandle = UAssetManager::GetStreamableManager().RequestAsyncLoad(FoundLevelSet->Level.ToSoftObjectPath());
 
-		if (GameLevelSet.LevelTag == InTag)
+	TArray<FSoftObjectPath> ClassPathsToPreload;
+	for (const TSoftClassPtr<AActor>& ClassToPreload : FoundLevelSet->ClassesToPreload)
+	{
+		if (!ClassToPreload.IsNull())
 		{
-			return GameLevelSet.Level;
+			ClassPathsToPreload.Add(ClassToPreload.ToSoftObjectPath());
 		}
 	}
 
-	return TSoftObjectPtr<UWorld>();
+	if (!ClassPathsToPreload.IsEmpty())
+	{
+		PreloadedClassesHandle = UAssetManager::GetStreamableManager().RequestAsyncLoad(ClassPathsToPreload);
+	}
+}
+
+void UFightGameInstance::TravelToGameLevelByTag(FGameplayTag InTag)
+{
+	const TSoftObjectPtr<UWorld> LevelToTravel = GetGameLevelByTag(InTag);
+	if (LevelToTravel.IsNull())
+	{
+		return;
+	}
+
+	TransitionStartTime = FPlatformTime::Seconds();
+
+	// 关卡已在内存中时LoadMap会直接复用，不再从磁盘读取
+	UGameplayStatics::OpenLevelBySoftObjectPtr(this, LevelToTravel);
+}
+
+bool UFightGameInstance::IsGameLevelPreloaded(FGameplayTag InTag) const
+{
+	return InTag == PreloadingLevelTag && PreloadedLevelHandle.IsValid() && PreloadedLevelHandle->HasLoadCompleted();
+}
+
+void UFightGameInstance::ReleasePreloadHandles()
+{
+	if (PreloadedLevelHandle.IsValid())
+	{
+		PreloadedLevelHandle->ReleaseHandle();
+		PreloadedLevelHandle.Reset();
+	}
+
+	if (PreloadedClassesHandle.IsValid())
+	{
+		PreloadedClassesHandle->ReleaseHandle();
+		PreloadedClassesHandle.Reset();
+	}
+}
+
+const FFightGameLevelSet* UFightGameInstance::FindGameLevelSet(const FGameplayTag& InTag) const
+{
+	const int32* FoundLevelSetIndex = GameLevelMap.Find(InTag);
+	if (!FoundLevelSetIndex || !GameLevelSets.IsValidIndex(*FoundLevelSetIndex))
+	{
+		return nullptr;
+	}
+
+	// 数组在构建映射后被修改时下标可能已指向别的配置
+	const FFightGameLevelSet& FoundLevelSet = GameLevelSets[*FoundLevelSetIndex];
+	return FoundLevelSet.LevelTag == InTag ? &FoundLevelSet : nullptr;
 }
@@ -2,20 +2,46 @@
 
 
 #include "FightTypes/FightCountDownAction.h"
+#include "Game/FightTimerSubsystem.h"
 
-FFightCountDownAction::FFightCountDownAction(float InTotalCountDownTime, float InUpdateInterval, float& InOutRemainingTime, 
-	EFightCountDownActionOutput& CountDownOutput, const FLatentActionInfo& LatentInfo)
-	: bNeedToCancel(false)
+FFightCountDownAction::FFightCountDownAction(UFightTimerSubsystem* InTimerSubsystem, float InTotalCountDownTime,
+	float InUpdateInterval, float& InOutRemainingTime, EFightCountDownActionOutput& CountDownOutput,
+	const FLatentActionInfo& LatentInfo)
+	: TimerSubsystem(InTimerSubsystem)
+	, bNeedToCancel(false)
+	, bCompleted(false)
+	, bHasPendingUpdate(false)
 	, TotalCountDownTime(InTotalCountDownTime)
 	, UpdateInterval(InUpdateInterval)
+	, NumUpdatesFired(0)
 	, OutRemainingTime(InOutRemainingTime)
 	, CountDownOutput(CountDownOutput)
 	, ExecutionFunction(LatentInfo.ExecutionFunction)
 	, OutputLink(LatentInfo.Linkage)
 	, CallbackTarget(LatentInfo.CallbackTarget)
-	, ElapsedInterval(0.f)
-	, ElapsedTimeSinceStart(0.f)
-{}
+{
+	check(InTimerSubsystem);
+
+	// 动作由LatentActionManager持有，析构时会清除定时器，因此可以安全地绑定裸指针
+	CompleteTimerHandle = InTimerSubsystem->SetTimer(
+		FFightTimerDelegate::CreateRaw(this, &FFightCountDownAction::OnCompleteTimerFired), TotalCountDownTime);
+
+	// 更新间隔小于等于0时每帧更新一次，剩余时间直接从完成定时器读取
+	if (UpdateInterval > 0.f)
+	{
+		UpdateTimerHandle = InTimerSubsystem->SetTimer(
+			FFightTimerDelegate::CreateRaw(this, &FFightCountDownAction::OnUpdateTimerFired), UpdateInterval, UpdateInterval);
+	}
+}
+
+FFightCountDownAction::~FFightCountDownAction()
+{
+	if (UFightTimerSubsystem* Subsystem = TimerSubsystem.Get())
+	{
+		Subsystem->ClearTimer(UpdateTimerHandle);
+		Subsystem->ClearTimer(CompleteTimerHandle);
+	}
+}
 
 void FFightCountDownAction::UpdateOperation(FLatentResponse& Response)
 {
@@ -31,8 +57,11 @@ void FFightCountDownAction::UpdateOperation(FLatentResponse& Response)
 		return;
 	}
 
-	if (ElapsedTimeSinceStart >= TotalCountDownTime)
+	// 时间轮所在的世界已经销毁时同样视为完成
+	if (bCompleted || !TimerSubsystem.IsValid())
 	{
+		OutRemainingTime = 0.f;
+
 		// 设置输出状态为"已完成"
 		CountDownOutput = EFightCountDownActionOutput::Completed;
 
@@ -42,28 +71,22 @@ void FFightCountDownAction::UpdateOperation(FLatentResponse& Response)
 		return;
 	}
 
-	// 处理更新间隔逻辑 --> 检查当前间隔累计是否已达到设定的更新间隔
-	if (ElapsedInterval < UpdateInterval)
+	if (UpdateInterval <= 0.f)
 	{
-		// 如果还没到更新间隔，累积经过的时间 --> Response.ElapsedTime(): 获取自上一帧以来的时间增量
-		ElapsedInterval += Response.ElapsedTime();
+		OutRemainingTime = TimerSubsystem->GetTimerRemaining(CompleteTimerHandle);
+		bHasPendingUpdate = true;
 	}
-	else // 如果已达到或超过更新间隔，执行更新逻辑
-	{
-		// 更新已过总时间 --> 如果UpdateInterval > 0，使用固定间隔，否则使用实际经过的时间
-		ElapsedTimeSinceStart += UpdateInterval > 0.f ? UpdateInterval : Response.ElapsedTime();
 
-		// 计算并更新剩余时间
-		OutRemainingTime = TotalCountDownTime - ElapsedTimeSinceStart;
+	// 一帧内触发多次更新时只输出一次，剩余时间取最新值
+	if (bHasPendingUpdate)
+	{
+		bHasPendingUpdate = false;
 
 		// 设置输出状态为"已更新"
 		CountDownOutput = EFightCountDownActionOutput::Updated;
 
 		// 触发蓝图的更新链接（但不结束行动）--> 这意味着倒计时还会继续，直到完成或被取消
 		Response.TriggerLink(ExecutionFunction, OutputLink, CallbackTarget);
-
-		// 重置间隔计时器
-		ElapsedInterval = 0.f;
 	}
 }
 
@@ -71,3 +94,22 @@ void FFightCountDownAction::CancelAction()
 {
 	bNeedToCancel = true;
 }
+
+void FFightCountDownAction::OnUpdateTimerFired()
+{
+	NumUpdatesFired++;
+
+	// 按触发次数计算剩余时间，而不是累加帧时间
+	OutRemainingTime = FMath::Max(TotalCountDownTime - NumUpdatesFired * UpdateInterval, 0.f);
+	bHasPendingUpdate = true;
+}
+
+void FFightCountDownAction::OnCompleteTimerFired()
+{
+	bCompleted = true;
+
+	if (UFightTimerSubsystem* Subsystem = TimerSubsystem.Get())
+	{
+		Subsystem->ClearTimer(UpdateTimerHandle);
+	}
+}
@@ -0,0 +1,120 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "FightTypes/FightInputLog.h"
+#include "Misc/FileHelper.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+
+// 文件头魔数与版本，格式变化时递增版本
+static constexpr uint32 FightInputLogMagic = 0x46494C47; // 'FILG'
+static constexpr uint32 FightInputLogVersion = 1;
+
+// 单条事件最少占用的字节数（帧序号 + 类型），用于在分配前校验事件数量
+static constexpr int64 FightInputLogMinEventSize = sizeof(uint32) + sizeof(uint8);
+
+
+void FFightInputLog::AddEvent(uint32 InFrame, EFightInputLogEventType InType, const FVector2f& InValue, const FGameplayTag& InTag)
+{
+	FFightInputLogEvent& NewEvent = Events.AddDefaulted_GetRef();
+	NewEvent.Frame = InFrame;
+	NewEvent.Type = InType;
+	NewEvent.Value = InValue;
+
+	if (NewEvent.HasTag())
+	{
+		NewEvent.TagIndex = static_cast<uint16>(TagTable.AddUnique(InTag.GetTagName()));
+	}
+}
+
+FGameplayTag FFightInputLog::GetEventTag(const FFightInputLogEvent& InEvent) const
+{
+	if (!InEvent.HasTag() || !TagTable.IsValidIndex(InEvent.TagIndex))
+	{
+		return FGameplayTag();
+	}
+
+	return FGameplayTag::RequestGameplayTag(TagTable[InEvent.TagIndex], false);
+}
+
+bool FFightInputLog::SaveToFile(const FString& InFilePath) const
+{
+	TArray<uint8> Bytes;
+	FMemoryWriter Writer(Bytes);
+	Writer << const_cast<FFightInputLog&>(*this);
+
+	return FFileHelper::SaveArrayToFile(Bytes, *InFilePath);
+}
+
+bool FFightInputLog::LoadFromFile(const FString& InFilePath)
+{
+	TArray<uint8> Bytes;
+	if (!FFileHelper::LoadFileToArray(Bytes, *InFilePath))
+	{
+		return false;
+	}
+
+	FMemoryReader Reader(Bytes);
+	Reader << *this;
+
+	return !Reader.IsError();
+}
+
+FArchive& operator<<(FArchive& Ar, FFightInputLog& InOutLog)
+{
+	uint32 Magic = FightInputLogMagic;
+	uint32 Version = FightInputLogVersion;
+	Ar << Magic << Version;
+
+	if (Ar.IsLoading() && (Magic != FightInputLogMagic || Version != FightInputLogVersion))
+	{
+		Ar.SetError();
+		return Ar;
+	}
+
+	Ar << InOutLog.RandomSeed << InOutLog.FixedDeltaTime;
+	Ar << InOutLog.TagTable;
+
+	int32 NumEvents = InOutLog.Events.Num();
+	Ar << NumEvents;
+
+	if (Ar.IsLoading())
+	{
+		// 截断或损坏的文件 --> 事件数量不能超过剩余字节所能容纳的数量，避免负数或巨大的分配
+		const int64 RemainingBytes = Ar.TotalSize() - Ar.Tell();
+		if (Ar.IsError() || NumEvents < 0 || NumEvents > RemainingBytes / FightInputLogMinEventSize)
+		{
+			Ar.SetError();
+			return Ar;
+		}
+
+		InOutLog.Events.SetNum(NumEvents);
+	}
+
+	for (FFightInputLogEvent& Event : InOutLog.Events)
+	{
+		uint8 RawType = static_cast<uint8>(Event.Type);
+		Ar << Event.Frame << RawType;
+
+		if (RawType > static_cast<uint8>(EFightInputLogEventType::AbilityReleased))
+		{
+			Ar.SetError();
+			return Ar;
+		}
+
+		Event.Type = static_cast<EFightInputLogEventType>(RawType);
+
+		// 按类型只写入需要的字段
+		if (Event.HasValue())
+		{
+			Ar << Event.Value.X << Event.Value.Y;
+		}
+		if (Event.HasTag())
+		{
+			Ar << Event.TagIndex;
+		}
+	}
+
+	return Ar;
+}
@@ -0,0 +1,269 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "FightTypes/FightTimerWheel.h"
+
+
+FFightTimerWheel::FFightTimerWheel(double InTickSeconds)
+	: TickSeconds(InTickSeconds)
+{
+	check(TickSeconds > 0.0);
+
+	for (int32& SlotHead : SlotHeads)
+	{
+		SlotHead = INDEX_NONE;
+	}
+}
+
+FFightTimerHandle FFightTimerWheel::AddTimer(FFightTimerDelegate&& InDelegate, double InDelay, double InInterval)
+{
+	int32 EntryIndex;
+	if (!FreeEntryIndices.IsEmpty())
+	{
+		EntryIndex = FreeEntryIndices.Pop(EAllowShrinking::No);
+	}
+	else
+	{
+		EntryIndex = Entries.AddDefaulted();
+	}
+
+	FTimerEntry& Entry = Entries[EntryIndex];
+	Entry.Delegate = MoveTemp(InDelegate);
+	Entry.ExpireTime = CurrentTime + FMath::Max(InDelay, 0.0);
+	Entry.Interval = FMath::Max(InInterval, 0.0);
+	Entry.Serial = NextSerial++;
+	Entry.bActive = true;
+
+	LinkEntry(EntryIndex);
+	NumActiveTimers++;
+
+	FFightTimerHandle Handle;
+	Handle.Index = EntryIndex;
+	Handle.Serial = Entry.Serial;
+
+	return Handle;
+}
+
+void FFightTimerWheel::RemoveTimer(const FFightTimerHandle& InHandle)
+{
+	if (!FindEntry(InHandle))
+	{
+		return;
+	}
+
+	UnlinkEntry(InHandle.Index);
+	FreeEntry(InHandle.Index);
+}
+
+bool FFightTimerWheel::IsTimerActive(const FFightTimerHandle& InHandle) const
+{
+	return FindEntry(InHandle) != nullptr;
+}
+
+double FFightTimerWheel::GetTimeRemaining(const FFightTimerHandle& InHandle) const
+{
+	const FTimerEntry* Entry = FindEntry(InHandle);
+
+	return Entry ? FMath::Max(Entry->ExpireTime - CurrentTime, 0.0) : -1.0;
+}
+
+void FFightTimerWheel::Advance(double InDeltaSeconds)
+{
+	checkf(!bIsAdvancing, TEXT("FFightTimerWheel::Advance must not be called from a timer callback"));
+
+	if (InDeltaSeconds <= 0.0)
+	{
+		return;
+	}
+
+	TGuardValue<bool> AdvancingGuard(bIsAdvancing, true);
+
+	CurrentTime += InDeltaSeconds;
+
+	// 只推进已经完整经过的刻度，余数保留到下一次推进
+	const uint64 TargetTick = static_cast<uint64>(CurrentTime / TickSeconds);
+	while (CurrentTick < TargetTick)
+	{
+		ProcessNextTick();
+	}
+}
+
+void FFightTimerWheel::Reset()
+{
+	Entries.Empty();
+	FreeEntryIndices.Empty();
+	FiringEntries.Empty();
+
+	for (int32& SlotHead : SlotHeads)
+	{
+		SlotHead = INDEX_NONE;
+	}
+
+	CurrentTime = 0.0;
+	CurrentTick = 0;
+	NumActiveTimers = 0;
+}
+
+const FFightTimerWheel::FTimerEntry* FFightTimerWheel::FindEntry(const FFightTimerHandle& InHandle) const
+{
+	if (!Entries.IsValidIndex(InHandle.Index))
+	{
+		return nullptr;
+	}
+
+	const FTimerEntry& Entry = Entries[InHandle.Index];
+
+	return Entry.bActive && Entry.Serial == InHandle.Serial ? &Entry : nullptr;
+}
+
+void FFightTimerWheel::LinkEntry(int32 InEntryIndex)
+{
+	FTimerEntry& Entry = Entries[InEntryIndex];
+
+	// 向上取整到刻度 --> 保证不会提前触发，且已过期的定时器在下一个刻度触发
+	Entry.ExpireTick = FMath::Max(static_cast<uint64>(FMath::CeilToDouble(Entry.ExpireTime / TickSeconds)), CurrentTick + 1);
+
+	const uint64 DeltaTicks = Entry.ExpireTick - CurrentTick;
+
+	int32 Level = 0;
+	while (Level < NumLevels - 1 && DeltaTicks >= (uint64(1) << (SlotBits * (Level + 1))))
+	{
+		Level++;
+	}
+
+	// 超出最高层范围时挂到最高层最远的槽位，之后下沉时会重新计算
+	uint64 SlotTick = Entry.ExpireTick;
+	if (DeltaTicks >= (uint64(1) << (SlotBits * NumLevels)))
+	{
+		SlotTick = CurrentTick + ((uint64(NumSlots - 1)) << (SlotBits * Level));
+	}
+
+	const int32 SlotIndex = Level * NumSlots + static_cast<int32>((SlotTick >> (SlotBits * Level)) & SlotMask);
+
+	Entry.SlotIndex = SlotIndex;
+	Entry.Prev = INDEX_NONE;
+	Entry.Next = SlotHeads[SlotIndex];
+
+	if (Entry.Next != INDEX_NONE)
+	{
+		Entries[Entry.Next].Prev = InEntryIndex;
+	}
+
+	SlotHeads[SlotIndex] = InEntryIndex;
+}
+
+void FFightTimerWheel::UnlinkEntry(int32 InEntryIndex)
+{
+	FTimerEntry& Entry = Entries[InEntryIndex];
+	if (Entry.SlotIndex == INDEX_NONE)
+	{
+		return;
+	}
+
+	if (Entry.Prev != INDEX_NONE)
+	{
+		Entries[Entry.Prev].Next = Entry.Next;
+	}
+	else
+	{
+		SlotHeads[Entry.SlotIndex] = Entry.Next;
+	}
+
+	if (Entry.Next != INDEX_NONE)
+	{
+		Entries[Entry.Next].Prev = Entry.Prev;
+	}
+
+	Entry.Prev = INDEX_NONE;
+	Entry.Next = INDEX_NONE;
+	Entry.SlotIndex = INDEX_NONE;
+}
+
+void FFightTimerWheel::FreeEntry(int32 InEntryIndex)
+{
+	FTimerEntry& Entry = Entries[InEntryIndex];
+	Entry.Delegate.Unbind();
+	Entry.bActive = false;
+
+	FreeEntryIndices.Add(InEntryIndex);
+	NumActiveTimers--;
+}
+
+void FFightTimerWheel::CascadeSlot(int32 InLevel, int32 InSlot)
+{
+	const int32 SlotIndex = InLevel * NumSlots + InSlot;
+
+	int32 EntryIndex = SlotHeads[SlotIndex];
+	SlotHeads[SlotIndex] = INDEX_NONE;
+
+	while (EntryIndex != INDEX_NONE)
+	{
+		const int32 NextEntryIndex = Entries[EntryIndex].Next;
+
+		Entries[EntryIndex].SlotIndex = INDEX_NONE;
+		LinkEntry(EntryIndex);
+
+		EntryIndex = NextEntryIndex;
+	}
+}
+
+void FFightTimerWheel::ProcessNextTick()
+{
+	CurrentTick++;
+
+	// 从高层到低层下沉，保证下沉到低层的定时器在同一刻度内还能继续下沉
+	for (int32 Level = NumLevels - 1; Level > 0; --Level)
+	{
+		const uint64 LowerBitsMask = (uint64(1) << (SlotBits * Level)) - 1;
+		if ((CurrentTick & LowerBitsMask) == 0)
+		{
+			CascadeSlot(Level, static_cast<int32>((CurrentTick >> (SlotBits * Level)) & SlotMask));
+		}
+	}
+
+	const int32 SlotIndex = static_cast<int32>(CurrentTick & SlotMask);
+
+	// 先把整个槽位摘下再触发 --> 回调中新增的定时器至少排在下一个刻度，不会混入本次触发
+	FiringEntries.Reset();
+	for (int32 EntryIndex = SlotHeads[SlotIndex]; EntryIndex != INDEX_NONE; EntryIndex = Entries[EntryIndex].Next)
+	{
+		FiringEntries.Emplace(EntryIndex, Entries[EntryIndex].Serial);
+	}
+
+	for (const TPair<int32, uint32>& FiringEntry : FiringEntries)
+	{
+		FTimerEntry& Entry = Entries[FiringEntry.Key];
+		Entry.Prev = INDEX_NONE;
+		Entry.Next = INDEX_NONE;
+		Entry.SlotIndex = INDEX_NONE;
+	}
+	SlotHeads[SlotIndex] = INDEX_NONE;
+
+	for (const TPair<int32, uint32>& FiringEntry : FiringEntries)
+	{
+		const int32 EntryIndex = FiringEntry.Key;
+
+		// 被之前的回调删除或复用
+		if (!Entries[EntryIndex].bActive || Entries[EntryIndex].Serial != FiringEntry.Value)
+		{
+			continue;
+		}
+
+		// 先完成重新排期再执行回调，回调中可以安全地删除自身
+		FFightTimerDelegate DelegateToExecute;
+		if (Entries[EntryIndex].Interval > 0.0)
+		{
+			Entries[EntryIndex].ExpireTime += Entries[EntryIndex].Interval;
+			LinkEntry(EntryIndex);
+
+			DelegateToExecute = Entries[EntryIndex].Delegate;
+		}
+		else
+		{
+			DelegateToExecute = MoveTemp(Entries[EntryIndex].Delegate);
+			FreeEntry(EntryIndex);
+		}
+
+		DelegateToExecute.ExecuteIfBound();
+	}
+}
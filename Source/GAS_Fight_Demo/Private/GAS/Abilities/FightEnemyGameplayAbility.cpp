@@ -5,6 +5,9 @@
 #include "Characters/EnemyCharacter.h"
 #include "GAS/FightGameplayTags.h"
 #include "GAS/FightAbilitySystemComponent.h"
+#include "Game/FightBaseGameMode.h"
+#include "Controllers/FightAIController.h"
+#include "BehaviorTree/BlackboardComponent.h"
 
 
 AEnemyCharacter* UFightEnemyGameplayAbility::GetEnemyCharacterFromActorInfo()
@@ -46,3 +49,87 @@ FGameplayEffectSpecHandle UFightEnemyGameplayAbility::MakeEnemyDamageEffectSpecH
 
 	return EffectSpecHandle;
 }
+
+bool UFightEnemyGameplayAbility::CanActivateAbility(const FGameplayAbilitySpecHandle Handle,
+	const FGameplayAbilityActorInfo* ActorInfo, const FGameplayTagContainer* SourceTags,
+	const FGameplayTagContainer* TargetTags, FGameplayTagContainer* OptionalRelevantTags) const
+{
+	if (!Super::CanActivateAbility(Handle, ActorInfo, SourceTags, TargetTags, OptionalRelevantTags))
+	{
+		return false;
+	}
+
+	if (!bRequiresAttackToken || !ActorInfo)
+	{
+		return true;
+	}
+
+	const AFightBaseGameMode* BaseGameMode = ActorInfo->AvatarActor.IsValid() ?
+		ActorInfo->AvatarActor->GetWorld()->GetAuthGameMode<AFightBaseGameMode>() : nullptr;
+	const AActor* AttackTarget = GetAttackTargetFromActorInfo(ActorInfo);
+
+	// 没有游戏模式或没有目标时不做限制
+	if (!BaseGameMode || !AttackTarget)
+	{
+		return true;
+	}
+
+	return BaseGameMode->CanAcquireAttackToken(ActorInfo->AvatarActor.Get(), AttackTarget);
+}
+
+void UFightEnemyGameplayAbility::ActivateAbility(const FGameplayAbilitySpecHandle Handle,
+	const FGameplayAbilityActorInfo* ActorInfo, const FGameplayAbilityActivationInfo ActivationInfo,
+	const FGameplayEventData* TriggerEventData)
+{
+	bHoldsAttackToken = false;
+
+	if (bRequiresAttackToken && ActorInfo && ActorInfo->AvatarActor.IsValid())
+	{
+		AActor* AvatarActor = ActorInfo->AvatarActor.Get();
+		AActor* AttackTarget = GetAttackTargetFromActorInfo(ActorInfo);
+
+		if (AFightBaseGameMode* BaseGameMode = AvatarActor->GetWorld()->GetAuthGameMode<AFightBaseGameMode>())
+		{
+			if (AttackTarget)
+			{
+				// CanActivateAbility与此处之间令牌可能已被其它敌人占用，获取失败时直接取消
+				if (!BaseGameMode->TryAcquireAttackToken(AvatarActor, AttackTarget))
+				{
+					CancelAbility(Handle, ActorInfo, ActivationInfo, true);
+					return;
+				}
+
+				bHoldsAttackToken = true;
+			}
+		}
+	}
+
+	Super::ActivateAbility(Handle, ActorInfo, ActivationInfo, TriggerEventData);
+}
+
+void UFightEnemyGameplayAbility::EndAbility(const FGameplayAbilitySpecHandle Handle,
+	const FGameplayAbilityActorInfo* ActorInfo, const FGameplayAbilityActivationInfo ActivationInfo,
+	bool bReplicateEndAbility, bool bWasCancelled)
+{
+	if (bHoldsAttackToken && ActorInfo && ActorInfo->AvatarActor.IsValid())
+	{
+		if (AFightBaseGameMode* BaseGameMode = ActorInfo->AvatarActor->GetWorld()->GetAuthGameMode<AFightBaseGameMode>())
+		{
+			BaseGameMode->ReleaseAttackToken(ActorInfo->AvatarActor.Get());
+		}
+	}
+
+	bHoldsAttackToken = false;
+
+	Super::EndAbility(Handle, ActorInfo, ActivationInfo, bReplicateEndAbility, bWasCancelled);
+}
+
+AActor* UFightEnemyGameplayAbility::GetAttackTargetFromActorInfo(const FGameplayAbilityActorInfo* ActorInfo)
+{
+	const APawn* AvatarPawn = Cast<APawn>(ActorInfo->AvatarActor.Get());
+	const AAIController* AIController = AvatarPawn ? Cast<AAIController>(AvatarPawn->GetController()) : nullptr;
+	const UBlackboardComponent* BlackboardComponent = AIController ? AIController->GetBlackboardComponent() : nullptr;
+
+	return BlackboardComponent ?
+		Cast<AActor>(BlackboardComponent->GetValueAsObject(AFightAIController::TargetActorKeyName)) : nullptr;
+}
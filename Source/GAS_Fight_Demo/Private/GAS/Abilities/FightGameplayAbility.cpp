@@ -7,6 +7,7 @@
 #include "AbilitySystemBlueprintLibrary.h"
 #include "GAS/FightGameplayTags.h"
 #include "FightFunctionLibrary.h"
+#include "Game/FightEventBusSubsystem.h"
 
 
 void UFightGameplayAbility::OnGiveAbility(const FGameplayAbilityActorInfo* ActorInfo, const FGameplayAbilitySpec& Spec)
@@ -24,6 +25,21 @@ void UFightGameplayAbility::OnGiveAbility(const FGameplayAbilityActorInfo* Actor
 	}
 }
 
+bool UFightGameplayAbility::CanActivateAbility(const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo,
+	const FGameplayTagContainer* SourceTags, const FGameplayTagContainer* TargetTags, FGameplayTagContainer* OptionalRelevantTags) const
+{
+	if (ActorInfo)
+	{
+		const UFightAbilitySystemComponent* FightASC = Cast<UFightAbilitySystemComponent>(ActorInfo->AbilitySystemComponent.Get());
+		if (FightASC && FightASC->IsAbilitySpecDisabled(Handle))
+		{
+			return false;
+		}
+	}
+
+	return Super::CanActivateAbility(Handle, ActorInfo, SourceTags, TargetTags, OptionalRelevantTags);
+}
+
 void UFightGameplayAbility::EndAbility(const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo, 
 	const FGameplayAbilityActivationInfo ActivationInfo, bool bReplicateEndAbility, bool bWasCancelled)
 {
@@ -102,12 +118,8 @@ void UFightGameplayAbility::ApplyGameplayEffectSpecHandleToHitResults(
 
 				if (ActiveGameplayEffectHandle.WasSuccessfullyApplied())
 				{
-					FGameplayEventData Data;
-					Data.Instigator = OwningPawn;
-					Data.Target = HitPawn;
-
-					UAbilitySystemBlueprintLibrary::SendGameplayEventToActor(
-						HitPawn, FightGameplayTags::Shared_Event_HitReact, Data);
+					UFightEventBusSubsystem::SendFightEvent(HitPawn, FightGameplayTags::Shared_Event_HitReact,
+						OwningPawn, HitPawn);
 				}
 			}
 		}
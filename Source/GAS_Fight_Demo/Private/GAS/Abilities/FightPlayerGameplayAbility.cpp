@@ -79,15 +79,6 @@ bool UFightPlayerGameplayAbility::GetAbilityRemainingCooldownByTag(FGameplayTag
 {
 	check(InCooldownTag.IsValid());
 
-	FGameplayEffectQuery CooldownQuery = FGameplayEffectQuery::MakeQuery_MatchAnyOwningTags(InCooldownTag.GetSingleTagContainer());
-
-	TArray<TPair<float, float>> TimeRemainingAndDuration = GetAbilitySystemComponentFromActorInfo()->GetActiveEffectsTimeRemainingAndDuration(CooldownQuery);
-
-	if (!TimeRemainingAndDuration.IsEmpty())
-	{
-		RemainingCooldown = TimeRemainingAndDuration[0].Key;
-		TotalCooldown = TimeRemainingAndDuration[0].Value;
-	}
-
-	return RemainingCooldown > 0.f;
+	// 直接读取ASC的冷却登记表，不再构建查询并扫描所有活跃效果
+	return GetFightAbilitySystemComponentFromActorInfo()->GetCooldownRemainingByTag(InCooldownTag, TotalCooldown, RemainingCooldown);
 }
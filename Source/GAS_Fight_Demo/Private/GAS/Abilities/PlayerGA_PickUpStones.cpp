@@ -2,12 +2,18 @@
 
 
 #include "GAS/Abilities/PlayerGA_PickUpStones.h"
-#include "Kismet/KismetSystemLibrary.h"
 #include "Items/PickUps/FightStoneBase.h"
 #include "Characters/MainCharacter.h"
 #include "Components/UI/PlayerUIComponent.h"
+#include "GAS/FightGameplayTags.h"
 
 
+UPlayerGA_PickUpStones::UPlayerGA_PickUpStones()
+{
+	// 玩家与石头重叠时按该标签激活能力 --> 标签由原生类提供，不依赖蓝图子类的配置
+	SetAssetTags(FGameplayTagContainer(FightGameplayTags::Player_Ability_PickUp_Stones));
+}
+
 void UPlayerGA_PickUpStones::ActivateAbility(const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo, 
 	const FGameplayAbilityActivationInfo ActivationInfo, const FGameplayEventData* TriggerEventData)
 {
@@ -21,39 +27,15 @@ void UPlayerGA_PickUpStones::EndAbility(const FGameplayAbilitySpecHandle Handle,
 {
 	GetPlayerUIComponentFromActorInfo()->OnStoneInteraction.Broadcast(false);
 
+	CollectedStones.Reset();
+
 	Super::EndAbility(Handle, ActorInfo, ActivationInfo, bReplicateEndAbility, bWasCancelled);
 }
 
 void UPlayerGA_PickUpStones::CollectStones()
 {
-	CollectedStones.Empty();
-
-	AMainCharacter* PlayerCharacter = GetPlayerCharacterFromActorInfo();
-	TArray<FHitResult> TraceHits;
-
-	// 执行盒体多重追踪（检测玩家脚下区域的石头）
-	UKismetSystemLibrary::BoxTraceMultiForObjects(
-		PlayerCharacter, // WorldContextObject - 世界上下文对象（玩家角色）
-		PlayerCharacter->GetActorLocation(), // 开始位置 - 玩家当前位置
-		PlayerCharacter->GetActorLocation() + -PlayerCharacter->GetActorUpVector() * BoxTraceDistance, // 结束位置 - 玩家位置向下延伸BoxTraceDistance距离
-		TraceBoxSize / 2.f, // 盒体半尺寸（BoxTrace需要半尺寸）
-		(-PlayerCharacter->GetActorUpVector()).ToOrientationRotator(), // 盒体旋转 - 使用向下的方向作为朝向
-		StoneTraceChannel, // 要检测的碰撞通道 - 在编辑器中配置
-		false, // 是否忽略自身
-		TArray<AActor*>(), // 要忽略的Actor列表
-		bDrawDebugShape ? EDrawDebugTrace::ForOneFrame : EDrawDebugTrace::None,
-		TraceHits, // 输出参数 - 存储所有命中结果
-		true // 是否忽略追踪方向 - 进行盒体扫描而非射线追踪
-	);
-
-	// 遍历所有命中结果，收集石头
-	for (const FHitResult& TraceHit : TraceHits)
-	{
-		if (AFightStoneBase* FoundStone = Cast<AFightStoneBase>(TraceHit.GetActor()))
-		{
-			CollectedStones.AddUnique(FoundStone);
-		}
-	}
+	// 重叠集合由石头的开始/结束重叠事件维护，不再向下做盒体追踪
+	GetPlayerCharacterFromActorInfo()->GetOverlappingStones(CollectedStones);
 
 	// 如果没有收集到任何石头，取消能力
 	if (CollectedStones.IsEmpty())
@@ -64,17 +46,14 @@ void UPlayerGA_PickUpStones::CollectStones()
 
 void UPlayerGA_PickUpStones::ConsumeStones()
 {
+	// 激活后玩家可能又走到了别的石头上或离开了原来的石头，以消耗时的重叠集合为准
+	GetPlayerCharacterFromActorInfo()->GetOverlappingStones(CollectedStones);
+
 	if (CollectedStones.IsEmpty())
 	{
 		CancelAbility(GetCurrentAbilitySpecHandle(), GetCurrentActorInfo(), GetCurrentActivationInfo(), true);
 		return;
 	}
 
-	for (AFightStoneBase* CollectedStone : CollectedStones)
-	{
-		if (CollectedStone)
-		{
-			CollectedStone->Consume(GetFightAbilitySystemComponentFromActorInfo(), GetAbilityLevel());
-		}
-	}
+	AFightStoneBase::ConsumeStones(CollectedStones, GetFightAbilitySystemComponentFromActorInfo(), GetAbilityLevel());
 }
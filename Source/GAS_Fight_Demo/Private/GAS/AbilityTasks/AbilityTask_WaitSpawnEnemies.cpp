@@ -6,6 +6,7 @@
 #include "Engine/AssetManager.h"
 #include "NavigationSystem.h"
 #include "Characters/EnemyCharacter.h"
+#include "Game/FightBaseGameMode.h"
 
 #include "GASDebugHelper.h"
 
@@ -88,12 +89,22 @@ void UAbilityTask_WaitSpawnEnemies::OnEnemyClassLoaded()
 	// 设置碰撞处理方式：如果碰撞，尝试调整位置但始终生成
 	SpawnParam.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
 
+	// 召唤在服务器上执行，由游戏模式取位置 --> 确定性模式下与波次生成共用同一条随机流
+	AFightBaseGameMode* BaseGameMode = World->GetAuthGameMode<AFightBaseGameMode>();
+
 	// 循环生成指定数量的敌人
 	for (int32 i = 0; i < CachedNumToSpawn; i++)
 	{
 		// 在导航系统中获取随机可达点
-		FVector RandomLocation;
-		UNavigationSystemV1::K2_GetRandomReachablePointInRadius(this, CachedSpawnOrigin, RandomLocation, CachedRandomSpawnRadius);
+		FVector RandomLocation = CachedSpawnOrigin;
+		if (BaseGameMode)
+		{
+			RandomLocation = BaseGameMode->GetRandomSpawnLocation(CachedSpawnOrigin, CachedRandomSpawnRadius);
+		}
+		else
+		{
+			UNavigationSystemV1::K2_GetRandomReachablePointInRadius(this, CachedSpawnOrigin, RandomLocation, CachedRandomSpawnRadius);
+		}
 
 		// 增加垂直偏移 --> 避免敌人卡在地面下
 		RandomLocation += FVector(0.f, 0.f, 150.f);
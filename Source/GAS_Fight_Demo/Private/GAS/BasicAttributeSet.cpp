@@ -8,6 +8,7 @@
 #include "Interfaces/PawnUIInterface.h"
 #include "Components/UI/PawnUIComponent.h"
 #include "Components/UI/PlayerUIComponent.h"
+#include "Net/UnrealNetwork.h"
 
 #include "GASDebugHelper.h"
 
@@ -39,39 +40,24 @@ void UBasicAttributeSet::PostGameplayEffectExecute(const FGameplayEffectModCallb
 	if (Data.EvaluatedData.Attribute == GetCurrentHealthAttribute())
 	{
 		// 数值钳制
-		const float NewCurrentHealth = FMath::Clamp(GetCurrentHealth(), 0.f, GetMaxHealth());
-		// 设置修正后的生命值
-		SetCurrentHealth(NewCurrentHealth);
+		ClampAttributeAfterBaseValueWrite(Data.EvaluatedData.Attribute);
 
 		// 通知UI组件当前生命值变化
-		PawnUIComponent->OnCurrentHealthChanged.Broadcast(GetCurrentHealth() / GetMaxHealth());
+		if (!bSuppressUINotifications)
+		{
+			PawnUIComponent->OnCurrentHealthChanged.Broadcast(GetCurrentHealth() / GetMaxHealth());
+		}
 	}
 
 	// 检查被修改的属性是否为当前怒气值属性
 	if (Data.EvaluatedData.Attribute == GetCurrentRageAttribute())
 	{
-		const float NewCurrentRage = FMath::Clamp(GetCurrentRage(), 0.f, GetMaxRage());
-		SetCurrentRage(NewCurrentRage);
+		ClampAttributeAfterBaseValueWrite(Data.EvaluatedData.Attribute);
 
-		if (GetCurrentRage() == GetMaxRage())
-		{
-			UFightFunctionLibrary::AddGameplayTagToActorIfNone(
-				Data.Target.GetAvatarActor(), FightGameplayTags::Player_Status_Rage_Full);
-		}
-		else if (GetCurrentRage() == 0.f)
-		{
-			UFightFunctionLibrary::AddGameplayTagToActorIfNone(
-				Data.Target.GetAvatarActor(), FightGameplayTags::Player_Status_Rage_None);
-		}
-		else
-		{
-			UFightFunctionLibrary::RemoveGameplayTagFromActorIfFound(
-				Data.Target.GetAvatarActor(), FightGameplayTags::Player_Status_Rage_Full);
-			UFightFunctionLibrary::RemoveGameplayTagFromActorIfFound(
-				Data.Target.GetAvatarActor(), FightGameplayTags::Player_Status_Rage_None);
-		}
+		UpdateRageStatusTags(Data.Target.GetAvatarActor());
 
-		if (UPlayerUIComponent* PlayerUIComponent = CachedPawnUIInterface->GetPlayerUIComponent())
+		UPlayerUIComponent* PlayerUIComponent = CachedPawnUIInterface->GetPlayerUIComponent();
+		if (PlayerUIComponent && !bSuppressUINotifications)
 		{
 			PlayerUIComponent->OnCurrentRageChanged.Broadcast(GetCurrentRage() / GetMaxRage());
 		}
@@ -86,7 +72,10 @@ void UBasicAttributeSet::PostGameplayEffectExecute(const FGameplayEffectModCallb
 		SetCurrentHealth(NewCurrenHealth);
 
 		// 通知UI组件当前生命值变化
-		PawnUIComponent->OnCurrentHealthChanged.Broadcast(GetCurrentHealth() / GetMaxHealth());
+		if (!bSuppressUINotifications)
+		{
+			PawnUIComponent->OnCurrentHealthChanged.Broadcast(GetCurrentHealth() / GetMaxHealth());
+		}
 
 		// 检查角色是否死亡（生命值为0）
 		if (GetCurrentHealth() <= 0.f)
@@ -96,3 +85,107 @@ void UBasicAttributeSet::PostGameplayEffectExecute(const FGameplayEffectModCallb
 		}
 	}
 }
+
+void UBasicAttributeSet::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+	DOREPLIFETIME_CONDITION_NOTIFY(ThisClass, CurrentHealth, COND_None, REPNOTIFY_Always);
+	DOREPLIFETIME_CONDITION_NOTIFY(ThisClass, MaxHealth, COND_None, REPNOTIFY_Always);
+	DOREPLIFETIME_CONDITION_NOTIFY(ThisClass, CurrentRage, COND_None, REPNOTIFY_Always);
+	DOREPLIFETIME_CONDITION_NOTIFY(ThisClass, MaxRage, COND_None, REPNOTIFY_Always);
+	DOREPLIFETIME_CONDITION_NOTIFY(ThisClass, AttackPower, COND_None, REPNOTIFY_Always);
+	DOREPLIFETIME_CONDITION_NOTIFY(ThisClass, DefensePower, COND_None, REPNOTIFY_Always);
+}
+
+void UBasicAttributeSet::OnRep_CurrentHealth(const FGameplayAttributeData& OldCurrentHealth)
+{
+	GAMEPLAYATTRIBUTE_REPNOTIFY(UBasicAttributeSet, CurrentHealth, OldCurrentHealth);
+
+	BroadcastAttributesToUI(GetOwningActor());
+}
+
+void UBasicAttributeSet::OnRep_MaxHealth(const FGameplayAttributeData& OldMaxHealth)
+{
+	GAMEPLAYATTRIBUTE_REPNOTIFY(UBasicAttributeSet, MaxHealth, OldMaxHealth);
+
+	BroadcastAttributesToUI(GetOwningActor());
+}
+
+void UBasicAttributeSet::OnRep_CurrentRage(const FGameplayAttributeData& OldCurrentRage)
+{
+	GAMEPLAYATTRIBUTE_REPNOTIFY(UBasicAttributeSet, CurrentRage, OldCurrentRage);
+
+	BroadcastAttributesToUI(GetOwningActor());
+}
+
+void UBasicAttributeSet::OnRep_MaxRage(const FGameplayAttributeData& OldMaxRage)
+{
+	GAMEPLAYATTRIBUTE_REPNOTIFY(UBasicAttributeSet, MaxRage, OldMaxRage);
+
+	BroadcastAttributesToUI(GetOwningActor());
+}
+
+void UBasicAttributeSet::OnRep_AttackPower(const FGameplayAttributeData& OldAttackPower)
+{
+	GAMEPLAYATTRIBUTE_REPNOTIFY(UBasicAttributeSet, AttackPower, OldAttackPower);
+}
+
+void UBasicAttributeSet::OnRep_DefensePower(const FGameplayAttributeData& OldDefensePower)
+{
+	GAMEPLAYATTRIBUTE_REPNOTIFY(UBasicAttributeSet, DefensePower, OldDefensePower);
+}
+
+void UBasicAttributeSet::BroadcastAttributesToUI(AActor* InAvatarActor)
+{
+	if (!CachedPawnUIInterface.IsValid())
+	{
+		CachedPawnUIInterface = TWeakInterfacePtr<IPawnUIInterface>(InAvatarActor);
+	}
+
+	if (!CachedPawnUIInterface.IsValid())
+	{
+		return;
+	}
+
+	// 快速初始化直接写入基础值，不经过PostGameplayEffectExecute，这里补上怒气状态标签
+	if (UPlayerUIComponent* PlayerUIComponent = CachedPawnUIInterface->GetPlayerUIComponent())
+	{
+		UpdateRageStatusTags(InAvatarActor);
+		PlayerUIComponent->OnCurrentRageChanged.Broadcast(GetCurrentRage() / GetMaxRage());
+	}
+
+	if (UPawnUIComponent* PawnUIComponent = CachedPawnUIInterface->GetPawnUIComponent())
+	{
+		PawnUIComponent->OnCurrentHealthChanged.Broadcast(GetCurrentHealth() / GetMaxHealth());
+	}
+}
+
+void UBasicAttributeSet::ClampAttributeAfterBaseValueWrite(const FGameplayAttribute& InAttribute)
+{
+	if (InAttribute == GetCurrentHealthAttribute())
+	{
+		SetCurrentHealth(FMath::Clamp(GetCurrentHealth(), 0.f, GetMaxHealth()));
+	}
+	else if (InAttribute == GetCurrentRageAttribute())
+	{
+		SetCurrentRage(FMath::Clamp(GetCurrentRage(), 0.f, GetMaxRage()));
+	}
+}
+
+void UBasicAttributeSet::UpdateRageStatusTags(AActor* InAvatarActor) const
+{
+	if (GetCurrentRage() == GetMaxRage())
+	{
+		UFightFunctionLibrary::AddGameplayTagToActorIfNone(InAvatarActor, FightGameplayTags::Player_Status_Rage_Full);
+	}
+	else if (GetCurrentRage() == 0.f)
+	{
+		UFightFunctionLibrary::AddGameplayTagToActorIfNone(InAvatarActor, FightGameplayTags::Player_Status_Rage_None);
+	}
+	else
+	{
+		UFightFunctionLibrary::RemoveGameplayTagFromActorIfFound(InAvatarActor, FightGameplayTags::Player_Status_Rage_Full);
+		UFightFunctionLibrary::RemoveGameplayTagFromActorIfFound(InAvatarActor, FightGameplayTags::Player_Status_Rage_None);
+	}
+}
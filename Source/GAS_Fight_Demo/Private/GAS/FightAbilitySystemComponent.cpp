@@ -4,6 +4,10 @@
 #include "GAS/FightAbilitySystemComponent.h"
 #include "GAS/FightGameplayTags.h"
 #include "GAS/Abilities/FightPlayerGameplayAbility.h"
+#include "Interfaces/PawnUIInterface.h"
+#include "Components/UI/PlayerUIComponent.h"
+#include "Net/UnrealNetwork.h"
+#include "Net/Core/PushModel/PushModel.h"
 
 
 void UFightAbilitySystemComponent::OnAbilityInputPressed(const FGameplayTag& InInputTag)
@@ -19,6 +23,9 @@ void UFightAbilitySystemComponent::OnAbilityInputPressed(const FGameplayTag& InI
 		// 检查能力规格的动态标签是否精确匹配输入标签，不匹配则继续下一个能力
 		if (!AbilitySpec.GetDynamicSpecSourceTags().HasTagExact(InInputTag)) continue;
 
+		// 已卸下武器的能力仍保留在列表中，直接跳过
+		if (IsAbilitySpecDisabled(AbilitySpec.Handle)) continue;
+
 		// 如果是 切换类 的能力，并且当前已经激活，则取消该能力
 		if (InInputTag.MatchesTag(FightGameplayTags::InputTag_Toggleable) && AbilitySpec.IsActive())
 		{
@@ -71,6 +78,12 @@ void UFightAbilitySystemComponent::GrantPlayerWeaponAbilities(const TArray<FFigh
 			continue;
 		}
 
+		if (bKeepWeaponAbilitiesGranted)
+		{
+			OutGrantedAbilitySpecHandles.AddUnique(GrantOrEnableWeaponAbility(AbilitySet, ApplyLevel));
+			continue;
+		}
+
 		FGameplayAbilitySpec AbilitySpec(AbilitySet.AbilityToGrant);
 		// 设置能力的源对象为角色的Avatar Actor --> 源对象通常用于效果的上下文信息
 		AbilitySpec.SourceObject = GetAvatarActor();
@@ -91,11 +104,24 @@ void UFightAbilitySystemComponent::GrantPlayerWeaponAbilities(const TArray<FFigh
 			continue;
 		}
 
-		FGameplayAbilitySpec AbilitySpec(AbilitySet.AbilityToGrant);
-		AbilitySpec.SourceObject = GetAvatarActor();
-		AbilitySpec.Level = ApplyLevel;
-		AbilitySpec.GetDynamicSpecSourceTags().AddTag(AbilitySet.InputTag);
-		OutGrantedAbilitySpecHandles.AddUnique(GiveAbility(AbilitySpec));
+		if (bKeepWeaponAbilitiesGranted)
+		{
+			OutGrantedAbilitySpecHandles.AddUnique(GrantOrEnableWeaponAbility(AbilitySet, ApplyLevel));
+		}
+		else
+		{
+			FGameplayAbilitySpec AbilitySpec(AbilitySet.AbilityToGrant);
+			AbilitySpec.SourceObject = GetAvatarActor();
+			AbilitySpec.Level = ApplyLevel;
+			AbilitySpec.GetDynamicSpecSourceTags().AddTag(AbilitySet.InputTag);
+			OutGrantedAbilitySpecHandles.AddUnique(GiveAbility(AbilitySpec));
+		}
+
+		// 冷却开始时据此把冷却推送到对应的能力图标槽位
+		if (AbilitySet.AbilityCooldownTag.IsValid())
+		{
+			CooldownTagToInputTag.Add(AbilitySet.AbilityCooldownTag, AbilitySet.InputTag);
+		}
 	}
 }
 
@@ -109,7 +135,18 @@ void UFightAbilitySystemComponent::RemovedGrantedHeroWeaponAbilities(UPARAM(Ref)
 	// 遍历所有要移除的能力规格句柄
 	for (const FGameplayAbilitySpecHandle& SpecHandle : InSpecHandlesToRemove)
 	{
-		if (SpecHandle.IsValid())
+		if (!SpecHandle.IsValid())
+		{
+			continue;
+		}
+
+		// 保留授予模式：取消正在执行的实例并禁用规格，下次装备时直接重新启用
+		if (bKeepWeaponAbilitiesGranted)
+		{
+			CancelAbilityHandle(SpecHandle);
+			SetAbilitySpecDisabled(SpecHandle, true);
+		}
+		else
 		{
 			ClearAbility(SpecHandle);
 		}
@@ -119,25 +156,336 @@ void UFightAbilitySystemComponent::RemovedGrantedHeroWeaponAbilities(UPARAM(Ref)
 }
 
 bool UFightAbilitySystemComponent::TryActivateAbilityByTag(FGameplayTag AbilityTagToActivate)
+{
+	FGameplayAbilitySpecHandle ActivatedSpecHandle;
+	return NativeTryActivateAbilityByTag(AbilityTagToActivate, ActivatedSpecHandle);
+}
+
+bool UFightAbilitySystemComponent::NativeTryActivateAbilityByTag(const FGameplayTag& AbilityTagToActivate,
+	FGameplayAbilitySpecHandle& OutActivatedSpecHandle)
 {
 	check(AbilityTagToActivate.IsValid());
 
-	TArray<FGameplayAbilitySpec*> FoundAbilitySpecs;
-	GetActivatableGameplayAbilitySpecsByAllMatchingTags(AbilityTagToActivate.GetSingleTagContainer(), FoundAbilitySpecs);
+	const TArray<FFightCachedAbilitySpecRef>& CachedSpecs = GetCachedAbilitySpecsByTag(AbilityTagToActivate);
 
-	if (!FoundAbilitySpecs.IsEmpty())
+	// 第一次遍历：累加可选能力的权重 --> 与GetActivatableGameplayAbilitySpecsByAllMatchingTags一样只考虑满足标签需求的能力
+	float TotalWeight = 0.f;
+	for (const FFightCachedAbilitySpecRef& SpecRef : CachedSpecs)
 	{
-		const int32 RandomAbilityIndex = FMath::RandRange(0, FoundAbilitySpecs.Num() - 1);
-		FGameplayAbilitySpec* SpecToActivate = FoundAbilitySpecs[RandomAbilityIndex];
+		if (IsSpecSelectableByTag(ResolveCachedAbilitySpec(SpecRef), SpecRef))
+		{
+			TotalWeight += SpecRef.SelectionWeight;
+		}
+	}
 
-		check(SpecToActivate);
+	if (TotalWeight <= 0.f)
+	{
+		return false;
+	}
 
-		if (!SpecToActivate->IsActive())
+	// 第二次遍历：按权重定位被选中的能力
+	float RemainingWeight = AbilitySelectionRandomStream.FRandRange(0.f, TotalWeight);
+	FGameplayAbilitySpec* SpecToActivate = nullptr;
+	for (const FFightCachedAbilitySpecRef& SpecRef : CachedSpecs)
+	{
+		FGameplayAbilitySpec* AbilitySpec = ResolveCachedAbilitySpec(SpecRef);
+		if (!IsSpecSelectableByTag(AbilitySpec, SpecRef))
 		{
-			return TryActivateAbility(SpecToActivate->Handle);
+			continue;
 		}
 
+		SpecToActivate = AbilitySpec;
+		RemainingWeight -= SpecRef.SelectionWeight;
+		if (RemainingWeight < 0.f)
+		{
+			break;
+		}
+	}
+
+	check(SpecToActivate);
+
+	if (!SpecToActivate->IsActive() && TryActivateAbility(SpecToActivate->Handle))
+	{
+		OutActivatedSpecHandle = SpecToActivate->Handle;
+		return true;
+	}
+
+	return false;
+}
+
+bool UFightAbilitySystemComponent::HasActivatableAbilityByTag(const FGameplayTag& InAbilityTag)
+{
+	if (!InAbilityTag.IsValid())
+	{
+		return false;
+	}
+
+	for (const FFightCachedAbilitySpecRef& SpecRef : GetCachedAbilitySpecsByTag(InAbilityTag))
+	{
+		const FGameplayAbilitySpec* AbilitySpec = ResolveCachedAbilitySpec(SpecRef);
+
+		if (IsSpecSelectableByTag(AbilitySpec, SpecRef) && !AbilitySpec->IsActive() &&
+			AbilitySpec->Ability->CheckCooldown(AbilitySpec->Handle, AbilityActorInfo.Get()))
+		{
+			return true;
+		}
 	}
 
 	return false;
 }
+
+void UFightAbilitySystemComponent::SetAbilitySelectionSeed(int32 InSeed)
+{
+	AbilitySelectionRandomStream.Initialize(InSeed);
+}
+
+FGameplayAbilitySpecHandle UFightAbilitySystemComponent::GrantOrEnableWeaponAbility(const FFightPlayerAbilitySet& InAbilitySet,
+	int32 ApplyLevel)
+{
+	const TPair<UClass*, FGameplayTag> AbilityKey(InAbilitySet.AbilityToGrant.Get(), InAbilitySet.InputTag);
+
+	if (const FGameplayAbilitySpecHandle* FoundHandle = GrantedWeaponAbilitySpecs.Find(AbilityKey))
+	{
+		if (FGameplayAbilitySpec* FoundSpec = FindAbilitySpecFromHandle(*FoundHandle))
+		{
+			SetAbilitySpecDisabled(*FoundHandle, false);
+
+			// 只有等级变化时才需要标记为脏并复制
+			if (FoundSpec->Level != ApplyLevel)
+			{
+				FoundSpec->Level = ApplyLevel;
+				MarkAbilitySpecDirty(*FoundSpec);
+			}
+
+			return *FoundHandle;
+		}
+	}
+
+	FGameplayAbilitySpec AbilitySpec(InAbilitySet.AbilityToGrant);
+	AbilitySpec.SourceObject = GetAvatarActor();
+	AbilitySpec.Level = ApplyLevel;
+	AbilitySpec.GetDynamicSpecSourceTags().AddTag(InAbilitySet.InputTag);
+
+	const FGameplayAbilitySpecHandle GrantedHandle = GiveAbility(AbilitySpec);
+	GrantedWeaponAbilitySpecs.Add(AbilityKey, GrantedHandle);
+
+	return GrantedHandle;
+}
+
+bool UFightAbilitySystemComponent::GetCooldownRemainingByTag(const FGameplayTag& InCooldownTag,
+	float& OutTotalCooldown, float& OutRemainingCooldown) const
+{
+	const float WorldTime = GetWorld()->GetTimeSeconds();
+
+	// 登记表中只有当前生效的冷却，项数很少，直接遍历做层级匹配
+	bool bFoundCooldown = false;
+	for (const TPair<FGameplayTag, FFightCooldownEntry>& CooldownPair : ActiveCooldowns)
+	{
+		if (!CooldownPair.Key.MatchesTag(InCooldownTag))
+		{
+			continue;
+		}
+
+		const FFightCooldownEntry& CooldownEntry = CooldownPair.Value;
+		const float RemainingCooldown = FMath::Max(CooldownEntry.StartTime + CooldownEntry.Duration - WorldTime, 0.f);
+		if (!bFoundCooldown || RemainingCooldown > OutRemainingCooldown)
+		{
+			OutTotalCooldown = CooldownEntry.Duration;
+			OutRemainingCooldown = RemainingCooldown;
+			bFoundCooldown = true;
+		}
+	}
+
+	return bFoundCooldown && OutRemainingCooldown > 0.f;
+}
+
+void UFightAbilitySystemComponent::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+	// 只有拥有者客户端会预测激活武器能力；推送模式 --> 只在装备/卸下武器时标记
+	FDoRepLifetimeParams PushParams;
+	PushParams.bIsPushBased = true;
+	PushParams.Condition = COND_OwnerOnly;
+
+	DOREPLIFETIME_WITH_PARAMS_FAST(ThisClass, ReplicatedDisabledAbilitySpecHandles, PushParams);
+}
+
+void UFightAbilitySystemComponent::SetAbilitySpecDisabled(const FGameplayAbilitySpecHandle& InSpecHandle, bool bDisabled)
+{
+	bool bChanged;
+	if (bDisabled)
+	{
+		bool bAlreadyDisabled = false;
+		DisabledAbilitySpecHandles.Add(InSpecHandle, &bAlreadyDisabled);
+		bChanged = !bAlreadyDisabled;
+	}
+	else
+	{
+		bChanged = DisabledAbilitySpecHandles.Remove(InSpecHandle) > 0;
+	}
+
+	if (!bChanged || !IsOwnerActorAuthoritative())
+	{
+		return;
+	}
+
+	if (bDisabled)
+	{
+		ReplicatedDisabledAbilitySpecHandles.Add(InSpecHandle);
+	}
+	else
+	{
+		ReplicatedDisabledAbilitySpecHandles.RemoveSingleSwap(InSpecHandle, EAllowShrinking::No);
+	}
+
+	MARK_PROPERTY_DIRTY_FROM_NAME(ThisClass, ReplicatedDisabledAbilitySpecHandles, this);
+}
+
+void UFightAbilitySystemComponent::OnRep_DisabledAbilitySpecHandles()
+{
+	DisabledAbilitySpecHandles.Reset();
+	DisabledAbilitySpecHandles.Append(ReplicatedDisabledAbilitySpecHandles);
+}
+
+void UFightAbilitySystemComponent::BeginPlay()
+{
+	Super::BeginPlay();
+
+	OnActiveEffectAddedDelegateHandle = OnActiveGameplayEffectAddedDelegateToSelf.AddUObject(this, &ThisClass::OnActiveEffectAddedToSelf);
+	OnActiveEffectRemovedDelegateHandle = OnAnyGameplayEffectRemovedDelegate().AddUObject(this, &ThisClass::OnActiveEffectRemoved);
+}
+
+void UFightAbilitySystemComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	OnActiveGameplayEffectAddedDelegateToSelf.Remove(OnActiveEffectAddedDelegateHandle);
+	OnAnyGameplayEffectRemovedDelegate().Remove(OnActiveEffectRemovedDelegateHandle);
+
+	ActiveCooldowns.Empty();
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void UFightAbilitySystemComponent::OnActiveEffectAddedToSelf(UAbilitySystemComponent* InTargetASC,
+	const FGameplayEffectSpec& InSpec, FActiveGameplayEffectHandle InActiveHandle)
+{
+	// 冷却效果一定有持续时间，绝大多数效果在这里就被过滤掉
+	const float Duration = InSpec.GetDuration();
+	if (Duration <= 0.f || !InSpec.Def)
+	{
+		return;
+	}
+
+	// 包含效果定义授予的标签与运行时添加到规格上的动态标签
+	FGameplayTagContainer GrantedTags;
+	InSpec.GetAllGrantedTags(GrantedTags);
+
+	// 开始时间以活跃效果为准 --> 与引擎计算剩余时间的基准一致
+	const FActiveGameplayEffect* ActiveEffect = GetActiveGameplayEffect(InActiveHandle);
+	const float StartTime = ActiveEffect ? ActiveEffect->StartWorldTime : GetWorld()->GetTimeSeconds();
+
+	for (const FGameplayTag& GrantedTag : GrantedTags)
+	{
+		if (!GrantedTag.MatchesTag(FightGameplayTags::Player_Cooldown))
+		{
+			continue;
+		}
+
+		FFightCooldownEntry& CooldownEntry = ActiveCooldowns.FindOrAdd(GrantedTag);
+		CooldownEntry.EffectHandle = InActiveHandle;
+		CooldownEntry.StartTime = StartTime;
+		CooldownEntry.Duration = Duration;
+
+		// 冷却开始时只推送一次，UI自行倒计时，不再轮询剩余时间 --> 仍由蓝图广播时跳过，避免重复
+		const FGameplayTag* InputTag = CooldownTagToInputTag.Find(GrantedTag);
+		const IPawnUIInterface* PawnUIInterface = Cast<IPawnUIInterface>(GetAvatarActor());
+		if (InputTag && PawnUIInterface)
+		{
+			UPlayerUIComponent* PlayerUIComponent = PawnUIInterface->GetPlayerUIComponent();
+			if (PlayerUIComponent && PlayerUIComponent->bBroadcastCooldownBeginNatively)
+			{
+				PlayerUIComponent->OnAbilityCooldownBegin.Broadcast(*InputTag, Duration, Duration);
+			}
+		}
+	}
+}
+
+void UFightAbilitySystemComponent::OnActiveEffectRemoved(const FActiveGameplayEffect& InRemovedEffect)
+{
+	if (ActiveCooldowns.IsEmpty())
+	{
+		return;
+	}
+
+	for (auto It = ActiveCooldowns.CreateIterator(); It; ++It)
+	{
+		if (It->Value.EffectHandle == InRemovedEffect.Handle)
+		{
+			It.RemoveCurrent();
+		}
+	}
+}
+
+void UFightAbilitySystemComponent::OnGiveAbility(FGameplayAbilitySpec& AbilitySpec)
+{
+	AbilityTagToSpecsCache.Reset();
+
+	Super::OnGiveAbility(AbilitySpec);
+}
+
+void UFightAbilitySystemComponent::OnRemoveAbility(FGameplayAbilitySpec& AbilitySpec)
+{
+	AbilityTagToSpecsCache.Reset();
+	SetAbilitySpecDisabled(AbilitySpec.Handle, false);
+
+	Super::OnRemoveAbility(AbilitySpec);
+}
+
+const TArray<FFightCachedAbilitySpecRef>& UFightAbilitySystemComponent::GetCachedAbilitySpecsByTag(
+	const FGameplayTag& InAbilityTag)
+{
+	if (const TArray<FFightCachedAbilitySpecRef>* CachedSpecs = AbilityTagToSpecsCache.Find(InAbilityTag))
+	{
+		return *CachedSpecs;
+	}
+
+	TArray<FFightCachedAbilitySpecRef>& NewSpecs = AbilityTagToSpecsCache.Add(InAbilityTag);
+	for (int32 SpecIndex = 0; SpecIndex < ActivatableAbilities.Items.Num(); ++SpecIndex)
+	{
+		const FGameplayAbilitySpec& AbilitySpec = ActivatableAbilities.Items[SpecIndex];
+		if (!AbilitySpec.Ability || !AbilitySpec.Ability->GetAssetTags().HasTag(InAbilityTag))
+		{
+			continue;
+		}
+
+		FFightCachedAbilitySpecRef& SpecRef = NewSpecs.AddDefaulted_GetRef();
+		SpecRef.Handle = AbilitySpec.Handle;
+		SpecRef.SpecIndex = SpecIndex;
+
+		if (const UFightGameplayAbility* FightAbility = Cast<UFightGameplayAbility>(AbilitySpec.Ability))
+		{
+			SpecRef.SelectionWeight = FightAbility->GetActivationSelectionWeight();
+		}
+	}
+
+	return NewSpecs;
+}
+
+FGameplayAbilitySpec* UFightAbilitySystemComponent::ResolveCachedAbilitySpec(const FFightCachedAbilitySpecRef& InSpecRef)
+{
+	if (ActivatableAbilities.Items.IsValidIndex(InSpecRef.SpecIndex) &&
+		ActivatableAbilities.Items[InSpecRef.SpecIndex].Handle == InSpecRef.Handle)
+	{
+		return &ActivatableAbilities.Items[InSpecRef.SpecIndex];
+	}
+
+	return FindAbilitySpecFromHandle(InSpecRef.Handle);
+}
+
+bool UFightAbilitySystemComponent::IsSpecSelectableByTag(const FGameplayAbilitySpec* InAbilitySpec,
+	const FFightCachedAbilitySpecRef& InSpecRef) const
+{
+	return InAbilitySpec && InAbilitySpec->Ability && InSpecRef.SelectionWeight > 0.f &&
+		!IsAbilitySpecDisabled(InSpecRef.Handle) &&
+		InAbilitySpec->Ability->DoesAbilitySatisfyTagRequirements(*this);
+}
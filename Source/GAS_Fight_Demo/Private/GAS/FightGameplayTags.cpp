@@ -74,11 +74,13 @@ namespace FightGameplayTags
 	UE_DEFINE_GAMEPLAY_TAG(Player_Ability_Attack_Light_Spear, "Player.Ability.Attack.Light.Spear");
 	UE_DEFINE_GAMEPLAY_TAG(Player_Ability_Attack_Heavy_Spear, "Player.Ability.Attack.Heavy.Spear");
 
+	UE_DEFINE_GAMEPLAY_TAG(Player_Cooldown, "Player.Cooldown");
 	UE_DEFINE_GAMEPLAY_TAG(Player_Cooldown_SpecialWeaponAbility_Light, "Player.Cooldown.SpecialWeaponAbility.Light");
 	UE_DEFINE_GAMEPLAY_TAG(Player_Cooldown_SpecialWeaponAbility_Heavy, "Player.Cooldown.SpecialWeaponAbility.Heavy");
 
 	// 武器标签定义
 	// 用于标识玩家当前装备的武器类型，在动画和能力系统中使用
+	UE_DEFINE_GAMEPLAY_TAG(Player_Weapon, "Player.Weapon");
 	UE_DEFINE_GAMEPLAY_TAG(Player_Weapon_Axe, "Player.Weapon.Axe");
 	UE_DEFINE_GAMEPLAY_TAG(Player_Weapon_Spear, "Player.Weapon.Spear");
 
@@ -4,6 +4,9 @@
 #include "GAS/GE_ExecCalc/GE_ExecCalc_DamageTaken.h"
 #include "GAS/BasicAttributeSet.h"
 #include "GAS/FightGameplayTags.h"
+#include "Game/FightBaseGameMode.h"
+#include "Controllers/MainPlayerController.h"
+#include "AbilitySystemComponent.h"
 
 #include "GASDebugHelper.h"
 
@@ -144,7 +147,27 @@ void UGE_ExecCalc_DamageTaken::Execute_Implementation(const FGameplayEffectCusto
 	}
 
 	// 计算最终伤害值 --> 伤害公式：最终伤害 = 基础伤害 * 攻击方攻击力 / 防御方防御力
-	const float FinalDamageDone = BaseDamage * SourceAttackPower / TargetDefensePower;
+	float FinalDamageDone = BaseDamage * SourceAttackPower / TargetDefensePower;
+
+	// 按攻击方阵营应用难度伤害倍率 --> 倍率在游戏模式初始化时已解析缓存，这里只读取
+	const AActor* SourceAvatarActor = ExecutionParams.GetSourceAbilitySystemComponent() ?
+		ExecutionParams.GetSourceAbilitySystemComponent()->GetAvatarActor() : nullptr;
+	const UWorld* World = SourceAvatarActor ? SourceAvatarActor->GetWorld() : nullptr;
+
+	if (const AFightBaseGameMode* BaseGameMode = World ? World->GetAuthGameMode<AFightBaseGameMode>() : nullptr)
+	{
+		const APawn* SourcePawn = Cast<APawn>(SourceAvatarActor);
+		const FFightDifficultyPolicyEntry& DifficultyPolicyEntry = BaseGameMode->GetCurrentDifficultyPolicyEntry();
+
+		// 阵营按队伍ID判断，与AI敌对判定保持一致 --> 玩家队伍ID取自玩家控制器默认对象，没有队伍的来源按敌方处理
+		const IGenericTeamAgentInterface* SourceTeamAgent = SourcePawn ?
+			Cast<const IGenericTeamAgentInterface>(SourcePawn->GetController()) : nullptr;
+		const bool bIsSourceOnPlayerTeam = SourceTeamAgent &&
+			SourceTeamAgent->GetGenericTeamId() == GetDefault<AMainPlayerController>()->GetGenericTeamId();
+
+		FinalDamageDone *= bIsSourceOnPlayerTeam ?
+			DifficultyPolicyEntry.PlayerDamageMultiplier : DifficultyPolicyEntry.EnemyDamageMultiplier;
+	}
 
 	// 如果最终伤害值大于0，则将其作为修饰符添加到执行输出中 --> 只有正伤害才会被应用到目标角色
 	if (FinalDamageDone > 0.f)
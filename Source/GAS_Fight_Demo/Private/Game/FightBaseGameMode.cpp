@@ -2,6 +2,15 @@
 
 
 #include "Game/FightBaseGameMode.h"
+#include "GAS_Fight_Demo.h"
+#include "Kismet/GameplayStatics.h"
+#include "Misc/App.h"
+#include "Misc/Paths.h"
+#include "NavigationSystem.h"
+
+
+// 种子流的固定盐值 --> 派生种子与玩法随机流使用同一个种子时也互不相关
+static constexpr uint32 FightSeedStreamSalt = 0x46534544; // 'FSED'
 
 
 AFightBaseGameMode::AFightBaseGameMode()
@@ -9,3 +18,248 @@ AFightBaseGameMode::AFightBaseGameMode()
 	PrimaryActorTick.bCanEverTick = true;
 	PrimaryActorTick.bStartWithTickEnabled = true;
 }
+
+void AFightBaseGameMode::InitGame(const FString& MapName, const FString& Options, FString& ErrorMessage)
+{
+	Super::InitGame(MapName, Options, ErrorMessage);
+
+	ResolveDifficultyPolicy();
+	InitDeterministicMode(Options);
+}
+
+void AFightBaseGameMode::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	// 固定步长是进程级设置，编辑器中结束PIE后需要还原
+	if (bRestoreFixedTimeStep)
+	{
+		FApp::SetUseFixedTimeStep(false);
+		bRestoreFixedTimeStep = false;
+	}
+
+	if (bRestoreFixedDeltaTime)
+	{
+		FApp::SetFixedDeltaTime(PreviousFixedDeltaTime);
+		bRestoreFixedDeltaTime = false;
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void AFightBaseGameMode::InitDeterministicMode(const FString& InOptions)
+{
+	bDeterministicMode = UGameplayStatics::HasOption(InOptions, TEXT("Deterministic"));
+	bExitOnReplayEnd = UGameplayStatics::HasOption(InOptions, TEXT("ExitOnReplayEnd"));
+	DeterministicSeed = UGameplayStatics::GetIntOption(InOptions, TEXT("Seed"), 0);
+
+	const FString RecordName = UGameplayStatics::ParseOption(InOptions, TEXT("RecordInput"));
+	const FString ReplayName = UGameplayStatics::ParseOption(InOptions, TEXT("ReplayInput"));
+
+	if (!ReplayName.IsEmpty())
+	{
+		TSharedRef<FFightInputLog> LoadedLog = MakeShared<FFightInputLog>();
+		if (LoadedLog->LoadFromFile(GetInputLogFilePath(ReplayName)))
+		{
+			// 回放必须还原录制时的种子与步长
+			bDeterministicMode = true;
+			DeterministicSeed = LoadedLog->RandomSeed;
+			FixedSimulationHz = LoadedLog->FixedDeltaTime > 0.f ? 1.f / LoadedLog->FixedDeltaTime : FixedSimulationHz;
+			ReplayInputLog = LoadedLog;
+		}
+		else
+		{
+			UE_LOG(LogFight, Error, TEXT("Failed to load input replay %s"), *GetInputLogFilePath(ReplayName));
+		}
+	}
+	else if (!RecordName.IsEmpty())
+	{
+		// 录制只对确定性运行有意义
+		bDeterministicMode = true;
+		InputRecordFilePath = GetInputLogFilePath(RecordName);
+	}
+
+	if (!bDeterministicMode)
+	{
+		GameplayRandomStream.GenerateNewSeed();
+		SeedRandomStream.GenerateNewSeed();
+		return;
+	}
+
+	GameplayRandomStream.Initialize(DeterministicSeed);
+	SeedRandomStream.Initialize(HashCombine(GetTypeHash(DeterministicSeed), FightSeedStreamSalt));
+
+	// 固定步长 --> 插值（RInterpTo等）、重叠时机与计时器都只取决于帧序号，而不是真实帧时间
+	if (!FApp::UseFixedTimeStep())
+	{
+		FApp::SetUseFixedTimeStep(true);
+		bRestoreFixedTimeStep = true;
+	}
+
+	if (!bRestoreFixedDeltaTime)
+	{
+		PreviousFixedDeltaTime = FApp::GetFixedDeltaTime();
+		bRestoreFixedDeltaTime = true;
+	}
+	FApp::SetFixedDeltaTime(GetFixedSimulationDeltaTime());
+}
+
+FString AFightBaseGameMode::GetInputLogFilePath(const FString& InLogName)
+{
+	return FPaths::ProjectSavedDir() / TEXT("InputLogs") / InLogName + TEXT(".fightinput");
+}
+
+int32 AFightBaseGameMode::GenerateGameplaySeed()
+{
+	return SeedRandomStream.RandHelper(MAX_int32);
+}
+
+FVector AFightBaseGameMode::GetRandomSpawnLocation(const FVector& InOrigin, float InRadius)
+{
+	FVector RandomLocation = InOrigin;
+
+	if (!IsDeterministicMode())
+	{
+		UNavigationSystemV1::K2_GetRandomReachablePointInRadius(this, InOrigin, RandomLocation, InRadius);
+		return RandomLocation;
+	}
+
+	// 导航系统内部使用全局随机数，确定性模式下改为从玩法随机流取偏移再投影到导航网格
+	const float RandomAngle = GetGameplayRandomStream().FRandRange(0.f, UE_TWO_PI);
+	const FVector2D RandomOffset = FVector2D(FMath::Cos(RandomAngle), FMath::Sin(RandomAngle)) *
+		GetGameplayRandomStream().FRandRange(0.f, InRadius);
+
+	FNavLocation ProjectedLocation;
+	const UNavigationSystemV1* NavSystem = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld());
+
+	if (NavSystem && NavSystem->ProjectPointToNavigation(InOrigin + FVector(RandomOffset, 0.f), ProjectedLocation, FVector(InRadius)))
+	{
+		RandomLocation = ProjectedLocation.Location;
+	}
+
+	return RandomLocation;
+}
+
+void AFightBaseGameMode::NotifyInputReplayFinished()
+{
+	UE_LOG(LogFight, Log, TEXT("Input replay finished at %.3fs"), GetWorld()->GetTimeSeconds());
+
+	if (bExitOnReplayEnd)
+	{
+		FPlatformMisc::RequestExit(false);
+	}
+}
+
+void AFightBaseGameMode::SetCurrentGameDifficulty(EFightGameDifficulty InDifficulty)
+{
+	CurrentGameDifficulty = InDifficulty;
+
+	ResolveDifficultyPolicy();
+}
+
+void AFightBaseGameMode::ResolveDifficultyPolicy()
+{
+	if (!DifficultyPolicy || !DifficultyPolicy->FindDifficultyPolicyEntry(CurrentGameDifficulty, CachedDifficultyPolicyEntry))
+	{
+		CachedDifficultyPolicyEntry = UDataAsset_DifficultyPolicy::MakeDefaultDifficultyPolicyEntry(CurrentGameDifficulty);
+	}
+}
+
+bool AFightBaseGameMode::CanAcquireAttackToken(const AActor* InAttacker, const AActor* InTarget) const
+{
+	if (!InAttacker || !InTarget)
+	{
+		return false;
+	}
+
+	if (FindAttackTokenIndex(InAttacker) != INDEX_NONE)
+	{
+		return true;
+	}
+
+	return CountAttackTokensOnTarget(InTarget) < MaxAttackTokensPerTarget;
+}
+
+bool AFightBaseGameMode::TryAcquireAttackToken(AActor* InAttacker, AActor* InTarget)
+{
+	if (!InAttacker || !InTarget)
+	{
+		return false;
+	}
+
+	PruneAttackTokens();
+
+	const int32 ExistingIndex = FindAttackTokenIndex(InAttacker);
+	if (ExistingIndex != INDEX_NONE)
+	{
+		// 攻击者切换了目标时重新占用新目标的名额
+		if (ActiveAttackTokens[ExistingIndex].Target.Get() == InTarget)
+		{
+			ActiveAttackTokens[ExistingIndex].AcquiredTime = GetWorld()->GetTimeSeconds();
+			return true;
+		}
+
+		ActiveAttackTokens.RemoveAtSwap(ExistingIndex, 1, EAllowShrinking::No);
+	}
+
+	if (CountAttackTokensOnTarget(InTarget) >= MaxAttackTokensPerTarget)
+	{
+		return false;
+	}
+
+	FFightAttackToken& NewToken = ActiveAttackTokens.AddDefaulted_GetRef();
+	NewToken.Attacker = InAttacker;
+	NewToken.Target = InTarget;
+	NewToken.AcquiredTime = GetWorld()->GetTimeSeconds();
+
+	return true;
+}
+
+void AFightBaseGameMode::ReleaseAttackToken(const AActor* InAttacker)
+{
+	const int32 ExistingIndex = FindAttackTokenIndex(InAttacker);
+	if (ExistingIndex != INDEX_NONE)
+	{
+		ActiveAttackTokens.RemoveAtSwap(ExistingIndex, 1, EAllowShrinking::No);
+	}
+}
+
+void AFightBaseGameMode::PruneAttackTokens()
+{
+	const float CurrentTime = GetWorld()->GetTimeSeconds();
+
+	ActiveAttackTokens.RemoveAllSwap(
+		[this, CurrentTime](const FFightAttackToken& Token)
+		{
+			return !Token.Attacker.IsValid() || !Token.Target.IsValid() ||
+				CurrentTime - Token.AcquiredTime > AttackTokenTimeout;
+		},
+		EAllowShrinking::No
+	);
+}
+
+int32 AFightBaseGameMode::CountAttackTokensOnTarget(const AActor* InTarget) const
+{
+	const float CurrentTime = GetWorld()->GetTimeSeconds();
+
+	int32 TokenCount = 0;
+	for (const FFightAttackToken& Token : ActiveAttackTokens)
+	{
+		// 攻击者已失效或超时的令牌不占用名额
+		if (Token.Target.Get() == InTarget && Token.Attacker.IsValid() &&
+			CurrentTime - Token.AcquiredTime <= AttackTokenTimeout)
+		{
+			TokenCount++;
+		}
+	}
+
+	return TokenCount;
+}
+
+int32 AFightBaseGameMode::FindAttackTokenIndex(const AActor* InAttacker) const
+{
+	return ActiveAttackTokens.IndexOfByPredicate(
+		[InAttacker](const FFightAttackToken& Token)
+		{
+			return Token.Attacker.Get() == InAttacker;
+		}
+	);
+}
@@ -0,0 +1,292 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Game/FightEnemyCrowdManager.h"
+#include "Components/InstancedStaticMeshComponent.h"
+#include "Characters/EnemyCharacter.h"
+#include "Kismet/GameplayStatics.h"
+#include "NavigationSystem.h"
+#include "NavigationData.h"
+#include "AI/Navigation/NavigationTypes.h"
+
+
+AFightEnemyCrowdManager::AFightEnemyCrowdManager()
+{
+	PrimaryActorTick.bCanEverTick = true;
+	PrimaryActorTick.bStartWithTickEnabled = true;
+
+	RootComponent = CreateDefaultSubobject<USceneComponent>(TEXT("CrowdRoot"));
+
+	RandomStream.GenerateNewSeed();
+}
+
+bool AFightEnemyCrowdManager::AddLightweightEnemy(TSubclassOf<AEnemyCharacter> InEnemyClass, UStaticMesh* InProxyMesh,
+	const FVector& InLocation, float InYaw)
+{
+	if (!InEnemyClass || !InProxyMesh)
+	{
+		return false;
+	}
+
+	const int32 ArchetypeIndex = FindOrAddArchetype(InEnemyClass, InProxyMesh);
+	FFightCrowdArchetype& Archetype = Archetypes[ArchetypeIndex];
+
+	const FTransform InstanceTransform(FRotator(0.f, InYaw, 0.f), InLocation);
+
+	// 优先复用空闲实例，避免实例下标重排
+	int32 InstanceIndex;
+	if (!Archetype.FreeInstanceIndices.IsEmpty())
+	{
+		InstanceIndex = Archetype.FreeInstanceIndices.Pop(EAllowShrinking::No);
+		Archetype.InstanceTransforms[InstanceIndex] = InstanceTransform;
+	}
+	else
+	{
+		InstanceIndex = Archetype.InstancedMeshComponent->AddInstance(InstanceTransform, true);
+		Archetype.InstanceTransforms.Add(InstanceTransform);
+	}
+
+	// 随机动画相位，避免同屏实体动作完全同步
+	Archetype.InstancedMeshComponent->SetCustomDataValue(InstanceIndex, 0, RandomStream.FRand(), true);
+
+	EntityLocations.Add(InLocation);
+	EntityYaws.Add(InYaw);
+	EntityArchetypeIndices.Add(ArchetypeIndex);
+	EntityInstanceIndices.Add(InstanceIndex);
+
+	// 路径点为当前位置且立即需要寻路 --> 下一帧开始沿导航路径移动
+	EntityWaypoints.Add(InLocation);
+	EntityNextPathTimes.Add(0.f);
+	EntityStuckStartTimes.Add(-1.f);
+
+	return true;
+}
+
+int32 AFightEnemyCrowdManager::FindOrAddArchetype(TSubclassOf<AEnemyCharacter> InEnemyClass, UStaticMesh* InProxyMesh)
+{
+	for (int32 Index = 0; Index < Archetypes.Num(); ++Index)
+	{
+		if (Archetypes[Index].EnemyClass == InEnemyClass && Archetypes[Index].ProxyMesh == InProxyMesh)
+		{
+			return Index;
+		}
+	}
+
+	UInstancedStaticMeshComponent* InstancedMeshComponent = NewObject<UInstancedStaticMeshComponent>(this);
+	InstancedMeshComponent->SetStaticMesh(InProxyMesh);
+	InstancedMeshComponent->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	InstancedMeshComponent->SetCanEverAffectNavigation(false);
+	InstancedMeshComponent->NumCustomDataFloats = 1;
+	InstancedMeshComponent->SetupAttachment(RootComponent);
+	InstancedMeshComponent->RegisterComponent();
+
+	FFightCrowdArchetype& NewArchetype = Archetypes.AddDefaulted_GetRef();
+	NewArchetype.EnemyClass = InEnemyClass;
+	NewArchetype.ProxyMesh = InProxyMesh;
+	NewArchetype.InstancedMeshComponent = InstancedMeshComponent;
+
+	return Archetypes.Num() - 1;
+}
+
+void AFightEnemyCrowdManager::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	const APawn* PlayerPawn = UGameplayStatics::GetPlayerPawn(this, 0);
+	if (EntityLocations.IsEmpty() || !PlayerPawn)
+	{
+		return;
+	}
+
+	const float CurrentTime = GetWorld()->GetTimeSeconds();
+
+	// 先移除卡住的实体，之后的循环不再处理它们
+	DespawnStuckEntities(CurrentTime);
+
+	const FVector PlayerLocation = PlayerPawn->GetActorLocation();
+	const float PromotionRadiusSquared = FMath::Square(PromotionRadius);
+	const float MoveDistance = MoveSpeed * DeltaTime;
+
+	// 没有导航数据时无法寻路，退回直线朝玩家移动
+	const UNavigationSystemV1* NavSystem = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld());
+	const bool bUseNavigation = NavSystem && NavSystem->GetDefaultNavDataInstance(FNavigationSystem::DontCreate);
+
+	PendingPromotionIndices.Reset();
+	PendingPathIndices.Reset();
+
+	// 推进所有实体：沿导航路径点移动，路径点之间的线段位于导航网格上
+	for (int32 Index = 0; Index < EntityLocations.Num(); ++Index)
+	{
+		FVector& Location = EntityLocations[Index];
+
+		const float PlayerDeltaX = static_cast<float>(PlayerLocation.X - Location.X);
+		const float PlayerDeltaY = static_cast<float>(PlayerLocation.Y - Location.Y);
+
+		if (PlayerDeltaX * PlayerDeltaX + PlayerDeltaY * PlayerDeltaY <= PromotionRadiusSquared)
+		{
+			PendingPromotionIndices.Add(Index);
+			continue;
+		}
+
+		const FVector MoveTarget = bUseNavigation ? EntityWaypoints[Index] : PlayerLocation;
+		FVector ToMoveTarget = MoveTarget - Location;
+		if (!bUseNavigation)
+		{
+			// 直线移动时Z保持在生成时投影到导航网格上的高度
+			ToMoveTarget.Z = 0.f;
+		}
+
+		const float DistToMoveTarget = static_cast<float>(ToMoveTarget.Size());
+
+		// 到达路径点或到了重新寻路的时间，加入待寻路列表
+		if (bUseNavigation && (DistToMoveTarget <= MoveDistance || CurrentTime >= EntityNextPathTimes[Index]))
+		{
+			PendingPathIndices.Add(Index);
+		}
+
+		if (DistToMoveTarget <= UE_KINDA_SMALL_NUMBER)
+		{
+			continue;
+		}
+
+		Location += ToMoveTarget * (FMath::Min(MoveDistance, DistToMoveTarget) / DistToMoveTarget);
+		EntityYaws[Index] = FMath::RadiansToDegrees(FMath::Atan2(ToMoveTarget.Y, ToMoveTarget.X));
+
+		FFightCrowdArchetype& Archetype = Archetypes[EntityArchetypeIndices[Index]];
+		Archetype.InstanceTransforms[EntityInstanceIndices[Index]] =
+			FTransform(FRotator(0.f, EntityYaws[Index], 0.f), Location);
+	}
+
+	// 分摊寻路开销：超出预算的实体留到之后的帧，已寻路的实体推迟到下一个间隔，其余实体自然轮到
+	const int32 NumPathQueries = FMath::Min(PendingPathIndices.Num(), MaxPathQueriesPerFrame);
+	for (int32 PendingIndex = 0; PendingIndex < NumPathQueries; ++PendingIndex)
+	{
+		RefreshEntityWaypoint(PendingPathIndices[PendingIndex], PlayerLocation, CurrentTime);
+	}
+
+	// 倒序提升，交换删除不会影响尚未处理的下标
+	for (int32 PendingIndex = PendingPromotionIndices.Num() - 1; PendingIndex >= 0; --PendingIndex)
+	{
+		// 完整敌人已达上限时，实体停在交战范围边缘，等有名额后再提升
+		if (CanPromoteLightweightEnemy.IsBound() && !CanPromoteLightweightEnemy.Execute())
+		{
+			break;
+		}
+
+		TryPromoteEntity(PendingPromotionIndices[PendingIndex]);
+	}
+
+	// 每个原型只提交一次实例变换
+	for (FFightCrowdArchetype& Archetype : Archetypes)
+	{
+		if (!Archetype.InstanceTransforms.IsEmpty())
+		{
+			Archetype.InstancedMeshComponent->BatchUpdateInstancesTransforms(
+				0, Archetype.InstanceTransforms, true, true, true);
+		}
+	}
+}
+
+void AFightEnemyCrowdManager::RefreshEntityWaypoint(int32 InEntityIndex, const FVector& InPlayerLocation, float InCurrentTime)
+{
+	EntityNextPathTimes[InEntityIndex] = InCurrentTime + PathRefreshInterval;
+
+	UNavigationSystemV1* NavSystem = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld());
+	const ANavigationData* NavData = NavSystem ? NavSystem->GetDefaultNavDataInstance(FNavigationSystem::DontCreate) : nullptr;
+	if (!NavData)
+	{
+		return;
+	}
+
+	const FVector& Location = EntityLocations[InEntityIndex];
+
+	FPathFindingQuery Query(this, *NavData, Location, InPlayerLocation);
+	const FPathFindingResult Result = NavSystem->FindPathSync(Query);
+
+	// 寻路失败时原地等待，不穿墙直线移动
+	if (!Result.IsSuccessful() || !Result.Path.IsValid())
+	{
+		EntityWaypoints[InEntityIndex] = Location;
+		if (EntityStuckStartTimes[InEntityIndex] < 0.f)
+		{
+			EntityStuckStartTimes[InEntityIndex] = InCurrentTime;
+		}
+		return;
+	}
+
+	// 部分路径仍然沿着走，但终点到不了玩家身边，同样计入卡住时间
+	if (!Result.Path->IsPartial())
+	{
+		EntityStuckStartTimes[InEntityIndex] = -1.f;
+	}
+	else if (EntityStuckStartTimes[InEntityIndex] < 0.f)
+	{
+		EntityStuckStartTimes[InEntityIndex] = InCurrentTime;
+	}
+
+	// 路径的第一个点是起点，第二个点才是下一个需要前往的点
+	const TArray<FNavPathPoint>& PathPoints = Result.Path->GetPathPoints();
+	EntityWaypoints[InEntityIndex] = PathPoints.IsValidIndex(1) ? PathPoints[1].Location : Location;
+}
+
+bool AFightEnemyCrowdManager::TryPromoteEntity(int32 InEntityIndex)
+{
+	const FFightCrowdArchetype& Archetype = Archetypes[EntityArchetypeIndices[InEntityIndex]];
+
+	FActorSpawnParameters SpawnParam;
+	SpawnParam.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+
+	// 与波次生成保持一致，抬高一点避免卡进地面
+	const FVector SpawnLocation = EntityLocations[InEntityIndex] + FVector(0.0f, 0.0f, 150.0f);
+	const FRotator SpawnRotation(0.f, EntityYaws[InEntityIndex], 0.f);
+
+	AEnemyCharacter* PromotedEnemy = GetWorld()->SpawnActor<AEnemyCharacter>(
+		Archetype.EnemyClass, SpawnLocation, SpawnRotation, SpawnParam);
+
+	// 生成失败时保留实体，下一帧再尝试
+	if (!PromotedEnemy)
+	{
+		return false;
+	}
+
+	RemoveEntityAtSwap(InEntityIndex);
+
+	OnLightweightEnemyPromoted.Broadcast(PromotedEnemy);
+
+	return true;
+}
+
+void AFightEnemyCrowdManager::RemoveEntityAtSwap(int32 InEntityIndex)
+{
+	FFightCrowdArchetype& Archetype = Archetypes[EntityArchetypeIndices[InEntityIndex]];
+	const int32 InstanceIndex = EntityInstanceIndices[InEntityIndex];
+
+	// 隐藏并回收实例，而不是RemoveInstance，避免其它实体的实例下标被打乱
+	Archetype.InstanceTransforms[InstanceIndex].SetScale3D(FVector::ZeroVector);
+	Archetype.FreeInstanceIndices.Add(InstanceIndex);
+
+	EntityLocations.RemoveAtSwap(InEntityIndex, 1, EAllowShrinking::No);
+	EntityYaws.RemoveAtSwap(InEntityIndex, 1, EAllowShrinking::No);
+	EntityArchetypeIndices.RemoveAtSwap(InEntityIndex, 1, EAllowShrinking::No);
+	EntityInstanceIndices.RemoveAtSwap(InEntityIndex, 1, EAllowShrinking::No);
+	EntityWaypoints.RemoveAtSwap(InEntityIndex, 1, EAllowShrinking::No);
+	EntityNextPathTimes.RemoveAtSwap(InEntityIndex, 1, EAllowShrinking::No);
+	EntityStuckStartTimes.RemoveAtSwap(InEntityIndex, 1, EAllowShrinking::No);
+}
+
+void AFightEnemyCrowdManager::DespawnStuckEntities(float InCurrentTime)
+{
+	// 倒序遍历，交换删除不会影响尚未处理的下标
+	for (int32 Index = EntityStuckStartTimes.Num() - 1; Index >= 0; --Index)
+	{
+		const float StuckStartTime = EntityStuckStartTimes[Index];
+		if (StuckStartTime < 0.f || InCurrentTime - StuckStartTime < StuckDespawnTimeout)
+		{
+			continue;
+		}
+
+		RemoveEntityAtSwap(Index);
+
+		OnLightweightEnemyDespawned.Broadcast();
+	}
+}
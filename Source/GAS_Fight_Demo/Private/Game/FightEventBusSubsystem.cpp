@@ -0,0 +1,253 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Game/FightEventBusSubsystem.h"
+#include "AbilitySystemComponent.h"
+#include "AbilitySystemGlobals.h"
+#include "AbilitySystemInterface.h"
+#include "Engine/World.h"
+
+
+// 负载池的初始容量，覆盖常见的嵌套派发深度（命中 --> 受击反应 --> 状态事件）
+static constexpr int32 EventBusInitialPayloadPoolSize = 4;
+
+
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice GFightEventBusDumpCommand(
+	TEXT("Fight.EventBus.Dump"),
+	TEXT("输出当前世界战斗事件总线的按标签吞吐计数"),
+	FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateLambda(
+		[](const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+		{
+			if (const UFightEventBusSubsystem* EventBus = World ? World->GetSubsystem<UFightEventBusSubsystem>() : nullptr)
+			{
+				EventBus->DumpEventCounters(Ar);
+			}
+		}
+	)
+);
+
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice GFightEventBusResetCommand(
+	TEXT("Fight.EventBus.Reset"),
+	TEXT("清零当前世界战斗事件总线的吞吐计数"),
+	FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateLambda(
+		[](const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+		{
+			if (UFightEventBusSubsystem* EventBus = World ? World->GetSubsystem<UFightEventBusSubsystem>() : nullptr)
+			{
+				EventBus->ResetEventCounters();
+			}
+		}
+	)
+);
+
+
+void UFightEventBusSubsystem::Deinitialize()
+{
+	DeferredEvents.Empty();
+	FlushingEvents.Empty();
+	PayloadPool.Empty();
+	EventCounters.Empty();
+
+	Super::Deinitialize();
+}
+
+bool UFightEventBusSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId UFightEventBusSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UFightEventBusSubsystem, STATGROUP_Tickables);
+}
+
+void UFightEventBusSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	FlushDeferredEvents();
+}
+
+void UFightEventBusSubsystem::SendFightEvent(AActor* InReceiver, const FGameplayTag& InEventTag, AActor* InInstigator,
+	AActor* InEventTarget, EFightEventDispatch InDispatch)
+{
+	if (!InReceiver)
+	{
+		return;
+	}
+
+	if (UFightEventBusSubsystem* EventBus = InReceiver->GetWorld()->GetSubsystem<UFightEventBusSubsystem>())
+	{
+		EventBus->SendEvent(InReceiver, InEventTag, InInstigator, InEventTarget, InDispatch);
+		return;
+	}
+
+	FGameplayEventData Payload;
+	Payload.EventTag = InEventTag;
+	Payload.Instigator = InInstigator;
+	Payload.Target = InEventTarget;
+
+	DispatchToAbilitySystem(InReceiver, InEventTag, Payload);
+}
+
+void UFightEventBusSubsystem::SendEvent(AActor* InReceiver, const FGameplayTag& InEventTag, AActor* InInstigator,
+	AActor* InEventTarget, EFightEventDispatch InDispatch)
+{
+	if (!InReceiver)
+	{
+		return;
+	}
+
+	if (InDispatch == EFightEventDispatch::Immediate)
+	{
+		const int32 TriggeredCount = DispatchPooled(InReceiver, InEventTag, InInstigator, InEventTarget);
+
+		// 派发可能嵌套触发新的事件使EventCounters扩容，派发完成后再取计数
+		FFightEventCounter& Counter = EventCounters.FindOrAdd(InEventTag);
+		Counter.ImmediateCount++;
+		RecordDispatchResult(Counter, TriggeredCount);
+		return;
+	}
+
+	const FFightDeferredEvent NewEvent{ InReceiver, InEventTag, InInstigator, InEventTarget };
+
+	// 同一帧内完全相同的延迟事件只保留一个 --> 如一次挥砍同时命中多个目标时只顿帧一次
+	if (DeferredEvents.Contains(NewEvent))
+	{
+		EventCounters.FindOrAdd(InEventTag).CoalescedCount++;
+		return;
+	}
+
+	DeferredEvents.Add(NewEvent);
+}
+
+void UFightEventBusSubsystem::FlushDeferredEvents()
+{
+	if (DeferredEvents.IsEmpty())
+	{
+		return;
+	}
+
+	// 交换而非拷贝，两个数组的容量在帧间复用
+	Swap(DeferredEvents, FlushingEvents);
+
+	for (const FFightDeferredEvent& Event : FlushingEvents)
+	{
+		// 接收者在入队后被销毁时事件作废，按丢弃计数
+		AActor* Receiver = Event.Receiver.Get();
+		const int32 TriggeredCount = Receiver ?
+			DispatchPooled(Receiver, Event.EventTag, Event.Instigator.Get(), Event.EventTarget.Get()) : INDEX_NONE;
+
+		FFightEventCounter& Counter = EventCounters.FindOrAdd(Event.EventTag);
+		Counter.DeferredCount++;
+		RecordDispatchResult(Counter, TriggeredCount);
+	}
+
+	FlushingEvents.Reset();
+}
+
+void UFightEventBusSubsystem::DumpEventCounters(FOutputDevice& Ar) const
+{
+	Ar.Logf(TEXT("FightEventBus: %d tags, %d deferred pending, payload pool %d"),
+		EventCounters.Num(), DeferredEvents.Num(), PayloadPool.Num());
+
+	TArray<FGameplayTag> SortedTags;
+	EventCounters.GenerateKeyArray(SortedTags);
+	SortedTags.Sort([](const FGameplayTag& A, const FGameplayTag& B) { return A.GetTagName().LexicalLess(B.GetTagName()); });
+
+	for (const FGameplayTag& Tag : SortedTags)
+	{
+		const FFightEventCounter& Counter = EventCounters.FindChecked(Tag);
+
+		Ar.Logf(TEXT("  %-40s immediate=%lld deferred=%lld coalesced=%lld dropped=%lld triggered=%lld"),
+			*Tag.ToString(), Counter.ImmediateCount, Counter.DeferredCount, Counter.CoalescedCount,
+			Counter.DroppedCount, Counter.TriggeredAbilityCount);
+	}
+}
+
+void UFightEventBusSubsystem::ResetEventCounters()
+{
+	EventCounters.Reset();
+}
+
+int32 UFightEventBusSubsystem::DispatchToAbilitySystem(AActor* InReceiver, const FGameplayTag& InEventTag,
+	FGameplayEventData& InOutPayload)
+{
+	UAbilitySystemComponent* AbilitySystemComponent = ResolveAbilitySystemComponent(InReceiver);
+	if (!AbilitySystemComponent)
+	{
+		return INDEX_NONE;
+	}
+
+	// 与SendGameplayEventToActor一致，事件触发的能力在新的预测窗口中激活
+	FScopedPredictionWindow NewScopedWindow(AbilitySystemComponent, true);
+
+	return AbilitySystemComponent->HandleGameplayEvent(InEventTag, &InOutPayload);
+}
+
+UAbilitySystemComponent* UFightEventBusSubsystem::ResolveAbilitySystemComponent(AActor* InReceiver)
+{
+	// 项目中的角色都实现了接口，直接取用，只有其余Actor才走全局查找
+	if (const IAbilitySystemInterface* AbilitySystemInterface = Cast<IAbilitySystemInterface>(InReceiver))
+	{
+		return AbilitySystemInterface->GetAbilitySystemComponent();
+	}
+
+	return UAbilitySystemGlobals::GetAbilitySystemComponentFromActor(InReceiver);
+}
+
+void UFightEventBusSubsystem::ResetPayload(FGameplayEventData& InOutPayload)
+{
+	// 逐项复位而不是整体赋值，标签容器保留已分配的容量
+	InOutPayload.EventTag = FGameplayTag::EmptyTag;
+	InOutPayload.Instigator = nullptr;
+	InOutPayload.Target = nullptr;
+	InOutPayload.OptionalObject = nullptr;
+	InOutPayload.OptionalObject2 = nullptr;
+	InOutPayload.ContextHandle.Clear();
+	InOutPayload.InstigatorTags.Reset();
+	InOutPayload.TargetTags.Reset();
+	InOutPayload.EventMagnitude = 0.f;
+	InOutPayload.TargetData.Clear();
+}
+
+int32 UFightEventBusSubsystem::DispatchPooled(AActor* InReceiver, const FGameplayTag& InEventTag, AActor* InInstigator,
+	AActor* InEventTarget)
+{
+	if (PayloadPool.IsEmpty())
+	{
+		PayloadPool.Reserve(EventBusInitialPayloadPoolSize);
+	}
+
+	if (!PayloadPool.IsValidIndex(PayloadPoolDepth))
+	{
+		PayloadPool.Add(MakeUnique<FGameplayEventData>());
+	}
+
+	FGameplayEventData& Payload = *PayloadPool[PayloadPoolDepth];
+	Payload.EventTag = InEventTag;
+	Payload.Instigator = InInstigator;
+	Payload.Target = InEventTarget;
+
+	int32 TriggeredCount;
+	{
+		TGuardValue<int32> DepthGuard(PayloadPoolDepth, PayloadPoolDepth + 1);
+		TriggeredCount = DispatchToAbilitySystem(InReceiver, InEventTag, Payload);
+	}
+
+	ResetPayload(Payload);
+
+	return TriggeredCount;
+}
+
+void UFightEventBusSubsystem::RecordDispatchResult(FFightEventCounter& InOutCounter, int32 InTriggeredCount)
+{
+	if (InTriggeredCount == INDEX_NONE)
+	{
+		InOutCounter.DroppedCount++;
+	}
+	else
+	{
+		InOutCounter.TriggeredAbilityCount += InTriggeredCount;
+	}
+}
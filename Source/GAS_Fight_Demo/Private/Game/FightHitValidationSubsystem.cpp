@@ -0,0 +1,196 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Game/FightHitValidationSubsystem.h"
+#include "GameFramework/Character.h"
+#include "Components/CapsuleComponent.h"
+
+
+// 快照记录间隔与可回溯的最长时间 --> 环形缓冲区长度 = 回溯时间 / 记录间隔
+static constexpr double HitValidationRecordInterval = 1.0 / 30.0;
+static constexpr double HitValidationMaxRewindTime = 0.5;
+static constexpr int32 HitValidationSnapshotCount = 16;
+
+// 攻击者中心到目标胶囊体表面的最大允许距离（攻击者胶囊半径 + 武器长度 + 少量余量）
+// 网络误差不计入这里 --> 已由回溯与按速度放宽的容差覆盖
+static constexpr float HitValidationMaxMeleeReach = 200.f;
+
+
+void UFightHitValidationSubsystem::Deinitialize()
+{
+	TargetHistories.Empty();
+
+	Super::Deinitialize();
+}
+
+bool UFightHitValidationSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId UFightHitValidationSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UFightHitValidationSubsystem, STATGROUP_Tickables);
+}
+
+void UFightHitValidationSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	// 客户端不做校验，也就不需要历史
+	if (TargetHistories.IsEmpty() || GetWorld()->IsNetMode(NM_Client))
+	{
+		return;
+	}
+
+	const double CurrentTime = GetWorld()->GetTimeSeconds();
+	if (LastRecordTime >= 0.0 && CurrentTime - LastRecordTime < HitValidationRecordInterval)
+	{
+		return;
+	}
+
+	LastRecordTime = CurrentTime;
+
+	for (auto It = TargetHistories.CreateIterator(); It; ++It)
+	{
+		if (!It.Value().Character.IsValid())
+		{
+			It.RemoveCurrent();
+			continue;
+		}
+
+		RecordSnapshot(It.Value(), CurrentTime);
+	}
+}
+
+void UFightHitValidationSubsystem::RegisterHitTarget(ACharacter* InCharacter)
+{
+	if (!InCharacter || TargetHistories.Contains(InCharacter))
+	{
+		return;
+	}
+
+	FFightHitValidationHistory& NewHistory = TargetHistories.Add(InCharacter);
+	NewHistory.Character = InCharacter;
+	NewHistory.Snapshots.SetNum(HitValidationSnapshotCount);
+
+	const UCapsuleComponent* Capsule = InCharacter->GetCapsuleComponent();
+	NewHistory.CapsuleRadius = Capsule->GetScaledCapsuleRadius();
+	NewHistory.CapsuleHalfHeight = Capsule->GetScaledCapsuleHalfHeight();
+
+	RecordSnapshot(NewHistory, GetWorld()->GetTimeSeconds());
+}
+
+void UFightHitValidationSubsystem::UnregisterHitTarget(ACharacter* InCharacter)
+{
+	TargetHistories.Remove(InCharacter);
+}
+
+bool UFightHitValidationSubsystem::ValidateMeleeHit(const AActor* InAttacker, const AActor* InTarget, double InClaimServerTime) const
+{
+	if (!InAttacker || !InTarget)
+	{
+		return false;
+	}
+
+	const double CurrentTime = GetWorld()->GetTimeSeconds();
+
+	// 允许少量的时钟估算误差，但拒绝来自"未来"或过于久远的命中
+	if (InClaimServerTime > CurrentTime + HitValidationRecordInterval ||
+		InClaimServerTime < CurrentTime - HitValidationMaxRewindTime)
+	{
+		return false;
+	}
+
+	// 攻击者同样回溯 --> 服务器上攻击者此刻可能已经离开上报时的位置
+	FVector AttackerLocation = InAttacker->GetActorLocation();
+	float ExtraTolerance = 0.f;
+
+	if (const FFightHitValidationHistory* AttackerHistory = TargetHistories.Find(InAttacker))
+	{
+		RewindCapsuleLocation(*AttackerHistory, InClaimServerTime, AttackerLocation);
+	}
+	else
+	{
+		// 没有历史时按攻击者在回溯时长内最多能移动的距离放宽容差
+		ExtraTolerance = InAttacker->GetVelocity().Size() * FMath::Max(CurrentTime - InClaimServerTime, 0.0);
+	}
+
+	FVector CapsuleLocation = InTarget->GetActorLocation();
+	float CapsuleRadius = 0.f;
+	float CapsuleHalfHeight = 0.f;
+
+	if (const FFightHitValidationHistory* History = TargetHistories.Find(InTarget))
+	{
+		RewindCapsuleLocation(*History, InClaimServerTime, CapsuleLocation);
+		CapsuleRadius = History->CapsuleRadius;
+		CapsuleHalfHeight = History->CapsuleHalfHeight;
+	}
+	else if (const ACharacter* TargetCharacter = Cast<ACharacter>(InTarget))
+	{
+		CapsuleRadius = TargetCharacter->GetCapsuleComponent()->GetScaledCapsuleRadius();
+		CapsuleHalfHeight = TargetCharacter->GetCapsuleComponent()->GetScaledCapsuleHalfHeight();
+	}
+
+	return IsWithinMeleeReach(AttackerLocation, CapsuleLocation, CapsuleRadius, CapsuleHalfHeight, ExtraTolerance);
+}
+
+bool UFightHitValidationSubsystem::IsWithinMeleeReach(const FVector& InAttackerLocation, const FVector& InCapsuleLocation,
+	float InCapsuleRadius, float InCapsuleHalfHeight, float InExtraTolerance)
+{
+	// 攻击者到胶囊体中轴线段的距离减去半径，即到胶囊体表面的距离
+	const FVector SegmentOffset = FVector::UpVector * FMath::Max(InCapsuleHalfHeight - InCapsuleRadius, 0.f);
+	const float DistanceToCapsuleAxis = FMath::PointDistToSegment(
+		InAttackerLocation, InCapsuleLocation - SegmentOffset, InCapsuleLocation + SegmentOffset);
+
+	return DistanceToCapsuleAxis - InCapsuleRadius <= HitValidationMaxMeleeReach + InExtraTolerance;
+}
+
+bool UFightHitValidationSubsystem::RewindCapsuleLocation(const FFightHitValidationHistory& InHistory, double InTime,
+	FVector& OutCapsuleLocation) const
+{
+	if (InHistory.NumSnapshots == 0)
+	{
+		return false;
+	}
+
+	const int32 SnapshotCount = InHistory.Snapshots.Num();
+
+	// 从最新的快照向前找到第一个不晚于目标时刻的快照，与其后一个快照插值
+	const FFightHitValidationSnapshot* Newer = &InHistory.Snapshots[InHistory.HeadIndex];
+	if (InTime >= Newer->Time)
+	{
+		OutCapsuleLocation = Newer->CapsuleLocation;
+		return true;
+	}
+
+	for (int32 Offset = 1; Offset < InHistory.NumSnapshots; Offset++)
+	{
+		const FFightHitValidationSnapshot& Older = InHistory.Snapshots[(InHistory.HeadIndex - Offset + SnapshotCount) % SnapshotCount];
+
+		if (Older.Time <= InTime)
+		{
+			const double Alpha = (InTime - Older.Time) / FMath::Max(Newer->Time - Older.Time, UE_DOUBLE_SMALL_NUMBER);
+			OutCapsuleLocation = FMath::Lerp(Older.CapsuleLocation, Newer->CapsuleLocation, Alpha);
+			return true;
+		}
+
+		Newer = &Older;
+	}
+
+	// 早于最旧的快照，使用最旧的位置
+	OutCapsuleLocation = Newer->CapsuleLocation;
+	return false;
+}
+
+void UFightHitValidationSubsystem::RecordSnapshot(FFightHitValidationHistory& InOutHistory, double InTime) const
+{
+	const int32 SnapshotCount = InOutHistory.Snapshots.Num();
+
+	InOutHistory.HeadIndex = (InOutHistory.HeadIndex + 1) % SnapshotCount;
+	InOutHistory.NumSnapshots = FMath::Min(InOutHistory.NumSnapshots + 1, SnapshotCount);
+
+	FFightHitValidationSnapshot& Snapshot = InOutHistory.Snapshots[InOutHistory.HeadIndex];
+	Snapshot.Time = InTime;
+	Snapshot.CapsuleLocation = InOutHistory.Character->GetActorLocation();
+}
@@ -4,23 +4,43 @@
 #include "Game/FightSurvivalGameMode.h"
 #include "Engine/AssetManager.h"
 #include "Characters/EnemyCharacter.h"
+#include "Game/FightEnemyCrowdManager.h"
 #include "Kismet/GameplayStatics.h"
 #include "Engine/TargetPoint.h"
 #include "NavigationSystem.h"
 #include "FightFunctionLibrary.h"
+#include "SaveGame/FightSaveGameSubsystem.h"
+#include "Game/FightTimerSubsystem.h"
+#include "Game/FightSurvivalGameState.h"
 
 #include "GASDebugHelper.h"
 
 
+AFightSurvivalGameMode::AFightSurvivalGameMode()
+{
+	// 波次状态与计数通过游戏状态复制给客户端 --> 专用服务器合作模式下客户端没有游戏模式
+	GameStateClass = AFightSurvivalGameState::StaticClass();
+}
+
 void AFightSurvivalGameMode::InitGame(const FString& MapName, const FString& Options, FString& ErrorMessage)
 {
 	Super::InitGame(MapName, Options, ErrorMessage);
 
+	// 存档在GameInstance初始化时开始异步读取，通常此时已经完成；尚未完成时等读取完成后再应用难度
+	if (UFightSaveGameSubsystem* SaveGameSubsystem = GetGameInstance()->GetSubsystem<UFightSaveGameSubsystem>())
+	{
+		SaveGameSubsystem->CallOrRegister_OnSaveGameLoaded(
+			FOnFightSaveGameLoadedDelegate::FDelegate::CreateUObject(this, &ThisClass::ApplySavedGameDifficulty));
+	}
+}
+
+void AFightSurvivalGameMode::ApplySavedGameDifficulty()
+{
 	EFightGameDifficulty SavedGameDifficulty;
 
-	if (UFightFunctionLibrary::TryLoadSavedGameDifficulty(SavedGameDifficulty))
+	if (UFightFunctionLibrary::TryGetSavedGameDifficulty(this, SavedGameDifficulty))
 	{
-		CurrentGameDifficulty = SavedGameDifficulty;
+		SetCurrentGameDifficulty(SavedGameDifficulty);
 	}
 }
 
@@ -33,68 +53,108 @@ void AFightSurvivalGameMode::BeginPlay()
 	SetCurrentSurvivalGameModeState(EFightSurvivalGameModeState::WaitSpawnNewWave);
 
 	TotalWavesToSpawn = EnemyWaveSpawnerDataTable->GetRowNames().Num();
+	SyncWaveCountersToGameState();
 
 	PreloadNextWaveEnemies();
+
+	RunStartTime = GetWorld()->GetTimeSeconds();
+	GetGameInstance()->GetSubsystem<UFightSaveGameSubsystem>()->RecordRunStarted();
 }
 
-void AFightSurvivalGameMode::Tick(float DeltaTime)
+void AFightSurvivalGameMode::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
-	Super::Tick(DeltaTime);
+	if (UFightTimerSubsystem* TimerSubsystem = GetWorld()->GetSubsystem<UFightTimerSubsystem>())
+	{
+		TimerSubsystem->ClearTimer(WaveStateTimerHandle);
+	}
 
+	Super::EndPlay(EndPlayReason);
+}
+
+void AFightSurvivalGameMode::OnWaveStateTimerFired()
+{
 	if (CurrentSurvivalGameModeState == EFightSurvivalGameModeState::WaitSpawnNewWave)
 	{
-		TimePassedSinceStart += DeltaTime;
+		SetCurrentSurvivalGameModeState(EFightSurvivalGameModeState::SpawningNewWave);
+	}
+	else if (CurrentSurvivalGameModeState == EFightSurvivalGameModeState::SpawningNewWave)
+	{
+		CurrentSpawnedEnemiesCounter += TrySpawnWaveEnemies();
+		SyncWaveCountersToGameState();
 
-		if (TimePassedSinceStart >= SpawnNewWaveWaitTime)
-		{
-			TimePassedSinceStart = 0.0f;
+		SetCurrentSurvivalGameModeState(EFightSurvivalGameModeState::InProgress);
+	}
+	else if (CurrentSurvivalGameModeState == EFightSurvivalGameModeState::WaveCompleted)
+	{
+		CurrentWaveCount++;
 
-			SetCurrentSurvivalGameModeState(EFightSurvivalGameModeState::SpawningNewWave);
+		if (HasFinishedAllWaves())
+		{
+			SetCurrentSurvivalGameModeState(EFightSurvivalGameModeState::AllWavesDone);
+		}
+		else
+		{
+			SetCurrentSurvivalGameModeState(EFightSurvivalGameModeState::WaitSpawnNewWave);
+			PreloadNextWaveEnemies();
 		}
 	}
+}
 
-	if (CurrentSurvivalGameModeState == EFightSurvivalGameModeState::SpawningNewWave)
+void AFightSurvivalGameMode::SetCurrentSurvivalGameModeState(EFightSurvivalGameModeState InState)
+{
+	CurrentSurvivalGameModeState = InState;
+
+	// 每个波次完成时追加一条进度检查点
+	if (CurrentSurvivalGameModeState == EFightSurvivalGameModeState::WaveCompleted)
 	{
-		TimePassedSinceStart += DeltaTime;
+		GetGameInstance()->GetSubsystem<UFightSaveGameSubsystem>()->RecordWaveCheckpoint(
+			CurrentWaveCount, EnemiesDefeatedThisRun, GetWorld()->GetTimeSeconds() - RunStartTime);
+	}
 
-		if (TimePassedSinceStart >= SpawnEnemiesDelayTime)
-		{
-			CurrentSpawnedEnemiesCounter += TrySpawnWaveEnemies();
+	// 需要等待的状态交给时间轮计时，到期后在OnWaveStateTimerFired中推进
+	UFightTimerSubsystem* TimerSubsystem = GetWorld()->GetSubsystem<UFightTimerSubsystem>();
+	check(TimerSubsystem);
 
-			TimePassedSinceStart = 0.0f;
+	TimerSubsystem->ClearTimer(WaveStateTimerHandle);
 
-			SetCurrentSurvivalGameModeState(EFightSurvivalGameModeState::InProgress);
-		}
+	float WaitTime = -1.f;
+	switch (CurrentSurvivalGameModeState)
+	{
+	case EFightSurvivalGameModeState::WaitSpawnNewWave:
+	case EFightSurvivalGameModeState::WaveCompleted:
+		WaitTime = SpawnNewWaveWaitTime;
+		break;
+
+	case EFightSurvivalGameModeState::SpawningNewWave:
+		WaitTime = SpawnEnemiesDelayTime;
+		break;
+
+	default:
+		break;
 	}
 
-	if (CurrentSurvivalGameModeState == EFightSurvivalGameModeState::WaveCompleted)
+	if (WaitTime >= 0.f)
 	{
-		TimePassedSinceStart += DeltaTime;
-
-		if (TimePassedSinceStart >= SpawnNewWaveWaitTime)
-		{
-			TimePassedSinceStart = 0.0f;
+		WaveStateTimerHandle = TimerSubsystem->SetTimer(
+			FFightTimerDelegate::CreateUObject(this, &ThisClass::OnWaveStateTimerFired), WaitTime);
+	}
 
-			CurrentWaveCount++;
+	SyncWaveCountersToGameState();
 
-			if (HasFinishedAllWaves())
-			{
-				SetCurrentSurvivalGameModeState(EFightSurvivalGameModeState::AllWavesDone);
-			}
-			else
-			{
-				SetCurrentSurvivalGameModeState(EFightSurvivalGameModeState::WaitSpawnNewWave);
-				PreloadNextWaveEnemies();
-			}
-		}
+	if (AFightSurvivalGameState* SurvivalGameState = GetGameState<AFightSurvivalGameState>())
+	{
+		SurvivalGameState->SetSurvivalGameModeState(CurrentSurvivalGameModeState);
 	}
+
+	OnSurvivalGameModeStateChanged.Broadcast(CurrentSurvivalGameModeState);
 }
 
-void AFightSurvivalGameMode::SetCurrentSurvivalGameModeState(EFightSurvivalGameModeState InState)
+void AFightSurvivalGameMode::SyncWaveCountersToGameState() const
 {
-	CurrentSurvivalGameModeState = InState;
-
-	OnSurvivalGameModeStateChanged.Broadcast(CurrentSurvivalGameModeState);
+	if (AFightSurvivalGameState* SurvivalGameState = GetGameState<AFightSurvivalGameState>())
+	{
+		SurvivalGameState->SetWaveCounters(CurrentWaveCount, TotalWavesToSpawn, CurrentSpawnedEnemiesCounter);
+	}
 }
 
 bool AFightSurvivalGameMode::HasFinishedAllWaves() const
@@ -118,8 +178,17 @@ void AFightSurvivalGameMode::PreloadNextWaveEnemies()
 			continue;
 		}
 
+		TArray<FSoftObjectPath> AssetsToLoad;
+		AssetsToLoad.Add(SpawnerInfo.SoftEnemyClassToSpawn.ToSoftObjectPath());
+
+		// 启用轻量层级时，代理网格与敌人类一起预加载
+		if (bEnableLightweightEnemyTier && !SpawnerInfo.SoftLightweightProxyMesh.IsNull())
+		{
+			AssetsToLoad.Add(SpawnerInfo.SoftLightweightProxyMesh.ToSoftObjectPath());
+		}
+
 		UAssetManager::GetStreamableManager().RequestAsyncLoad(
-			SpawnerInfo.SoftEnemyClassToSpawn.ToSoftObjectPath(),
+			AssetsToLoad,
 			FStreamableDelegate::CreateLambda(
 				[SpawnerInfo, this]()
 				{
@@ -157,38 +226,59 @@ int32 AFightSurvivalGameMode::TrySpawnWaveEnemies()
 	FActorSpawnParameters SpawnParam;
 	SpawnParam.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
 
-	for (const FFightEnemyWaveSpawnerInfo& SpawnerInfo : GetCurrentWaveSpawnerTableRow()->EnemyWaveSpawnerDefinitions)
+	const TArray<FFightEnemyWaveSpawnerInfo>& SpawnerDefinitions = GetCurrentWaveSpawnerTableRow()->EnemyWaveSpawnerDefinitions;
+
+	// 最后一个有效生成器 --> 前面的生成器都被缩到0时由它至少补1个，避免波次在未生成满时停住
+	const int32 LastValidSpawnerIndex = SpawnerDefinitions.FindLastByPredicate(
+		[](const FFightEnemyWaveSpawnerInfo& InSpawnerInfo) { return !InSpawnerInfo.SoftEnemyClassToSpawn.IsNull(); });
+
+	for (int32 SpawnerIndex = 0; SpawnerIndex < SpawnerDefinitions.Num(); SpawnerIndex++)
 	{
+		const FFightEnemyWaveSpawnerInfo& SpawnerInfo = SpawnerDefinitions[SpawnerIndex];
+
 		if (SpawnerInfo.SoftEnemyClassToSpawn.IsNull())
 		{
 			continue;
 		}
 
-		const int32 NumToSpawn = FMath::RandRange(SpawnerInfo.MinPerSpawnCount, SpawnerInfo.MaxPerSpawnCount);
+		int32 NumToSpawn = ScaleWaveEnemyCount(GetGameplayRandomStream().RandRange(SpawnerInfo.MinPerSpawnCount, SpawnerInfo.MaxPerSpawnCount));
+
+		if (SpawnerIndex == LastValidSpawnerIndex && EnemiesSpawnedThisTime == 0)
+		{
+			NumToSpawn = FMath::Max(1, NumToSpawn);
+		}
 
 		UClass* LoadedEnemyClass = PreLoadedEnemyClassMap.FindChecked(SpawnerInfo.SoftEnemyClassToSpawn);
 
 		for (int32 i = 0; i < NumToSpawn; i++)
 		{
-			const int32 RandomTargetPointIndex = FMath::RandRange(0, TargetPointArray.Num() - 1);
+			const int32 RandomTargetPointIndex = GetGameplayRandomStream().RandRange(0, TargetPointArray.Num() - 1);
 			const FVector SpawnOrigin = TargetPointArray[RandomTargetPointIndex]->GetActorLocation();
 			const FRotator SpawnRotation = TargetPointArray[RandomTargetPointIndex]->GetActorForwardVector().ToOrientationRotator();
 
-			FVector RandomLocation;
-
-			UNavigationSystemV1::K2_GetRandomReachablePointInRadius(this, SpawnOrigin, RandomLocation, 400.0f);
-
-			RandomLocation += FVector(0.0f, 0.0f, 150.0f);
+			FVector RandomLocation = GetRandomSpawnLocation(SpawnOrigin, 400.f);
 
-			AEnemyCharacter* SpawnedEnemy = GetWorld()->SpawnActor<AEnemyCharacter>(LoadedEnemyClass, RandomLocation, SpawnRotation, SpawnParam);
-
-			if (SpawnedEnemy)
+			// 轻量实体与完整敌人同样计入本波次的生成总数
+			if (TrySpawnLightweightEnemy(SpawnerInfo, LoadedEnemyClass, RandomLocation, SpawnRotation))
 			{
-				SpawnedEnemy->OnDestroyed.AddUniqueDynamic(this, &ThisClass::OnEnemyDestroyed);
-
 				EnemiesSpawnedThisTime++;
 				TotalSpawnedEnemiesThisWaveCounter++;
 			}
+			else
+			{
+				RandomLocation += FVector(0.0f, 0.0f, 150.0f);
+
+				AEnemyCharacter* SpawnedEnemy = GetWorld()->SpawnActor<AEnemyCharacter>(LoadedEnemyClass, RandomLocation, SpawnRotation, SpawnParam);
+
+				if (SpawnedEnemy)
+				{
+					SpawnedEnemy->OnDestroyed.AddUniqueDynamic(this, &ThisClass::OnEnemyDestroyed);
+
+					EnemiesSpawnedThisTime++;
+					TotalSpawnedEnemiesThisWaveCounter++;
+					CurrentFullEnemiesCounter++;
+				}
+			}
 
 			if (!ShouldKeepSpawnEnemies())
 			{
@@ -202,16 +292,90 @@ int32 AFightSurvivalGameMode::TrySpawnWaveEnemies()
 
 bool AFightSurvivalGameMode::ShouldKeepSpawnEnemies() const
 {
-	return TotalSpawnedEnemiesThisWaveCounter < GetCurrentWaveSpawnerTableRow()->TotalEnemyToSpawnThisWave;
+	const int32 BaseWaveTotal = GetCurrentWaveSpawnerTableRow()->TotalEnemyToSpawnThisWave;
+
+	// 只对波次总数保底1个，避免低倍率把非空波次缩成空波导致无法完成 --> 单次生成数量允许缩到0
+	const int32 ScaledWaveTotal = BaseWaveTotal > 0 ? FMath::Max(1, ScaleWaveEnemyCount(BaseWaveTotal)) : 0;
+
+	return TotalSpawnedEnemiesThisWaveCounter < ScaledWaveTotal;
+}
+
+int32 AFightSurvivalGameMode::ScaleWaveEnemyCount(int32 InBaseCount) const
+{
+	if (!GetCurrentWaveSpawnerTableRow()->bScaleWithDifficulty)
+	{
+		return InBaseCount;
+	}
+
+	return FMath::RoundToInt32(InBaseCount * GetCurrentDifficultyPolicyEntry().EnemySpawnCountMultiplier);
+}
+
+bool AFightSurvivalGameMode::TrySpawnLightweightEnemy(const FFightEnemyWaveSpawnerInfo& InSpawnerInfo, UClass* InEnemyClass,
+	const FVector& InLocation, const FRotator& InRotation)
+{
+	if (!bEnableLightweightEnemyTier || CurrentFullEnemiesCounter < MaxFullEnemiesAlive)
+	{
+		return false;
+	}
+
+	UStaticMesh* ProxyMesh = InSpawnerInfo.SoftLightweightProxyMesh.Get();
+	if (!ProxyMesh)
+	{
+		return false;
+	}
+
+	if (!EnemyCrowdManager)
+	{
+		EnemyCrowdManager = GetWorld()->SpawnActor<AFightEnemyCrowdManager>();
+		check(EnemyCrowdManager);
+
+		EnemyCrowdManager->PromotionRadius = LightweightPromotionRadius;
+		EnemyCrowdManager->MoveSpeed = LightweightMoveSpeed;
+		EnemyCrowdManager->InitializeRandomStream(GenerateGameplaySeed());
+		EnemyCrowdManager->OnLightweightEnemyPromoted.AddUObject(this, &ThisClass::OnLightweightEnemyPromoted);
+		EnemyCrowdManager->OnLightweightEnemyDespawned.AddUObject(this, &ThisClass::OnLightweightEnemyDespawned);
+		EnemyCrowdManager->CanPromoteLightweightEnemy.BindUObject(this, &ThisClass::CanPromoteLightweightEnemy);
+	}
+
+	return EnemyCrowdManager->AddLightweightEnemy(InEnemyClass, ProxyMesh, InLocation, InRotation.Yaw);
+}
+
+bool AFightSurvivalGameMode::CanPromoteLightweightEnemy() const
+{
+	return CurrentFullEnemiesCounter < MaxFullEnemiesAlive;
+}
+
+void AFightSurvivalGameMode::OnLightweightEnemyPromoted(AEnemyCharacter* InPromotedEnemy)
+{
+	CurrentFullEnemiesCounter++;
+
+	InPromotedEnemy->OnDestroyed.AddUniqueDynamic(this, &ThisClass::OnEnemyDestroyed);
+}
+
+void AFightSurvivalGameMode::OnLightweightEnemyDespawned()
+{
+	// 被移除的实体不算击杀，本波的生成总数同样扣除，补生成的敌人使用新的随机位置
+	CurrentSpawnedEnemiesCounter--;
+	TotalSpawnedEnemiesThisWaveCounter = FMath::Max(TotalSpawnedEnemiesThisWaveCounter - 1, 0);
+
+	if (ShouldKeepSpawnEnemies())
+	{
+		CurrentSpawnedEnemiesCounter += TrySpawnWaveEnemies();
+	}
+
+	SyncWaveCountersToGameState();
 }
 
 void AFightSurvivalGameMode::OnEnemyDestroyed(AActor* DestroyedActor)
 {
 	CurrentSpawnedEnemiesCounter--;
+	CurrentFullEnemiesCounter = FMath::Max(CurrentFullEnemiesCounter - 1, 0);
+	EnemiesDefeatedThisRun++;
 
 	if (ShouldKeepSpawnEnemies())
 	{
 		CurrentSpawnedEnemiesCounter += TrySpawnWaveEnemies();
+		SyncWaveCountersToGameState();
 	}
 
 	else if (CurrentSpawnedEnemiesCounter <= 0)
@@ -221,6 +385,10 @@ void AFightSurvivalGameMode::OnEnemyDestroyed(AActor* DestroyedActor)
 
 		SetCurrentSurvivalGameModeState(EFightSurvivalGameModeState::WaveCompleted);
 	}
+	else
+	{
+		SyncWaveCountersToGameState();
+	}
 }
 
 void AFightSurvivalGameMode::RegisterSpawnedEnemies(const TArray<AEnemyCharacter*>& InEnemyToRegister)
@@ -230,8 +398,11 @@ void AFightSurvivalGameMode::RegisterSpawnedEnemies(const TArray<AEnemyCharacter
 		if (SpawnedEnemy)
 		{
 			CurrentSpawnedEnemiesCounter++;
+			CurrentFullEnemiesCounter++;
 
 			SpawnedEnemy->OnDestroyed.AddUniqueDynamic(this, &AFightSurvivalGameMode::OnEnemyDestroyed);
 		}
 	}
+
+	SyncWaveCountersToGameState();
 }
@@ -0,0 +1,60 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Game/FightSurvivalGameState.h"
+#include "Net/UnrealNetwork.h"
+#include "Net/Core/PushModel/PushModel.h"
+
+
+void AFightSurvivalGameState::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+	// 推送模式 --> 只有被标记为脏的属性才会在网络更新时比较与发送
+	FDoRepLifetimeParams PushParams;
+	PushParams.bIsPushBased = true;
+
+	DOREPLIFETIME_WITH_PARAMS_FAST(ThisClass, SurvivalGameModeState, PushParams);
+	DOREPLIFETIME_WITH_PARAMS_FAST(ThisClass, CurrentWaveCount, PushParams);
+	DOREPLIFETIME_WITH_PARAMS_FAST(ThisClass, TotalWavesToSpawn, PushParams);
+	DOREPLIFETIME_WITH_PARAMS_FAST(ThisClass, AliveEnemiesCount, PushParams);
+}
+
+void AFightSurvivalGameState::SetSurvivalGameModeState(EFightSurvivalGameModeState InState)
+{
+	if (SurvivalGameModeState != InState)
+	{
+		SurvivalGameModeState = InState;
+		MARK_PROPERTY_DIRTY_FROM_NAME(ThisClass, SurvivalGameModeState, this);
+	}
+
+	// 监听服务器/单机下没有OnRep，这里手动广播一次
+	OnSurvivalGameModeStateChanged.Broadcast(SurvivalGameModeState);
+}
+
+void AFightSurvivalGameState::SetWaveCounters(int32 InCurrentWaveCount, int32 InTotalWavesToSpawn, int32 InAliveEnemiesCount)
+{
+	if (CurrentWaveCount != InCurrentWaveCount)
+	{
+		CurrentWaveCount = InCurrentWaveCount;
+		MARK_PROPERTY_DIRTY_FROM_NAME(ThisClass, CurrentWaveCount, this);
+	}
+
+	if (TotalWavesToSpawn != InTotalWavesToSpawn)
+	{
+		TotalWavesToSpawn = InTotalWavesToSpawn;
+		MARK_PROPERTY_DIRTY_FROM_NAME(ThisClass, TotalWavesToSpawn, this);
+	}
+
+	const int32 NewAliveEnemiesCount = FMath::Max(InAliveEnemiesCount, 0);
+	if (AliveEnemiesCount != NewAliveEnemiesCount)
+	{
+		AliveEnemiesCount = NewAliveEnemiesCount;
+		MARK_PROPERTY_DIRTY_FROM_NAME(ThisClass, AliveEnemiesCount, this);
+	}
+}
+
+void AFightSurvivalGameState::OnRep_SurvivalGameModeState()
+{
+	OnSurvivalGameModeStateChanged.Broadcast(SurvivalGameModeState);
+}
@@ -0,0 +1,50 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Game/FightTimerSubsystem.h"
+
+
+void UFightTimerSubsystem::Deinitialize()
+{
+	TimerWheel.Reset();
+
+	Super::Deinitialize();
+}
+
+bool UFightTimerSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId UFightTimerSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UFightTimerSubsystem, STATGROUP_Tickables);
+}
+
+void UFightTimerSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	TimerWheel.Advance(DeltaTime);
+}
+
+FFightTimerHandle UFightTimerSubsystem::SetTimer(FFightTimerDelegate&& InDelegate, float InDelay, float InInterval)
+{
+	return TimerWheel.AddTimer(MoveTemp(InDelegate), InDelay, InInterval);
+}
+
+void UFightTimerSubsystem::ClearTimer(FFightTimerHandle& InOutHandle)
+{
+	TimerWheel.RemoveTimer(InOutHandle);
+	InOutHandle.Invalidate();
+}
+
+bool UFightTimerSubsystem::IsTimerActive(const FFightTimerHandle& InHandle) const
+{
+	return TimerWheel.IsTimerActive(InHandle);
+}
+
+float UFightTimerSubsystem::GetTimerRemaining(const FFightTimerHandle& InHandle) const
+{
+	return static_cast<float>(TimerWheel.GetTimeRemaining(InHandle));
+}
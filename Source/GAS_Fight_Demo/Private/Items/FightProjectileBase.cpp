@@ -7,7 +7,7 @@
 #include "GameFramework/ProjectileMovementComponent.h"
 #include "FightFunctionLibrary.h"
 #include "GAS/FightGameplayTags.h"
-#include "AbilitySystemBlueprintLibrary.h"
+#include "Game/FightEventBusSubsystem.h"
 
 #include "GASDebugHelper.h"
 
@@ -77,18 +77,14 @@ void AFightProjectileBase::OnProjectileHit(UPrimitiveComponent* HitComponent, AA
 		bIsValidBlock = UFightFunctionLibrary::IsValidBlock(this, HitPawn);
 	}
 
-	FGameplayEventData Data;
-	Data.Instigator = this;
-	Data.Target = HitPawn;
-
 	if (bIsValidBlock)
 	{
-		UAbilitySystemBlueprintLibrary::SendGameplayEventToActor(HitPawn,
-			FightGameplayTags::Player_Event_SuccessfulBlock, Data);
+		UFightEventBusSubsystem::SendFightEvent(HitPawn,
+			FightGameplayTags::Player_Event_SuccessfulBlock, this, HitPawn);
 	}
 	else
 	{
-		HandleApplyProjectileDamage(HitPawn, Data);
+		HandleApplyProjectileDamage(HitPawn, this);
 	}
 
 	Destroy();
@@ -107,18 +103,14 @@ void AFightProjectileBase::OnProjectileBeginOverlap(UPrimitiveComponent* Overlap
 
 	if (APawn* HitPawn = Cast<APawn>(OtherActor))
 	{
-		FGameplayEventData Data;
-		Data.Instigator = GetInstigator();
-		Data.Target = HitPawn;
-
 		if (UFightFunctionLibrary::IsTargetPawnHostile(GetInstigator(), HitPawn))
 		{
-			HandleApplyProjectileDamage(HitPawn, Data);
+			HandleApplyProjectileDamage(HitPawn, GetInstigator());
 		}
 	}
 }
 
-void AFightProjectileBase::HandleApplyProjectileDamage(APawn* InHitPawn, const FGameplayEventData& InPayLoad)
+void AFightProjectileBase::HandleApplyProjectileDamage(APawn* InHitPawn, AActor* InEventInstigator)
 {
 	checkf(ProjectileDamageEffectSpecHandle.IsValid(), 
 		TEXT("ProjectileDamageEffectSpecHandle is not valid: %s"), *GetActorNameOrLabel());
@@ -130,7 +122,7 @@ void AFightProjectileBase::HandleApplyProjectileDamage(APawn* InHitPawn, const F
 	// 如果成功应用伤害，发送受击反应事件
 	if (bWasApplied)
 	{
-		UAbilitySystemBlueprintLibrary::SendGameplayEventToActor(
-			InHitPawn, FightGameplayTags::Shared_Event_HitReact, InPayLoad);
+		UFightEventBusSubsystem::SendFightEvent(
+			InHitPawn, FightGameplayTags::Shared_Event_HitReact, InEventInstigator, InHitPawn);
 	}
 }
@@ -3,16 +3,71 @@
 
 #include "Items/PickUps/FightPickUpBase.h"
 #include "Components/SphereComponent.h"
+#include "Net/UnrealNetwork.h"
+#include "Net/Core/PushModel/PushModel.h"
 
 
 AFightPickUpBase::AFightPickUpBase()
 {
 	PrimaryActorTick.bCanEverTick = false;
 
+	// 拾取物生成后直到被拾取都不会变化 --> 初始即休眠，只复制生成与销毁；距离玩家较远时不相关
+	bReplicates = true;
+	NetDormancy = DORM_Initial;
+	SetNetCullDistanceSquared(FMath::Square(5000.f));
+
+	// 对象池复用时拾取物会被移动到新的掉落位置，休眠期间不产生开销
+	SetReplicatingMovement(true);
+
 	PickUpCollisionSphere = CreateDefaultSubobject<USphereComponent>(TEXT("PickUpCollisionSphere"));
 	SetRootComponent(PickUpCollisionSphere);
 	PickUpCollisionSphere->InitSphereRadius(50.f);
 	PickUpCollisionSphere->OnComponentBeginOverlap.AddUniqueDynamic(this, &ThisClass::OnPickUpCollisionSphereBeginOverlap);
+	PickUpCollisionSphere->OnComponentEndOverlap.AddUniqueDynamic(this, &ThisClass::OnPickUpCollisionSphereEndOverlap);
+}
+
+void AFightPickUpBase::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+	FDoRepLifetimeParams PushParams;
+	PushParams.bIsPushBased = true;
+
+	DOREPLIFETIME_WITH_PARAMS_FAST(ThisClass, bIsPickUpActive, PushParams);
+}
+
+void AFightPickUpBase::SetPickUpActive(bool bInActive)
+{
+	if (bIsPickUpActive == bInActive)
+	{
+		return;
+	}
+
+	// 休眠中的Actor需要先唤醒一次，状态变化才会发送出去
+	FlushNetDormancy();
+
+	bIsPickUpActive = bInActive;
+	MARK_PROPERTY_DIRTY_FROM_NAME(ThisClass, bIsPickUpActive, this);
+
+	ApplyPickUpActiveState();
+}
+
+void AFightPickUpBase::OnRep_IsPickUpActive()
+{
+	ApplyPickUpActiveState();
+}
+
+void AFightPickUpBase::ApplyPickUpActiveState()
+{
+	// 关闭碰撞会触发结束重叠，玩家的重叠集合随之移除本拾取物
+	SetActorHiddenInGame(!bIsPickUpActive);
+	SetActorEnableCollision(bIsPickUpActive);
+
+	// 初始复制在BeginPlay之前完成，此时收到的未激活状态只是拾取物当前所处的状态
+	if (!bIsPickUpActive && HasActorBegunPlay())
+	{
+		OnPickUpDeactivated();
+	}
 }
 
 void AFightPickUpBase::OnPickUpCollisionSphereBeginOverlap(UPrimitiveComponent* OverlappedComponent, 
@@ -20,3 +75,9 @@ void AFightPickUpBase::OnPickUpCollisionSphereBeginOverlap(UPrimitiveComponent*
 {
 
 }
+
+void AFightPickUpBase::OnPickUpCollisionSphereEndOverlap(UPrimitiveComponent* OverlappedComponent,
+	AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex)
+{
+
+}
@@ -0,0 +1,145 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Items/PickUps/FightPickUpPoolSubsystem.h"
+#include "Items/PickUps/FightStoneBase.h"
+
+
+// 同时存活的石头上限
+static constexpr int32 PickUpPoolMaxAliveStones = 24;
+
+// 新掉落的石头与已有同类石头的合并半径
+static constexpr float PickUpPoolMergeRadius = 150.f;
+
+
+void UFightPickUpPoolSubsystem::Deinitialize()
+{
+	AliveStones.Empty();
+	FreeStones.Empty();
+
+	Super::Deinitialize();
+}
+
+bool UFightPickUpPoolSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+AFightStoneBase* UFightPickUpPoolSubsystem::SpawnStone(TSubclassOf<AFightStoneBase> InStoneClass, const FVector& InLocation,
+	int32 InStackCount)
+{
+	if (!InStoneClass || GetWorld()->IsNetMode(NM_Client))
+	{
+		return nullptr;
+	}
+
+	InStackCount = FMath::Max(InStackCount, 1);
+
+	// 被蓝图销毁的石头不再计入存活数量
+	AliveStones.RemoveAll([](const TWeakObjectPtr<AFightStoneBase>& Stone) { return !Stone.IsValid(); });
+
+	const TSubclassOf<UGameplayEffect> EffectClass = InStoneClass->GetDefaultObject<AFightStoneBase>()->GetStoneGameplayEffectClass();
+
+	// 附近已有同类石头，直接叠加
+	if (AFightStoneBase* MergeTarget = FindMergeTarget(EffectClass, InLocation, PickUpPoolMergeRadius))
+	{
+		MergeTarget->AddStacks(InStackCount);
+		return MergeTarget;
+	}
+
+	if (AliveStones.Num() >= PickUpPoolMaxAliveStones)
+	{
+		// 超出预算时不论远近都叠加到最近的同类石头上
+		if (AFightStoneBase* MergeTarget = FindMergeTarget(EffectClass, InLocation, UE_BIG_NUMBER))
+		{
+			MergeTarget->AddStacks(InStackCount);
+			return MergeTarget;
+		}
+
+		ReleaseStone(AliveStones[0].Get());
+	}
+
+	AFightStoneBase* Stone = AcquireStone(InStoneClass, InLocation);
+	if (!Stone)
+	{
+		return nullptr;
+	}
+
+	Stone->SetStackCount(InStackCount);
+	AliveStones.Add(Stone);
+
+	return Stone;
+}
+
+void UFightPickUpPoolSubsystem::ReleaseStone(AFightStoneBase* InStone)
+{
+	if (!IsValid(InStone))
+	{
+		return;
+	}
+
+	AliveStones.Remove(InStone);
+
+	// 先关闭碰撞，玩家的重叠集合在结束重叠时移除这块石头
+	InStone->SetPickUpActive(false);
+	InStone->SetStackCount(1);
+
+	FreeStones.FindOrAdd(InStone->GetClass()).AddUnique(InStone);
+}
+
+AFightStoneBase* UFightPickUpPoolSubsystem::FindMergeTarget(TSubclassOf<UGameplayEffect> InEffectClass, const FVector& InLocation,
+	float InMaxDistance) const
+{
+	AFightStoneBase* NearestStone = nullptr;
+	double NearestDistanceSquared = FMath::Square(static_cast<double>(InMaxDistance));
+
+	for (const TWeakObjectPtr<AFightStoneBase>& WeakStone : AliveStones)
+	{
+		AFightStoneBase* Stone = WeakStone.Get();
+		if (!Stone || Stone->GetStoneGameplayEffectClass() != InEffectClass)
+		{
+			continue;
+		}
+
+		const double DistanceSquared = FVector::DistSquared(Stone->GetActorLocation(), InLocation);
+		if (DistanceSquared <= NearestDistanceSquared)
+		{
+			NearestStone = Stone;
+			NearestDistanceSquared = DistanceSquared;
+		}
+	}
+
+	return NearestStone;
+}
+
+AFightStoneBase* UFightPickUpPoolSubsystem::AcquireStone(TSubclassOf<AFightStoneBase> InStoneClass, const FVector& InLocation)
+{
+	if (TArray<TWeakObjectPtr<AFightStoneBase>>* FreeList = FreeStones.Find(InStoneClass.Get()))
+	{
+		while (!FreeList->IsEmpty())
+		{
+			AFightStoneBase* Stone = FreeList->Pop(EAllowShrinking::No).Get();
+			if (!IsValid(Stone))
+			{
+				continue;
+			}
+
+			// 碰撞关闭时移动，到位后再激活，避免途经的重叠
+			Stone->SetActorLocation(InLocation, false, nullptr, ETeleportType::TeleportPhysics);
+			Stone->SetConsumed(false);
+			Stone->SetPickUpActive(true);
+			return Stone;
+		}
+	}
+
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+	AFightStoneBase* Stone = GetWorld()->SpawnActor<AFightStoneBase>(InStoneClass, InLocation, FRotator::ZeroRotator, SpawnParams);
+	if (Stone)
+	{
+		Stone->MarkAsPooled();
+	}
+
+	return Stone;
+}
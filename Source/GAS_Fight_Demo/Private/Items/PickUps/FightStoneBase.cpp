@@ -3,23 +3,164 @@
 
 #include "Items/PickUps/FightStoneBase.h"
 #include "Characters/MainCharacter.h"
-#include "GAS/FightGameplayTags.h"
 #include "GAS/FightAbilitySystemComponent.h"
+#include "GameplayEffect.h"
+#include "Items/PickUps/FightPickUpPoolSubsystem.h"
+#include "Net/UnrealNetwork.h"
+#include "Net/Core/PushModel/PushModel.h"
 
 
+void AFightStoneBase::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+	FDoRepLifetimeParams PushParams;
+	PushParams.bIsPushBased = true;
+
+	DOREPLIFETIME_WITH_PARAMS_FAST(ThisClass, StackCount, PushParams);
+	DOREPLIFETIME_WITH_PARAMS_FAST(ThisClass, bConsumed, PushParams);
+
+	FDoRepLifetimeParams InitialOnlyParams;
+	InitialOnlyParams.bIsPushBased = true;
+	InitialOnlyParams.Condition = COND_InitialOnly;
+
+	DOREPLIFETIME_WITH_PARAMS_FAST(ThisClass, bIsPooled, InitialOnlyParams);
+}
+
 void AFightStoneBase::Consume(UFightAbilitySystemComponent* AbilitySystemComponent, int32 ApplyLevel)
 {
-	check(StoneGameplayEffectClass);
+	AFightStoneBase* const Stones[] = { this };
+	ConsumeStones(Stones, AbilitySystemComponent, ApplyLevel);
+}
+
+void AFightStoneBase::ConsumeStones(TConstArrayView<AFightStoneBase*> InStones, UFightAbilitySystemComponent* AbilitySystemComponent,
+	int32 ApplyLevel)
+{
+	check(AbilitySystemComponent);
+
+	// 统计每种效果需要应用的层数 --> 石头种类很少，线性查找即可
+	TArray<TPair<TSubclassOf<UGameplayEffect>, int32>, TInlineAllocator<4>> EffectStackCounts;
+
+	for (const AFightStoneBase* Stone : InStones)
+	{
+		if (!Stone)
+		{
+			continue;
+		}
+
+		check(Stone->StoneGameplayEffectClass);
+
+		TPair<TSubclassOf<UGameplayEffect>, int32>* Found = EffectStackCounts.FindByPredicate(
+			[Stone](const TPair<TSubclassOf<UGameplayEffect>, int32>& Entry) { return Entry.Key == Stone->StoneGameplayEffectClass; });
+
+		if (Found)
+		{
+			Found->Value += Stone->StackCount;
+		}
+		else
+		{
+			EffectStackCounts.Emplace(Stone->StoneGameplayEffectClass, Stone->StackCount);
+		}
+	}
+
+	for (const TPair<TSubclassOf<UGameplayEffect>, int32>& Entry : EffectStackCounts)
+	{
+		const FGameplayEffectSpecHandle SpecHandle =
+			AbilitySystemComponent->MakeOutgoingSpec(Entry.Key, ApplyLevel, AbilitySystemComponent->MakeEffectContext());
+
+		if (!SpecHandle.IsValid())
+		{
+			continue;
+		}
+
+		const UGameplayEffect* EffectCDO = SpecHandle.Data->Def;
+
+		// 可堆叠的持续效果：一次应用全部层数 --> 规格是这次消耗新建的，可以直接修改层数
+		if (EffectCDO->DurationPolicy != EGameplayEffectDurationType::Instant &&
+			EffectCDO->GetStackingType() != EGameplayEffectStackingType::None)
+		{
+			SpecHandle.Data->SetStackCount(Entry.Value);
+			AbilitySystemComponent->ApplyGameplayEffectSpecToSelf(*SpecHandle.Data);
+			continue;
+		}
+
+		// 瞬时或不可堆叠的效果没有层数的概念，复用同一份规格逐次执行
+		for (int32 Index = 0; Index < Entry.Value; Index++)
+		{
+			AbilitySystemComponent->ApplyGameplayEffectSpecToSelf(*SpecHandle.Data);
+		}
+	}
+
+	for (AFightStoneBase* Stone : InStones)
+	{
+		if (!Stone)
+		{
+			continue;
+		}
+
+		// 池中的石头由服务器回收，表现由复制的回收状态驱动 --> OnStoneConsumed在蓝图中会销毁石头
+		if (Stone->bIsPooled)
+		{
+			if (Stone->HasAuthority())
+			{
+				if (UFightPickUpPoolSubsystem* PickUpPool = Stone->GetWorld()->GetSubsystem<UFightPickUpPoolSubsystem>())
+				{
+					Stone->SetConsumed(true);
+					PickUpPool->ReleaseStone(Stone);
+				}
+			}
+			continue;
+		}
+
+		Stone->BP_OnStoneConsumed();
+	}
+}
+
+void AFightStoneBase::SetStackCount(int32 InStackCount)
+{
+	InStackCount = FMath::Max(InStackCount, 1);
+
+	if (StackCount == InStackCount)
+	{
+		return;
+	}
 
-	UGameplayEffect* EffectCDO = StoneGameplayEffectClass->GetDefaultObject<UGameplayEffect>();
+	FlushNetDormancy();
 
-	AbilitySystemComponent->ApplyGameplayEffectToSelf(
-		EffectCDO,
-		ApplyLevel,
-		AbilitySystemComponent->MakeEffectContext()
-	);
+	StackCount = InStackCount;
+	MARK_PROPERTY_DIRTY_FROM_NAME(ThisClass, StackCount, this);
+}
 
-	BP_OnStoneConsumed();
+void AFightStoneBase::AddStacks(int32 InStacksToAdd)
+{
+	SetStackCount(StackCount + InStacksToAdd);
+}
+
+void AFightStoneBase::OnPickUpDeactivated()
+{
+	if (bIsPooled && bConsumed)
+	{
+		BP_OnPooledStoneConsumed();
+	}
+}
+
+void AFightStoneBase::MarkAsPooled()
+{
+	bIsPooled = true;
+	MARK_PROPERTY_DIRTY_FROM_NAME(ThisClass, bIsPooled, this);
+}
+
+void AFightStoneBase::SetConsumed(bool bInConsumed)
+{
+	if (bConsumed == bInConsumed)
+	{
+		return;
+	}
+
+	FlushNetDormancy();
+
+	bConsumed = bInConsumed;
+	MARK_PROPERTY_DIRTY_FROM_NAME(ThisClass, bConsumed, this);
 }
 
 void AFightStoneBase::OnPickUpCollisionSphereBeginOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor,
@@ -27,6 +168,15 @@ void AFightStoneBase::OnPickUpCollisionSphereBeginOverlap(UPrimitiveComponent* O
 {
 	if (AMainCharacter* OverlappedMainCharacter = Cast<AMainCharacter>(OtherActor))
 	{
-		OverlappedMainCharacter->GetFightAbilitySystemComponent()->TryActivateAbilityByTag(FightGameplayTags::Player_Ability_PickUp_Stones);
+		OverlappedMainCharacter->RegisterOverlappingStone(this);
+	}
+}
+
+void AFightStoneBase::OnPickUpCollisionSphereEndOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor,
+	UPrimitiveComponent* OtherComp, int32 OtherBodyIndex)
+{
+	if (AMainCharacter* OverlappedMainCharacter = Cast<AMainCharacter>(OtherActor))
+	{
+		OverlappedMainCharacter->UnregisterOverlappingStone(this);
 	}
 }
@@ -2,6 +2,8 @@
 
 
 #include "Items/Weapons/FightPlayerWeapon.h"
+#include "Widgets/FightUIAssetCacheSubsystem.h"
+#include "Engine/GameInstance.h"
 
 void AFightPlayerWeapon::AssignGrantedAbilitySpecHandle(const TArray<FGameplayAbilitySpecHandle>& InSpecHandles)
 {
@@ -12,3 +14,57 @@ TArray<FGameplayAbilitySpecHandle> AFightPlayerWeapon::GetGrantedAbilitySpecHand
 {
 	return GrantedAbilitySpecHandles;
 }
+
+void AFightPlayerWeapon::BeginPlay()
+{
+	Super::BeginPlay();
+
+	// 武器生成时就开始加载其UI资源，装备时控件直接拿到已加载的对象
+	AcquiredUIAssetPaths.Reset();
+
+	// 专用服务器没有UI --> 不加载图标纹理/材质
+	if (IsNetMode(NM_DedicatedServer))
+	{
+		return;
+	}
+
+	if (!PlayerWeaponData.SoftWeaponIconTexture.IsNull())
+	{
+		AcquiredUIAssetPaths.Add(PlayerWeaponData.SoftWeaponIconTexture.ToSoftObjectPath());
+	}
+
+	for (const FFightPlayerSpecialAbilitySet& SpecialAbilitySet : PlayerWeaponData.SpecialWeaponAbilities)
+	{
+		if (!SpecialAbilitySet.SoftAbilityIconMaterial.IsNull())
+		{
+			AcquiredUIAssetPaths.Add(SpecialAbilitySet.SoftAbilityIconMaterial.ToSoftObjectPath());
+		}
+	}
+
+	UFightUIAssetCacheSubsystem* UIAssetCache = UGameInstance::GetSubsystem<UFightUIAssetCacheSubsystem>(GetGameInstance());
+	if (!UIAssetCache)
+	{
+		AcquiredUIAssetPaths.Reset();
+		return;
+	}
+
+	for (const FSoftObjectPath& AssetPath : AcquiredUIAssetPaths)
+	{
+		UIAssetCache->AcquireAsset(AssetPath);
+	}
+}
+
+void AFightPlayerWeapon::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UFightUIAssetCacheSubsystem* UIAssetCache = UGameInstance::GetSubsystem<UFightUIAssetCacheSubsystem>(GetGameInstance()))
+	{
+		for (const FSoftObjectPath& AssetPath : AcquiredUIAssetPaths)
+		{
+			UIAssetCache->ReleaseAsset(AssetPath);
+		}
+	}
+
+	AcquiredUIAssetPaths.Empty();
+
+	Super::EndPlay(EndPlayReason);
+}
@@ -4,6 +4,7 @@
 #include "Items/Weapons/FightWeaponBase.h"
 #include "Components/BoxComponent.h"
 #include "FightFunctionLibrary.h"
+#include "Game/FightTimerSubsystem.h"
 
 #include "GASDebugHelper.h"
 
@@ -25,6 +26,10 @@ AFightWeaponBase::AFightWeaponBase()
 	// 禁用Actor的Tick功能以提高性能 --> 对于不需要每帧更新的武器Actor，禁用Tick可以提升游戏性能
 	PrimaryActorTick.bCanEverTick = false;
 
+	// 武器跟随持有者复制，相关性也直接使用持有者的 --> 不单独做距离检查
+	bReplicates = true;
+	bNetUseOwnerRelevancy = true;
+
 	// 创建武器网格体组件
 	WeaponMesh = CreateDefaultSubobject<UStaticMeshComponent>(TEXT("WeaponMesh"));
 	// 设置武器网格体为根组件 --> SetRootComponent设置Actor的根组件，所有其它组件都将相对于此组件定位
@@ -80,3 +85,51 @@ void AFightWeaponBase::OnCollisionBoxEndOverlap(UPrimitiveComponent* OverlappedC
 
 	// TODO：实现对敌人角色的命中检查
 }
+
+void AFightWeaponBase::SetWeaponNetDormant(bool bShouldBeDormant)
+{
+	if (!HasAuthority())
+	{
+		return;
+	}
+
+	UFightTimerSubsystem* TimerSubsystem = GetWorld()->GetSubsystem<UFightTimerSubsystem>();
+	if (TimerSubsystem)
+	{
+		TimerSubsystem->ClearTimer(NetDormancyTimerHandle);
+	}
+
+	if (!bShouldBeDormant)
+	{
+		SetNetDormancy(DORM_Awake);
+		return;
+	}
+
+	// 先把已有的变化发送出去，延迟结束后再休眠
+	FlushNetDormancy();
+
+	if (TimerSubsystem && NetDormancyDelay > 0.f)
+	{
+		NetDormancyTimerHandle = TimerSubsystem->SetTimer(
+			FFightTimerDelegate::CreateUObject(this, &ThisClass::OnNetDormancyTimerFired), NetDormancyDelay);
+	}
+	else
+	{
+		OnNetDormancyTimerFired();
+	}
+}
+
+void AFightWeaponBase::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UFightTimerSubsystem* TimerSubsystem = GetWorld()->GetSubsystem<UFightTimerSubsystem>())
+	{
+		TimerSubsystem->ClearTimer(NetDormancyTimerHandle);
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void AFightWeaponBase::OnNetDormancyTimerFired()
+{
+	SetNetDormancy(DORM_DormantAll);
+}
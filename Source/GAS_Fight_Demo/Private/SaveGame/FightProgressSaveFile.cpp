@@ -0,0 +1,346 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "SaveGame/FightProgressSaveFile.h"
+#include "GAS_Fight_Demo.h"
+#include "Async/Async.h"
+#include "Serialization/MemoryWriter.h"
+#include "Serialization/MemoryReader.h"
+#include "Misc/FileHelper.h"
+#include "HAL/FileManager.h"
+#include "Misc/Crc.h"
+
+
+// "FPSV"
+static constexpr uint32 FightProgressFileMagic = 0x56535046;
+
+// 修改任何记录的负载格式时递增，并在ApplyRecord中按版本兼容旧数据
+static constexpr uint16 FightProgressFileVersion = 1;
+
+static constexpr int64 FightProgressFileHeaderSize = sizeof(uint32) + sizeof(uint16);
+static constexpr int64 FightProgressRecordHeaderSize = sizeof(uint8) + sizeof(uint32) + sizeof(uint32);
+
+// 文件中的记录超过该数量时压缩为一条快照
+static constexpr int32 FightProgressCompactThreshold = 64;
+
+FFightProgressSaveFile::FFightProgressSaveFile(const FString& InFilePath)
+	: FilePath(InFilePath)
+	, WritePipe(TEXT("FightProgressSaveFile"))
+{
+}
+
+FFightProgressSaveFile::~FFightProgressSaveFile()
+{
+	WaitForPendingWrites();
+}
+
+bool FFightProgressSaveFile::Load()
+{
+	TArray<uint8> FileData;
+	const bool bFileExists = FFileHelper::LoadFileToArray(FileData, *FilePath, FILEREAD_Silent);
+
+	return CompleteLoad(bFileExists ? &FileData : nullptr);
+}
+
+void FFightProgressSaveFile::LoadAsync()
+{
+	bIsLoading = true;
+
+	// 读取同样排在写入管道中，与之前排队的写入保持顺序
+	WritePipe.Launch(UE_SOURCE_LOCATION,
+		[this, Path = FilePath, WeakLifetimeToken = TWeakPtr<bool, ESPMode::ThreadSafe>(LifetimeToken)]()
+		{
+			TArray<uint8> FileData;
+			const bool bFileExists = FFileHelper::LoadFileToArray(FileData, *Path, FILEREAD_Silent);
+
+			AsyncTask(ENamedThreads::GameThread,
+				[this, WeakLifetimeToken, bFileExists, FileData = MoveTemp(FileData)]()
+				{
+					// 文件对象已销毁，或读取已在WaitForPendingWrites中同步完成
+					if (!WeakLifetimeToken.IsValid() || !bIsLoading)
+					{
+						return;
+					}
+
+					if (!CompleteLoad(bFileExists ? &FileData : nullptr))
+					{
+						UE_LOG(LogFight, Warning, TEXT("Progress save file %s is newer or corrupted, progress will not be written"), *FilePath);
+					}
+				}
+			);
+		}
+	);
+}
+
+bool FFightProgressSaveFile::CompleteLoad(const TArray<uint8>* InFileData)
+{
+	const bool bLoaded = ReplayFileData(InFileData);
+	bIsLoading = false;
+
+	// 读取期间追加的记录排在文件已有的记录之后
+	TArray<TPair<EFightProgressRecordType, TArray<uint8>>> RecordsToAppend = MoveTemp(PendingRecords);
+	for (TPair<EFightProgressRecordType, TArray<uint8>>& Record : RecordsToAppend)
+	{
+		AppendRecord(Record.Key, Record.Value);
+	}
+
+	return bLoaded;
+}
+
+bool FFightProgressSaveFile::ReplayFileData(const TArray<uint8>* InFileData)
+{
+	ProgressData = FFightProgressData();
+	NumRecordsInFile = 0;
+	bHasValidHeader = false;
+	bIsReadOnly = false;
+
+	if (!InFileData)
+	{
+		// 文件不存在，第一次追加时会写入文件头
+		return true;
+	}
+
+	const TArray<uint8>& FileData = *InFileData;
+
+	// 文件头写到一半就崩溃，直接重写
+	if (FileData.Num() < FightProgressFileHeaderSize)
+	{
+		CompactFile();
+		return true;
+	}
+
+	FMemoryReader FileReader(FileData);
+
+	uint32 Magic = 0;
+	uint16 Version = 0;
+	FileReader << Magic;
+	FileReader << Version;
+
+	if (Magic != FightProgressFileMagic || Version > FightProgressFileVersion)
+	{
+		bIsReadOnly = true;
+		return false;
+	}
+
+	bHasValidHeader = true;
+
+	int64 ValidDataEnd = FileReader.Tell();
+	while (FileData.Num() - FileReader.Tell() >= FightProgressRecordHeaderSize)
+	{
+		uint8 RecordType = 0;
+		uint32 PayloadSize = 0;
+		uint32 PayloadCrc = 0;
+		FileReader << RecordType;
+		FileReader << PayloadSize;
+		FileReader << PayloadCrc;
+
+		const int64 PayloadOffset = FileReader.Tell();
+		if (FileData.Num() - PayloadOffset < PayloadSize)
+		{
+			break;
+		}
+
+		const uint8* PayloadData = FileData.GetData() + PayloadOffset;
+		if (FCrc::MemCrc32(PayloadData, PayloadSize) != PayloadCrc)
+		{
+			break;
+		}
+
+		FMemoryReaderView PayloadReader(MakeArrayView(PayloadData, PayloadSize));
+		ApplyRecord(static_cast<EFightProgressRecordType>(RecordType), PayloadReader);
+
+		FileReader.Seek(PayloadOffset + PayloadSize);
+		ValidDataEnd = FileReader.Tell();
+		NumRecordsInFile++;
+	}
+
+	// 末尾有损坏的记录时也需要重写，否则之后追加的记录都会被跳过
+	if (NumRecordsInFile > FightProgressCompactThreshold || ValidDataEnd < FileData.Num())
+	{
+		CompactFile();
+	}
+
+	return true;
+}
+
+void FFightProgressSaveFile::AppendRunStarted()
+{
+	TArray<uint8> Payload;
+	AppendRecord(EFightProgressRecordType::RunStarted, Payload);
+}
+
+void FFightProgressSaveFile::AppendWaveCheckpoint(const FFightRunStats& InRunStats)
+{
+	TArray<uint8> Payload;
+	FMemoryWriter PayloadWriter(Payload);
+
+	FFightRunStats RunStats = InRunStats;
+	PayloadWriter << RunStats;
+
+	AppendRecord(EFightProgressRecordType::WaveCheckpoint, Payload);
+}
+
+void FFightProgressSaveFile::AppendWeaponUnlocked(FName InWeaponTagName)
+{
+	if (ProgressData.UnlockedWeaponTags.Contains(InWeaponTagName))
+	{
+		return;
+	}
+
+	TArray<uint8> Payload;
+	FMemoryWriter PayloadWriter(Payload);
+	PayloadWriter << InWeaponTagName;
+
+	AppendRecord(EFightProgressRecordType::WeaponUnlocked, Payload);
+}
+
+void FFightProgressSaveFile::WaitForPendingWrites()
+{
+	WritePipe.WaitUntilEmpty();
+
+	// 读取结果还没在游戏线程回放，同步重新读取一次，之后到达的异步结果会被忽略
+	if (bIsLoading)
+	{
+		Load();
+		WritePipe.WaitUntilEmpty();
+	}
+}
+
+void FFightProgressSaveFile::ApplyRecord(EFightProgressRecordType InRecordType, FArchive& PayloadReader)
+{
+	switch (InRecordType)
+	{
+	case EFightProgressRecordType::Snapshot:
+		PayloadReader << ProgressData;
+		break;
+
+	case EFightProgressRecordType::RunStarted:
+		ProgressData.TotalRunsStarted++;
+		ProgressData.CurrentRun = FFightRunStats();
+		break;
+
+	case EFightProgressRecordType::WaveCheckpoint:
+	{
+		FFightRunStats RunStats;
+		PayloadReader << RunStats;
+
+		ProgressData.CurrentRun = RunStats;
+		ProgressData.HighestWaveReached = FMath::Max(ProgressData.HighestWaveReached, RunStats.WaveReached);
+
+		if (RunStats.WaveReached > ProgressData.BestRun.WaveReached ||
+			(RunStats.WaveReached == ProgressData.BestRun.WaveReached && RunStats.EnemiesDefeated > ProgressData.BestRun.EnemiesDefeated))
+		{
+			ProgressData.BestRun = RunStats;
+		}
+		break;
+	}
+
+	case EFightProgressRecordType::WeaponUnlocked:
+	{
+		FName WeaponTagName;
+		PayloadReader << WeaponTagName;
+		ProgressData.UnlockedWeaponTags.AddUnique(WeaponTagName);
+		break;
+	}
+
+	default:
+		break;
+	}
+}
+
+void FFightProgressSaveFile::AppendRecord(EFightProgressRecordType InRecordType, TArray<uint8>& InPayload)
+{
+	if (bIsLoading)
+	{
+		PendingRecords.Emplace(InRecordType, MoveTemp(InPayload));
+		return;
+	}
+
+	{
+		FMemoryReader PayloadReader(InPayload);
+		ApplyRecord(InRecordType, PayloadReader);
+	}
+
+	if (bIsReadOnly)
+	{
+		return;
+	}
+
+	// 快照已经包含了这条记录的结果
+	if (NumRecordsInFile >= FightProgressCompactThreshold)
+	{
+		CompactFile();
+		return;
+	}
+
+	TArray<uint8> Bytes;
+	FMemoryWriter Writer(Bytes);
+
+	if (!bHasValidHeader)
+	{
+		WriteHeader(Writer);
+		bHasValidHeader = true;
+	}
+
+	WriteRecord(Writer, InRecordType, InPayload);
+	NumRecordsInFile++;
+
+	WritePipe.Launch(UE_SOURCE_LOCATION,
+		[Path = FilePath, Bytes = MoveTemp(Bytes)]()
+		{
+			FFileHelper::SaveArrayToFile(Bytes, *Path, &IFileManager::Get(), FILEWRITE_Append);
+		}
+	);
+}
+
+void FFightProgressSaveFile::CompactFile()
+{
+	if (bIsReadOnly)
+	{
+		return;
+	}
+
+	TArray<uint8> Payload;
+	FMemoryWriter PayloadWriter(Payload);
+	PayloadWriter << ProgressData;
+
+	TArray<uint8> Bytes;
+	FMemoryWriter Writer(Bytes);
+	WriteHeader(Writer);
+	WriteRecord(Writer, EFightProgressRecordType::Snapshot, Payload);
+
+	bHasValidHeader = true;
+	NumRecordsInFile = 1;
+
+	// 先写临时文件再替换，重写过程中崩溃不会丢失原存档
+	WritePipe.Launch(UE_SOURCE_LOCATION,
+		[Path = FilePath, Bytes = MoveTemp(Bytes)]()
+		{
+			const FString TempPath = Path + TEXT(".tmp");
+			if (FFileHelper::SaveArrayToFile(Bytes, *TempPath))
+			{
+				IFileManager::Get().Move(*Path, *TempPath, true);
+			}
+		}
+	);
+}
+
+void FFightProgressSaveFile::WriteHeader(FArchive& Ar)
+{
+	uint32 Magic = FightProgressFileMagic;
+	uint16 Version = FightProgressFileVersion;
+	Ar << Magic;
+	Ar << Version;
+}
+
+void FFightProgressSaveFile::WriteRecord(FArchive& Ar, EFightProgressRecordType InRecordType, TArray<uint8>& InPayload)
+{
+	uint8 RecordType = static_cast<uint8>(InRecordType);
+	uint32 PayloadSize = InPayload.Num();
+	uint32 PayloadCrc = FCrc::MemCrc32(InPayload.GetData(), InPayload.Num());
+
+	Ar << RecordType;
+	Ar << PayloadSize;
+	Ar << PayloadCrc;
+	Ar.Serialize(InPayload.GetData(), InPayload.Num());
+}
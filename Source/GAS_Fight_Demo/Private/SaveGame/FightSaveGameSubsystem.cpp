@@ -0,0 +1,197 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "SaveGame/FightSaveGameSubsystem.h"
+#include "SaveGame/FightSaveGame.h"
+#include "Kismet/GameplayStatics.h"
+#include "TimerManager.h"
+#include "Misc/Paths.h"
+#include "GAS/FightGameplayTags.h"
+
+
+// 修改存档后延迟多久写盘，期间的多次修改只会触发一次写入
+static constexpr float FightSaveGameFlushDelay = 1.f;
+
+void UFightSaveGameSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	SaveSlotName = FightGameplayTags::GameData_SaveGame_Slot_1.GetTag().ToString();
+
+	// 存档不存在时回调中的对象为nullptr，无需再单独调用DoesSaveGameExist
+	UGameplayStatics::AsyncLoadGameFromSlot(SaveSlotName, 0,
+		FAsyncLoadGameFromSlotDelegate::CreateUObject(this, &ThisClass::OnInitialLoadCompleted));
+
+	// 进度文件在写入管道中异步读取，读取完成前追加的记录由进度文件缓存
+	ProgressSaveFile = MakeUnique<FFightProgressSaveFile>(
+		FPaths::ProjectSavedDir() / TEXT("SaveGames") / SaveSlotName + TEXT("_Progress.bin"));
+	ProgressSaveFile->LoadAsync();
+}
+
+void UFightSaveGameSubsystem::Deinitialize()
+{
+	if (UGameInstance* GameInstance = GetGameInstance())
+	{
+		GameInstance->GetTimerManager().ClearTimer(FlushTimerHandle);
+	}
+
+	// 退出时不能再依赖异步写入，未落盘的修改同步写入一次
+	if (bIsDirty && CachedSaveGame)
+	{
+		UGameplayStatics::SaveGameToSlot(CachedSaveGame, SaveSlotName, 0);
+		bIsDirty = false;
+	}
+
+	if (ProgressSaveFile)
+	{
+		ProgressSaveFile->WaitForPendingWrites();
+		ProgressSaveFile.Reset();
+	}
+
+	Super::Deinitialize();
+}
+
+bool UFightSaveGameSubsystem::TryGetSavedGameDifficulty(EFightGameDifficulty& OutSavedDifficulty)
+{
+	if (!bInitialLoadCompleted || !CachedSaveGame)
+	{
+		return false;
+	}
+
+	OutSavedDifficulty = CachedSaveGame->SavedCurrentGameDifficulty;
+
+	return true;
+}
+
+void UFightSaveGameSubsystem::SetSavedGameDifficulty(EFightGameDifficulty InDifficultyToSave)
+{
+	GetOrCreateCachedSaveGame()->SavedCurrentGameDifficulty = InDifficultyToSave;
+
+	MarkSaveGameDirty();
+}
+
+UFightSaveGame* UFightSaveGameSubsystem::GetOrCreateCachedSaveGame()
+{
+	if (!CachedSaveGame)
+	{
+		CachedSaveGame = Cast<UFightSaveGame>(UGameplayStatics::CreateSaveGameObject(UFightSaveGame::StaticClass()));
+	}
+
+	return CachedSaveGame;
+}
+
+void UFightSaveGameSubsystem::MarkSaveGameDirty()
+{
+	bIsDirty = true;
+
+	FTimerManager& TimerManager = GetGameInstance()->GetTimerManager();
+	if (!TimerManager.IsTimerActive(FlushTimerHandle))
+	{
+		TimerManager.SetTimer(FlushTimerHandle, this, &ThisClass::FlushPendingWrites, FightSaveGameFlushDelay, false);
+	}
+}
+
+void UFightSaveGameSubsystem::FlushPendingWrites()
+{
+	GetGameInstance()->GetTimerManager().ClearTimer(FlushTimerHandle);
+
+	if (!bIsDirty || !CachedSaveGame)
+	{
+		return;
+	}
+
+	// 已有写入在进行中、或初始读取尚未完成时等待，完成回调中会再次检查脏标记
+	if (bIsSaveInFlight || !bInitialLoadCompleted)
+	{
+		return;
+	}
+
+	// AsyncSaveGameToSlot会在调用时于游戏线程完成序列化，之后再修改缓存对象不会影响本次写入
+	bIsDirty = false;
+	bIsSaveInFlight = true;
+
+	UGameplayStatics::AsyncSaveGameToSlot(CachedSaveGame, SaveSlotName, 0,
+		FAsyncSaveGameToSlotDelegate::CreateUObject(this, &ThisClass::OnAsyncSaveCompleted));
+}
+
+void UFightSaveGameSubsystem::CallOrRegister_OnSaveGameLoaded(FOnFightSaveGameLoadedDelegate::FDelegate&& InDelegate)
+{
+	if (bInitialLoadCompleted)
+	{
+		InDelegate.ExecuteIfBound();
+	}
+	else
+	{
+		OnSaveGameLoaded.Add(MoveTemp(InDelegate));
+	}
+}
+
+void UFightSaveGameSubsystem::OnInitialLoadCompleted(const FString& InSlotName, const int32 InUserIndex,
+	USaveGame* InLoadedSaveGame)
+{
+	bInitialLoadCompleted = true;
+
+	// 读取完成前已经写入过的存档以写入为准 --> 存档中只有难度一项，写入的值就是完整的存档
+	if (!CachedSaveGame)
+	{
+		CachedSaveGame = Cast<UFightSaveGame>(InLoadedSaveGame);
+	}
+
+	// 读取期间被推迟的写入
+	if (bIsDirty)
+	{
+		MarkSaveGameDirty();
+	}
+
+	OnSaveGameLoaded.Broadcast();
+	OnSaveGameLoaded.Clear();
+}
+
+void UFightSaveGameSubsystem::OnAsyncSaveCompleted(const FString& InSlotName, const int32 InUserIndex, bool bSuccess)
+{
+	bIsSaveInFlight = false;
+
+	// 写入失败时保留修改，稍后重试
+	if (!bSuccess)
+	{
+		bIsDirty = true;
+	}
+
+	if (bIsDirty)
+	{
+		MarkSaveGameDirty();
+	}
+}
+
+void UFightSaveGameSubsystem::RecordRunStarted()
+{
+	ProgressSaveFile->AppendRunStarted();
+}
+
+void UFightSaveGameSubsystem::RecordWaveCheckpoint(int32 InWaveReached, int32 InEnemiesDefeated, float InRunDurationSeconds)
+{
+	FFightRunStats RunStats;
+	RunStats.WaveReached = InWaveReached;
+	RunStats.EnemiesDefeated = InEnemiesDefeated;
+	RunStats.RunDurationSeconds = InRunDurationSeconds;
+
+	ProgressSaveFile->AppendWaveCheckpoint(RunStats);
+}
+
+void UFightSaveGameSubsystem::RecordWeaponUnlocked(FGameplayTag InWeaponTag)
+{
+	if (InWeaponTag.IsValid())
+	{
+		ProgressSaveFile->AppendWeaponUnlocked(InWeaponTag.GetTagName());
+	}
+}
+
+int32 UFightSaveGameSubsystem::GetHighestWaveReached() const
+{
+	return ProgressSaveFile->GetProgressData().HighestWaveReached;
+}
+
+bool UFightSaveGameSubsystem::IsWeaponUnlocked(FGameplayTag InWeaponTag) const
+{
+	return ProgressSaveFile->GetProgressData().UnlockedWeaponTags.Contains(InWeaponTag.GetTagName());
+}
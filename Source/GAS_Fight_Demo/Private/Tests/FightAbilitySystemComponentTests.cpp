@@ -0,0 +1,147 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Tests/FightTestWorld.h"
+#include "GAS/FightAbilitySystemComponent.h"
+#include "GAS/FightGameplayTags.h"
+#include "GAS/Abilities/FightPlayerGameplayAbility.h"
+#include "GameFramework/Actor.h"
+#include "GameplayEffect.h"
+#include "GameplayEffectComponents/TargetTagsGameplayEffectComponent.h"
+
+
+// 武器切换的次数 --> 足以让单次切换的耗时稳定下来
+static constexpr int32 FightWeaponSwapBenchmarkIterations = 2000;
+
+// 冷却测试：冷却时长、效果应用时的世界时间与查询前经过的时间
+static constexpr float FightCooldownTestDuration = 5.f;
+static constexpr double FightCooldownTestStartTime = 10.0;
+static constexpr float FightCooldownTestElapsedTime = 2.f;
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFightWeaponAbilitySwapBenchmark, "GASFightDemo.Ability.WeaponSwapBenchmark",
+	EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FFightWeaponAbilitySwapBenchmark::RunTest(const FString& Parameters)
+{
+	FFightTestWorld TestWorld;
+
+	AActor* OwnerActor = TestWorld.Get()->SpawnActor<AActor>();
+	UFightAbilitySystemComponent* AbilitySystemComponent = NewObject<UFightAbilitySystemComponent>(OwnerActor);
+	AbilitySystemComponent->RegisterComponent();
+	AbilitySystemComponent->InitAbilityActorInfo(OwnerActor, OwnerActor);
+
+	const FGameplayTag WeaponInputTags[] = { FightGameplayTags::InputTag_LightAttack_Axe, FightGameplayTags::InputTag_HeavyAttack_Axe };
+
+	TArray<FFightPlayerAbilitySet> WeaponAbilities;
+	for (const FGameplayTag& InputTag : WeaponInputTags)
+	{
+		FFightPlayerAbilitySet& AbilitySet = WeaponAbilities.AddDefaulted_GetRef();
+		AbilitySet.InputTag = InputTag;
+		AbilitySet.AbilityToGrant = UFightPlayerGameplayAbility::StaticClass();
+	}
+
+	const TArray<FFightPlayerSpecialAbilitySet> NoSpecialAbilities;
+	TArray<FGameplayAbilitySpecHandle> GrantedHandles;
+
+	// 第一次装备真正授予能力，之后的切换只应启用/禁用已有规格
+	AbilitySystemComponent->GrantPlayerWeaponAbilities(WeaponAbilities, NoSpecialAbilities, 1, GrantedHandles);
+	const TArray<FGameplayAbilitySpecHandle> FirstGrantedHandles = GrantedHandles;
+	const int32 NumSpecsAfterFirstGrant = AbilitySystemComponent->GetActivatableAbilities().Num();
+	AbilitySystemComponent->RemovedGrantedHeroWeaponAbilities(GrantedHandles);
+
+	TestEqual(TEXT("Both weapon abilities are granted once"), NumSpecsAfterFirstGrant, WeaponAbilities.Num());
+
+	const double StartTime = FPlatformTime::Seconds();
+
+	for (int32 Iteration = 0; Iteration < FightWeaponSwapBenchmarkIterations; ++Iteration)
+	{
+		AbilitySystemComponent->GrantPlayerWeaponAbilities(WeaponAbilities, NoSpecialAbilities, 1, GrantedHandles);
+		AbilitySystemComponent->RemovedGrantedHeroWeaponAbilities(GrantedHandles);
+	}
+
+	const double ElapsedSeconds = FPlatformTime::Seconds() - StartTime;
+
+	TestEqual(TEXT("Equip swaps do not grant new ability specs"),
+		AbilitySystemComponent->GetActivatableAbilities().Num(), NumSpecsAfterFirstGrant);
+
+	for (const FGameplayAbilitySpecHandle& SpecHandle : FirstGrantedHandles)
+	{
+		TestTrue(TEXT("Unequipped weapon abilities are disabled"), AbilitySystemComponent->IsAbilitySpecDisabled(SpecHandle));
+	}
+
+	AbilitySystemComponent->GrantPlayerWeaponAbilities(WeaponAbilities, NoSpecialAbilities, 1, GrantedHandles);
+	TestTrue(TEXT("Re-equipping returns the original spec handles"), GrantedHandles == FirstGrantedHandles);
+
+	for (const FGameplayAbilitySpecHandle& SpecHandle : GrantedHandles)
+	{
+		TestFalse(TEXT("Equipped weapon abilities are enabled"), AbilitySystemComponent->IsAbilitySpecDisabled(SpecHandle));
+	}
+
+	AddInfo(FString::Printf(TEXT("%d equip/unequip swaps took %.3f ms (%.3f us per swap)"),
+		FightWeaponSwapBenchmarkIterations, ElapsedSeconds * 1000.0, ElapsedSeconds * 1.0e6 / FightWeaponSwapBenchmarkIterations));
+
+	OwnerActor->Destroy();
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFightCooldownQueryTest, "GASFightDemo.Ability.CooldownQuery",
+	EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FFightCooldownQueryTest::RunTest(const FString& Parameters)
+{
+	FFightTestWorld TestWorld;
+	UWorld* World = TestWorld.Get();
+
+	AActor* OwnerActor = World->SpawnActor<AActor>();
+	UFightAbilitySystemComponent* AbilitySystemComponent = NewObject<UFightAbilitySystemComponent>(OwnerActor);
+	AbilitySystemComponent->RegisterComponent();
+	AbilitySystemComponent->InitAbilityActorInfo(OwnerActor, OwnerActor);
+
+	// 授予子冷却标签的持续效果，等价于特殊能力的冷却效果
+	UGameplayEffect* CooldownEffect = NewObject<UGameplayEffect>(GetTransientPackage(), TEXT("FightCooldownTestEffect"));
+	CooldownEffect->DurationPolicy = EGameplayEffectDurationType::HasDuration;
+	CooldownEffect->DurationMagnitude = FGameplayEffectModifierMagnitude(FScalableFloat(FightCooldownTestDuration));
+
+	FInheritedTagContainer CooldownTagChanges;
+	CooldownTagChanges.Added.AddTag(FightGameplayTags::Player_Cooldown_SpecialWeaponAbility_Light);
+	CooldownEffect->FindOrAddComponent<UTargetTagsGameplayEffectComponent>().SetAndApplyTargetTagChanges(CooldownTagChanges);
+
+	World->TimeSeconds = FightCooldownTestStartTime;
+	const FActiveGameplayEffectHandle CooldownHandle = AbilitySystemComponent->ApplyGameplayEffectToSelf(
+		CooldownEffect, 1.f, AbilitySystemComponent->MakeEffectContext());
+	World->TimeSeconds = FightCooldownTestStartTime + FightCooldownTestElapsedTime;
+
+	const float ExpectedRemaining = FightCooldownTestDuration - FightCooldownTestElapsedTime;
+
+	float TotalCooldown = 0.f;
+	float RemainingCooldown = 0.f;
+	TestTrue(TEXT("The exact cooldown tag is on cooldown"), AbilitySystemComponent->GetCooldownRemainingByTag(
+		FightGameplayTags::Player_Cooldown_SpecialWeaponAbility_Light, TotalCooldown, RemainingCooldown));
+	TestEqual(TEXT("Total cooldown is the effect duration"), TotalCooldown, FightCooldownTestDuration);
+	TestEqual(TEXT("Remaining cooldown counts from the effect start time"), RemainingCooldown, ExpectedRemaining, KINDA_SMALL_NUMBER);
+
+	// 与MatchAnyOwningTags一致，父标签同样命中子标签的冷却
+	TotalCooldown = RemainingCooldown = 0.f;
+	TestTrue(TEXT("A parent cooldown tag matches the child cooldown"), AbilitySystemComponent->GetCooldownRemainingByTag(
+		FightGameplayTags::Player_Cooldown, TotalCooldown, RemainingCooldown));
+	TestEqual(TEXT("The parent query reports the child's remaining time"), RemainingCooldown, ExpectedRemaining, KINDA_SMALL_NUMBER);
+
+	TestFalse(TEXT("A sibling cooldown tag does not match"), AbilitySystemComponent->GetCooldownRemainingByTag(
+		FightGameplayTags::Player_Cooldown_SpecialWeaponAbility_Heavy, TotalCooldown, RemainingCooldown));
+
+	AbilitySystemComponent->RemoveActiveGameplayEffect(CooldownHandle);
+	TestFalse(TEXT("Removing the effect ends the cooldown"), AbilitySystemComponent->GetCooldownRemainingByTag(
+		FightGameplayTags::Player_Cooldown_SpecialWeaponAbility_Light, TotalCooldown, RemainingCooldown));
+
+	OwnerActor->Destroy();
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,103 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Tests/FightTestWorld.h"
+#include "Game/FightEventBusSubsystem.h"
+#include "GAS/FightGameplayTags.h"
+#include "AbilitySystemComponent.h"
+
+
+/**
+ * @brief 生成一个挂有ASC的Actor --> 事件总线通过全局查找取到组件，没有能力响应事件时触发数为0
+ */
+static AActor* SpawnEventBusTestReceiver(UWorld* InWorld)
+{
+	AActor* Receiver = InWorld->SpawnActor<AActor>();
+
+	UAbilitySystemComponent* AbilitySystemComponent = NewObject<UAbilitySystemComponent>(Receiver);
+	AbilitySystemComponent->RegisterComponent();
+	AbilitySystemComponent->InitAbilityActorInfo(Receiver, Receiver);
+
+	return Receiver;
+}
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFightEventBusDeferredDispatchTest, "GASFightDemo.Game.EventBusDeferredDispatch",
+	EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FFightEventBusDeferredDispatchTest::RunTest(const FString& Parameters)
+{
+	FFightTestWorld TestWorld;
+	UWorld* World = TestWorld.Get();
+
+	UFightEventBusSubsystem* EventBus = World->GetSubsystem<UFightEventBusSubsystem>();
+	if (!TestNotNull(TEXT("Event bus exists in game worlds"), EventBus))
+	{
+		return false;
+	}
+
+	const FGameplayTag EventTag = FightGameplayTags::Player_Event_HitPause;
+
+	AActor* Receiver = SpawnEventBusTestReceiver(World);
+	AActor* ReceiverWithoutASC = World->SpawnActor<AActor>();
+	AActor* DestroyedReceiver = SpawnEventBusTestReceiver(World);
+	AActor* Instigator = World->SpawnActor<AActor>();
+
+	EventBus->ResetEventCounters();
+
+	// 一次挥砍命中多个目标 --> 三个完全相同的延迟事件只派发一次
+	for (int32 HitIndex = 0; HitIndex < 3; ++HitIndex)
+	{
+		EventBus->SendEvent(Receiver, EventTag, Instigator, nullptr, EFightEventDispatch::Deferred);
+	}
+
+	// 发起者不同的事件不合并
+	EventBus->SendEvent(Receiver, EventTag, nullptr, nullptr, EFightEventDispatch::Deferred);
+	EventBus->SendEvent(ReceiverWithoutASC, EventTag, nullptr, nullptr, EFightEventDispatch::Deferred);
+	EventBus->SendEvent(DestroyedReceiver, EventTag, nullptr, nullptr, EFightEventDispatch::Deferred);
+
+	const FFightEventCounter* Counter = EventBus->FindEventCounter(EventTag);
+	if (!TestNotNull(TEXT("Coalescing is counted as soon as the duplicate is queued"), Counter))
+	{
+		return false;
+	}
+
+	TestEqual(TEXT("Duplicates are coalesced when queued"), Counter->CoalescedCount, int64(2));
+	TestEqual(TEXT("Nothing is dispatched before the flush"), Counter->DeferredCount, int64(0));
+
+	// 入队后销毁的接收者在派发时作废 --> 弱指针对已销毁的Actor不再解析
+	DestroyedReceiver->Destroy();
+
+	EventBus->FlushDeferredEvents();
+
+	Counter = EventBus->FindEventCounter(EventTag);
+	TestEqual(TEXT("Each distinct deferred event is dispatched once"), Counter->DeferredCount, int64(4));
+	TestEqual(TEXT("Receivers without an ASC and destroyed receivers are dropped"), Counter->DroppedCount, int64(2));
+	TestEqual(TEXT("Receivers with no abilities trigger nothing"), Counter->TriggeredAbilityCount, int64(0));
+
+	// 队列已清空，再次派发不会重复计数
+	EventBus->FlushDeferredEvents();
+	TestEqual(TEXT("A second flush dispatches nothing"), Counter->DeferredCount, int64(4));
+
+	// 派发后同样的事件可以在下一帧再次入队
+	EventBus->SendEvent(Receiver, EventTag, Instigator, nullptr, EFightEventDispatch::Deferred);
+	EventBus->FlushDeferredEvents();
+	TestEqual(TEXT("The same event is dispatched again in the next frame"), Counter->DeferredCount, int64(5));
+	TestEqual(TEXT("Events in different frames are not coalesced"), Counter->CoalescedCount, int64(2));
+
+	EventBus->SendEvent(ReceiverWithoutASC, EventTag, nullptr, nullptr, EFightEventDispatch::Immediate);
+	TestEqual(TEXT("Immediate events bypass the queue"), Counter->ImmediateCount, int64(1));
+	TestEqual(TEXT("Immediate events to receivers without an ASC are dropped"), Counter->DroppedCount, int64(3));
+
+	Receiver->Destroy();
+	ReceiverWithoutASC->Destroy();
+	Instigator->Destroy();
+
+	return true;
+}
+
+#endif
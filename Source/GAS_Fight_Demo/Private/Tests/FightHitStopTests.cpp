@@ -0,0 +1,164 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Tests/FightTestWorld.h"
+#include "Components/Combat/FightHitStopComponent.h"
+#include "Game/FightTimerSubsystem.h"
+#include "AIController.h"
+#include "GameFramework/Character.h"
+#include "Components/SkeletalMeshComponent.h"
+
+
+// 与组件的默认配置一致 --> 单次顿帧0.08秒，窗口上限0.2秒
+static constexpr float FightHitStopTestTimeDilation = 0.05f;
+static constexpr double FightHitStopTestStep = 0.05;
+
+
+/**
+ * @brief 同步推进世界时间与战斗定时器 --> 不Tick世界，避免其他Actor改写时间膨胀
+ */
+static void AdvanceHitStopTestTime(UWorld* InWorld, UFightTimerSubsystem* InTimerSubsystem, double InDeltaSeconds)
+{
+	InWorld->TimeSeconds += InDeltaSeconds;
+	InTimerSubsystem->Tick(InDeltaSeconds);
+}
+
+static UFightHitStopComponent* AddHitStopTestComponent(APawn* InPawn)
+{
+	UFightHitStopComponent* HitStopComponent = NewObject<UFightHitStopComponent>(InPawn);
+	HitStopComponent->RegisterComponent();
+	return HitStopComponent;
+}
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFightHitStopWindowTest, "GASFightDemo.Combat.HitStopWindow",
+	EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FFightHitStopWindowTest::RunTest(const FString& Parameters)
+{
+	FFightTestWorld TestWorld;
+	UWorld* World = TestWorld.Get();
+
+	UFightTimerSubsystem* TimerSubsystem = World->GetSubsystem<UFightTimerSubsystem>();
+	if (!TestNotNull(TEXT("Fight timer subsystem exists in game worlds"), TimerSubsystem))
+	{
+		return false;
+	}
+
+	// 单机模式下AI控制器是本地控制器，拥有者满足本地控制的条件
+	APawn* Attacker = World->SpawnActor<APawn>();
+	AAIController* Controller = World->SpawnActor<AAIController>();
+	Controller->Possess(Attacker);
+
+	UFightHitStopComponent* HitStopComponent = AddHitStopTestComponent(Attacker);
+
+	AActor* FirstTarget = World->SpawnActor<AActor>();
+	AActor* SecondTarget = World->SpawnActor<AActor>();
+	SecondTarget->CustomTimeDilation = 0.5f;
+
+	// 未被本地控制的拥有者不处理顿帧
+	APawn* RemotePawn = World->SpawnActor<APawn>();
+	UFightHitStopComponent* RemoteHitStopComponent = AddHitStopTestComponent(RemotePawn);
+	RemoteHitStopComponent->RequestHitStop(FirstTarget);
+	TestFalse(TEXT("A pawn that is not locally controlled ignores hit stop requests"), RemoteHitStopComponent->IsHitStopActive());
+	TestEqual(TEXT("The target keeps its time dilation"), FirstTarget->CustomTimeDilation, 1.f);
+
+	HitStopComponent->RequestHitStop(FirstTarget);
+	TestTrue(TEXT("The first request opens a window"), HitStopComponent->IsHitStopActive());
+	TestEqual(TEXT("The owner is dilated"), Attacker->CustomTimeDilation, FightHitStopTestTimeDilation);
+	TestEqual(TEXT("The hit target is dilated"), FirstTarget->CustomTimeDilation, FightHitStopTestTimeDilation);
+
+	// 0.05秒 --> 再次命中，窗口延长到0.13秒
+	AdvanceHitStopTestTime(World, TimerSubsystem, FightHitStopTestStep);
+	HitStopComponent->RequestHitStop(SecondTarget);
+	TestEqual(TEXT("A target hit inside the window is dilated"), SecondTarget->CustomTimeDilation, FightHitStopTestTimeDilation);
+
+	// 0.10秒 --> 单次顿帧本应在0.08秒结束，延长后仍在窗口内；再次命中延长到0.18秒
+	AdvanceHitStopTestTime(World, TimerSubsystem, FightHitStopTestStep);
+	TestTrue(TEXT("Overlapping requests extend the window"), HitStopComponent->IsHitStopActive());
+	HitStopComponent->RequestHitStop(FirstTarget);
+
+	// 0.15秒 --> 再次命中只能延长到上限0.2秒
+	AdvanceHitStopTestTime(World, TimerSubsystem, FightHitStopTestStep);
+	HitStopComponent->RequestHitStop(FirstTarget);
+
+	// 0.18秒 --> 已到上限的窗口不再延长
+	AdvanceHitStopTestTime(World, TimerSubsystem, 0.03);
+	TestTrue(TEXT("The window is still open before the cap"), HitStopComponent->IsHitStopActive());
+	HitStopComponent->RequestHitStop(FirstTarget);
+
+	// 0.22秒 --> 窗口在上限处结束
+	AdvanceHitStopTestTime(World, TimerSubsystem, 0.04);
+	TestFalse(TEXT("The merged window ends at the cap"), HitStopComponent->IsHitStopActive());
+	TestEqual(TEXT("The owner's time dilation is restored"), Attacker->CustomTimeDilation, 1.f);
+	TestEqual(TEXT("The first target's time dilation is restored"), FirstTarget->CustomTimeDilation, 1.f);
+	TestEqual(TEXT("The second target's original time dilation is restored"), SecondTarget->CustomTimeDilation, 0.5f);
+
+	// 期间被其他逻辑改写的时间膨胀不被还原
+	HitStopComponent->RequestHitStop(FirstTarget);
+	FirstTarget->CustomTimeDilation = 2.f;
+	HitStopComponent->EndHitStop();
+	TestEqual(TEXT("A time dilation changed during the window is left alone"), FirstTarget->CustomTimeDilation, 2.f);
+	TestEqual(TEXT("Ending the window early restores the owner"), Attacker->CustomTimeDilation, 1.f);
+
+	Controller->UnPossess();
+	Controller->Destroy();
+	Attacker->Destroy();
+	RemotePawn->Destroy();
+	FirstTarget->Destroy();
+	SecondTarget->Destroy();
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFightHitStopVisualsOnlyTest, "GASFightDemo.Combat.HitStopVisualsOnly",
+	EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FFightHitStopVisualsOnlyTest::RunTest(const FString& Parameters)
+{
+	FFightTestWorld TestWorld;
+	UWorld* World = TestWorld.Get();
+
+	UFightTimerSubsystem* TimerSubsystem = World->GetSubsystem<UFightTimerSubsystem>();
+	if (!TestNotNull(TEXT("Fight timer subsystem exists in game worlds"), TimerSubsystem))
+	{
+		return false;
+	}
+
+	ACharacter* Attacker = World->SpawnActor<ACharacter>();
+	AAIController* Controller = World->SpawnActor<AAIController>();
+	Controller->Possess(Attacker);
+
+	ACharacter* Target = World->SpawnActor<ACharacter>();
+	Target->GetMesh()->GlobalAnimRateScale = 0.5f;
+
+	UFightHitStopComponent* HitStopComponent = AddHitStopTestComponent(Attacker);
+	HitStopComponent->SetDilateVisualsOnlyForTesting(true);
+
+	// 联网时只放慢动画 --> Actor的时间膨胀保持不变，移动组件不会与服务器产生偏差
+	HitStopComponent->RequestHitStop(Target);
+	TestTrue(TEXT("The request opens a window"), HitStopComponent->IsHitStopActive());
+	TestEqual(TEXT("The owner's time dilation is untouched"), Attacker->CustomTimeDilation, 1.f);
+	TestEqual(TEXT("The target's time dilation is untouched"), Target->CustomTimeDilation, 1.f);
+	TestEqual(TEXT("The owner's animation is slowed"), Attacker->GetMesh()->GlobalAnimRateScale, FightHitStopTestTimeDilation);
+	TestEqual(TEXT("The target's animation is slowed"), Target->GetMesh()->GlobalAnimRateScale, FightHitStopTestTimeDilation);
+
+	// 0.10秒 --> 单次顿帧在0.08秒结束
+	AdvanceHitStopTestTime(World, TimerSubsystem, 2 * FightHitStopTestStep);
+	TestFalse(TEXT("The window ends after a single hit stop"), HitStopComponent->IsHitStopActive());
+	TestEqual(TEXT("The owner's animation rate is restored"), Attacker->GetMesh()->GlobalAnimRateScale, 1.f);
+	TestEqual(TEXT("The target's original animation rate is restored"), Target->GetMesh()->GlobalAnimRateScale, 0.5f);
+
+	Controller->UnPossess();
+	Controller->Destroy();
+	Attacker->Destroy();
+	Target->Destroy();
+
+	return true;
+}
+
+#endif
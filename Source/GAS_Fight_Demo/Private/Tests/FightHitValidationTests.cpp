@@ -0,0 +1,104 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Tests/FightTestWorld.h"
+#include "Game/FightHitValidationSubsystem.h"
+#include "GameFramework/Character.h"
+#include "GameFramework/CharacterMovementComponent.h"
+
+
+static constexpr float FightHitValidationTestDeltaTime = 0.1f;
+
+
+/**
+ * @brief 生成一个不受移动组件影响的角色 --> 测试世界没有地面，位置只由测试设置
+ */
+static ACharacter* SpawnHitValidationTestCharacter(UWorld* InWorld, const FVector& InLocation)
+{
+	ACharacter* Character = InWorld->SpawnActor<ACharacter>(InLocation, FRotator::ZeroRotator);
+	Character->GetCharacterMovement()->SetComponentTickEnabled(false);
+	return Character;
+}
+
+/**
+ * @brief 推进世界时间并确保子系统记录一次快照
+ */
+static void AdvanceHitValidationTestWorld(UWorld* InWorld, UFightHitValidationSubsystem* InSubsystem)
+{
+	InWorld->Tick(LEVELTICK_All, FightHitValidationTestDeltaTime);
+	// 世界Tick已经驱动过子系统时，记录间隔的判断会让这次调用直接返回
+	InSubsystem->Tick(0.f);
+}
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFightHitValidationRewindTest, "GASFightDemo.Combat.HitValidationRewind",
+	EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FFightHitValidationRewindTest::RunTest(const FString& Parameters)
+{
+	FFightTestWorld TestWorld;
+	UWorld* World = TestWorld.Get();
+
+	UFightHitValidationSubsystem* HitValidationSubsystem = World->GetSubsystem<UFightHitValidationSubsystem>();
+	if (!TestNotNull(TEXT("Hit validation subsystem exists in game worlds"), HitValidationSubsystem))
+	{
+		return false;
+	}
+
+	// 挥砍时攻击者与目标相距200，之后两者都远离原位
+	ACharacter* Attacker = SpawnHitValidationTestCharacter(World, FVector::ZeroVector);
+	ACharacter* Target = SpawnHitValidationTestCharacter(World, FVector(200.f, 0.f, 0.f));
+
+	HitValidationSubsystem->RegisterHitTarget(Attacker);
+	HitValidationSubsystem->RegisterHitTarget(Target);
+
+	AdvanceHitValidationTestWorld(World, HitValidationSubsystem);
+	const double SwingTime = World->GetTimeSeconds();
+
+	Target->SetActorLocation(FVector(5000.f, 0.f, 0.f));
+	Attacker->SetActorLocation(FVector(5000.f, 1000.f, 0.f));
+
+	AdvanceHitValidationTestWorld(World, HitValidationSubsystem);
+	const double CurrentTime = World->GetTimeSeconds();
+
+	TestTrue(TEXT("A hit claimed at the swing time is accepted after both actors moved"),
+		HitValidationSubsystem->ValidateMeleeHit(Attacker, Target, SwingTime));
+
+	TestFalse(TEXT("A hit claimed now is rejected when the actors are far apart"),
+		HitValidationSubsystem->ValidateMeleeHit(Attacker, Target, CurrentTime));
+
+	TestFalse(TEXT("A hit claimed in the future is rejected"),
+		HitValidationSubsystem->ValidateMeleeHit(Attacker, Target, CurrentTime + 1.0));
+
+	TestFalse(TEXT("A hit claimed beyond the rewind window is rejected"),
+		HitValidationSubsystem->ValidateMeleeHit(Attacker, Target, CurrentTime - 1.0));
+
+	// 攻击者没有历史时退回到当前位置 --> 静止的攻击者不会获得额外容差
+	HitValidationSubsystem->UnregisterHitTarget(Attacker);
+	TestFalse(TEXT("An unregistered, stationary attacker is validated at its current location"),
+		HitValidationSubsystem->ValidateMeleeHit(Attacker, Target, SwingTime));
+
+	// 静止的两个角色相距300 --> 超出武器的攻击距离
+	ACharacter* FarAttacker = SpawnHitValidationTestCharacter(World, FVector(0.f, 5000.f, 0.f));
+	ACharacter* FarTarget = SpawnHitValidationTestCharacter(World, FVector(300.f, 5000.f, 0.f));
+
+	HitValidationSubsystem->RegisterHitTarget(FarAttacker);
+	HitValidationSubsystem->RegisterHitTarget(FarTarget);
+	AdvanceHitValidationTestWorld(World, HitValidationSubsystem);
+
+	TestFalse(TEXT("A stationary target beyond weapon reach is rejected"),
+		HitValidationSubsystem->ValidateMeleeHit(FarAttacker, FarTarget, World->GetTimeSeconds()));
+
+	Attacker->Destroy();
+	Target->Destroy();
+	FarAttacker->Destroy();
+	FarTarget->Destroy();
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,264 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Components/Input/PlayerInputComponent.h"
+#include "GAS/FightGameplayTags.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+
+// 录制结束后再多模拟的帧数 --> 覆盖最后一个事件之后仍依赖随机流的状态
+static constexpr uint32 FightReplayTestTrailingFrames = 10;
+
+
+/**
+ * @brief 录制时派发过的一条输入，用于和回放派发的结果逐条比较
+ */
+struct FFightRecordedTestInput
+{
+	uint32 Frame = 0;
+	EFightInputLogEventType Type = EFightInputLogEventType::Move;
+	FVector2f Value = FVector2f::ZeroVector;
+	FGameplayTag Tag;
+};
+
+
+/**
+ * @brief 由输入与玩法随机流驱动的最小模拟状态
+ *
+ * 每帧按移动输入位移，按住攻击时每帧从随机流取一次伤害 --> 事件的帧或顺序有任何偏差，最终状态都会不同
+ */
+struct FFightReplayTestState
+{
+	FVector2f Position = FVector2f::ZeroVector;
+	FVector2f LookInput = FVector2f::ZeroVector;
+	FVector2f MoveInput = FVector2f::ZeroVector;
+	bool bHoldingAttack = false;
+	int32 TargetSwitchCount = 0;
+	int32 PickUpCount = 0;
+	float DamageDealt = 0.f;
+
+	void ApplyInput(EFightInputLogEventType InType, const FVector2f& InValue)
+	{
+		switch (InType)
+		{
+		case EFightInputLogEventType::Move:
+			MoveInput = InValue;
+			break;
+		case EFightInputLogEventType::Look:
+			LookInput += InValue;
+			break;
+		case EFightInputLogEventType::SwitchTargetCompleted:
+			TargetSwitchCount++;
+			break;
+		case EFightInputLogEventType::PickUpStones:
+			PickUpCount++;
+			break;
+		case EFightInputLogEventType::AbilityPressed:
+			bHoldingAttack = true;
+			break;
+		case EFightInputLogEventType::AbilityReleased:
+			bHoldingAttack = false;
+			break;
+		default:
+			break;
+		}
+	}
+
+	void StepFrame(float InDeltaTime, FRandomStream& InOutGameplayStream)
+	{
+		Position += MoveInput * InDeltaTime;
+
+		if (bHoldingAttack)
+		{
+			DamageDealt += InOutGameplayStream.FRandRange(5.f, 10.f);
+		}
+	}
+};
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFightInputRecordReplayParityTest, "GASFightDemo.Input.RecordReplayParity",
+	EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FFightInputRecordReplayParityTest::RunTest(const FString& Parameters)
+{
+	const FString FilePath = FPaths::Combine(FPaths::AutomationTransientDir(), TEXT("FightInputParity.fightinput"));
+	const int32 RecordedSeed = 1337;
+	const float RecordedFixedDeltaTime = 1.f / 60.f;
+
+	const TArray<FFightRecordedTestInput> ScriptedInputs = {
+		{ 0, EFightInputLogEventType::Move, FVector2f(0.f, 1.f), FGameplayTag() },
+		{ 3, EFightInputLogEventType::Look, FVector2f(0.25f, -0.5f), FGameplayTag() },
+		{ 3, EFightInputLogEventType::AbilityPressed, FVector2f::ZeroVector, FightGameplayTags::InputTag_LightAttack_Axe },
+		{ 7, EFightInputLogEventType::AbilityReleased, FVector2f::ZeroVector, FightGameplayTags::InputTag_LightAttack_Axe },
+		{ 12, EFightInputLogEventType::SwitchTargetTriggered, FVector2f(1.f, 0.f), FGameplayTag() },
+		{ 12, EFightInputLogEventType::SwitchTargetCompleted, FVector2f::ZeroVector, FGameplayTag() },
+		{ 15, EFightInputLogEventType::Move, FVector2f(-1.f, 0.5f), FGameplayTag() },
+		{ 18, EFightInputLogEventType::AbilityPressed, FVector2f::ZeroVector, FightGameplayTags::InputTag_LightAttack_Axe },
+		{ 20, EFightInputLogEventType::PickUpStones, FVector2f::ZeroVector, FGameplayTag() },
+	};
+
+	const uint32 LastScriptedFrame = ScriptedInputs.Last().Frame;
+	const uint32 NumSimulatedFrames = LastScriptedFrame + FightReplayTestTrailingFrames;
+
+	// 测试自己推进帧计数，不改动全局帧号
+	uint64 TestFrameCounter = 0;
+
+	// 录制：按脚本喂入实时输入，逐帧模拟
+	FFightReplayTestState RecordedState;
+	FRandomStream RecordedGameplayStream(RecordedSeed);
+
+	UPlayerInputComponent* RecordingComponent = NewObject<UPlayerInputComponent>();
+	RecordingComponent->SetFrameCounterOverride(&TestFrameCounter);
+	RecordingComponent->StartInputRecording(RecordedSeed, RecordedFixedDeltaTime);
+
+	int32 NextScriptedIndex = 0;
+	for (uint32 Frame = 0; Frame < NumSimulatedFrames; ++Frame, ++TestFrameCounter)
+	{
+		while (ScriptedInputs.IsValidIndex(NextScriptedIndex) && ScriptedInputs[NextScriptedIndex].Frame == Frame)
+		{
+			const FFightRecordedTestInput& Input = ScriptedInputs[NextScriptedIndex++];
+			if (TestTrue(TEXT("Live input is processed while recording"),
+				RecordingComponent->PreprocessInputEvent(Input.Type, Input.Value, Input.Tag)))
+			{
+				RecordedState.ApplyInput(Input.Type, Input.Value);
+			}
+		}
+
+		RecordedState.StepFrame(RecordedFixedDeltaTime, RecordedGameplayStream);
+	}
+
+	TestTrue(TEXT("Input log is written"), RecordingComponent->StopInputRecording(FilePath));
+
+	TSharedRef<FFightInputLog> LoadedLog = MakeShared<FFightInputLog>();
+	TestTrue(TEXT("Input log is read back"), LoadedLog->LoadFromFile(FilePath));
+	TestEqual(TEXT("Seed survives the round trip"), LoadedLog->RandomSeed, RecordedSeed);
+	TestEqual(TEXT("Fixed delta time survives the round trip"), LoadedLog->FixedDeltaTime, RecordedFixedDeltaTime);
+
+	// 回放：模拟条件全部取自日志，输入只来自回放派发
+	FFightReplayTestState ReplayedState;
+	FRandomStream ReplayedGameplayStream(LoadedLog->RandomSeed);
+	TArray<FFightRecordedTestInput> ReplayedInputs;
+
+	UPlayerInputComponent* ReplayComponent = NewObject<UPlayerInputComponent>();
+	ReplayComponent->SetFrameCounterOverride(&TestFrameCounter);
+	ReplayComponent->OnReplayInputEvent.BindLambda(
+		[this, &ReplayedInputs, &ReplayedState, ReplayComponent](const FFightInputLogEvent& InEvent, const FGameplayTag& InTag)
+		{
+			// 回放派发的事件需要通过输入过滤
+			if (TestTrue(TEXT("Replayed input passes the input filter"), ReplayComponent->PreprocessInputEvent(InEvent.Type, InEvent.Value, InTag)))
+			{
+				ReplayedState.ApplyInput(InEvent.Type, InEvent.Value);
+			}
+
+			FFightRecordedTestInput& Replayed = ReplayedInputs.AddDefaulted_GetRef();
+			Replayed.Frame = InEvent.Frame;
+			Replayed.Type = InEvent.Type;
+			Replayed.Value = InEvent.Value;
+			Replayed.Tag = InTag;
+		});
+
+	ReplayComponent->StartInputReplay(LoadedLog);
+	const uint64 ReplayStartFrame = TestFrameCounter;
+
+	TestFalse(TEXT("Live input is ignored while replaying"),
+		ReplayComponent->PreprocessInputEvent(EFightInputLogEventType::Move, FVector2f(1.f, 1.f)));
+
+	for (uint32 Frame = 0; Frame < NumSimulatedFrames; ++Frame)
+	{
+		TestFrameCounter = ReplayStartFrame + Frame;
+
+		const int32 NumReplayedBefore = ReplayedInputs.Num();
+		const bool bStillReplaying = ReplayComponent->TickInputReplay();
+
+		// 每个事件都在它录制时的帧被派发
+		for (int32 ReplayedIndex = NumReplayedBefore; ReplayedIndex < ReplayedInputs.Num(); ++ReplayedIndex)
+		{
+			TestEqual(TEXT("Replayed input fires on its recorded frame"),
+				static_cast<int32>(ReplayedInputs[ReplayedIndex].Frame), static_cast<int32>(Frame));
+		}
+
+		TestEqual(TEXT("Replay reports completion only after the last event"), bStillReplaying, Frame < LastScriptedFrame);
+
+		ReplayedState.StepFrame(LoadedLog->FixedDeltaTime, ReplayedGameplayStream);
+	}
+
+	ReplayComponent->StopInputReplay();
+
+	if (TestEqual(TEXT("Every recorded input is replayed"), ReplayedInputs.Num(), ScriptedInputs.Num()))
+	{
+		for (int32 Index = 0; Index < ScriptedInputs.Num(); ++Index)
+		{
+			const FFightRecordedTestInput& Recorded = ScriptedInputs[Index];
+			const FFightRecordedTestInput& Replayed = ReplayedInputs[Index];
+
+			TestEqual(TEXT("Replayed type matches"), static_cast<uint8>(Replayed.Type), static_cast<uint8>(Recorded.Type));
+			TestEqual(TEXT("Replayed frame matches"), static_cast<int32>(Replayed.Frame), static_cast<int32>(Recorded.Frame));
+			TestTrue(TEXT("Replayed tag matches"), Replayed.Tag == Recorded.Tag);
+		}
+	}
+
+	// 回放的最终状态与录制时逐位一致
+	TestTrue(TEXT("Replayed position matches the recorded run"), ReplayedState.Position == RecordedState.Position);
+	TestTrue(TEXT("Replayed look input matches the recorded run"), ReplayedState.LookInput == RecordedState.LookInput);
+	TestEqual(TEXT("Replayed target switches match the recorded run"), ReplayedState.TargetSwitchCount, RecordedState.TargetSwitchCount);
+	TestEqual(TEXT("Replayed pick ups match the recorded run"), ReplayedState.PickUpCount, RecordedState.PickUpCount);
+	TestEqual(TEXT("Replayed damage matches the recorded run bit for bit"), ReplayedState.DamageDealt, RecordedState.DamageDealt, 0.f);
+	TestTrue(TEXT("The recorded run dealt damage"), RecordedState.DamageDealt > 0.f);
+
+	IFileManager::Get().Delete(*FilePath, false, true, true);
+
+	return true;
+}
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFightInputLogCorruptFileTest, "GASFightDemo.Input.CorruptLogRejected",
+	EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FFightInputLogCorruptFileTest::RunTest(const FString& Parameters)
+{
+	const FString FilePath = FPaths::Combine(FPaths::AutomationTransientDir(), TEXT("FightInputCorrupt.fightinput"));
+
+	FFightInputLog SourceLog;
+	SourceLog.RandomSeed = 7;
+	SourceLog.FixedDeltaTime = 1.f / 60.f;
+	SourceLog.AddEvent(0, EFightInputLogEventType::Move, FVector2f(1.f, 0.f), FGameplayTag());
+	SourceLog.AddEvent(4, EFightInputLogEventType::PickUpStones, FVector2f::ZeroVector, FGameplayTag());
+
+	TestTrue(TEXT("Input log is written"), SourceLog.SaveToFile(FilePath));
+
+	TArray<uint8> Bytes;
+	TestTrue(TEXT("Input log bytes are read"), FFileHelper::LoadFileToArray(Bytes, *FilePath));
+
+	// 事件区共18字节：Move为帧序号 + 类型 + 两个分量，PickUpStones只有帧序号与类型 --> 最后一个字节就是它的类型
+	static constexpr int32 EventBytes = 18;
+
+	TArray<uint8> BadTypeBytes = Bytes;
+	BadTypeBytes.Last() = 0xFF;
+	FFileHelper::SaveArrayToFile(BadTypeBytes, *FilePath);
+	TestFalse(TEXT("An out of range event type is rejected"), FFightInputLog().LoadFromFile(FilePath));
+
+	// 截断事件区 --> 事件数量超过剩余字节能容纳的数量
+	TArray<uint8> TruncatedBytes = Bytes;
+	TruncatedBytes.SetNum(Bytes.Num() - 10);
+	FFileHelper::SaveArrayToFile(TruncatedBytes, *FilePath);
+	TestFalse(TEXT("A truncated log is rejected"), FFightInputLog().LoadFromFile(FilePath));
+
+	// 事件数量改为负数
+	TArray<uint8> NegativeCountBytes = Bytes;
+	const int32 NegativeCount = -1;
+	FMemory::Memcpy(&NegativeCountBytes[Bytes.Num() - EventBytes - sizeof(int32)], &NegativeCount, sizeof(int32));
+	FFileHelper::SaveArrayToFile(NegativeCountBytes, *FilePath);
+	TestFalse(TEXT("A negative event count is rejected"), FFightInputLog().LoadFromFile(FilePath));
+
+	IFileManager::Get().Delete(*FilePath, false, true, true);
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,198 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Tests/FightTestWorld.h"
+#include "AI/FightOrientationSubsystem.h"
+#include "GameFramework/Character.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "Kismet/KismetMathLibrary.h"
+
+
+static constexpr int32 FightFacingParitySamples = 10000;
+
+// 夹角与精度相差不到该值的样本跳过 --> 两种算法在边界上的浮点舍入不同
+static constexpr float FightFacingParityBoundaryDegrees = 0.01f;
+
+// 收敛测试使用原BTTask_RotateToFaceTarget的默认参数，以60帧模拟
+static constexpr float FightFacingConvergenceDeltaTime = 1.f / 60.f;
+static constexpr float FightFacingConvergenceInterpSpeed = 5.f;
+static constexpr float FightFacingConvergencePrecision = 10.f;
+static constexpr int32 FightFacingConvergenceMaxFrames = 600;
+
+// 两种实现在收敛帧数与最终Yaw上允许的偏差 --> 子系统只计算Yaw，与原实现只差浮点舍入
+static constexpr int32 FightFacingConvergenceFrameTolerance = 1;
+static constexpr float FightFacingConvergenceYawTolerance = 0.5f;
+
+
+/**
+ * @brief 原BTTask_RotateToFaceTarget的判断：归一化后点积求反余弦，与角度精度比较
+ */
+static bool IsFacingByAngle(const FVector& InForward, const FVector& InToTarget, float InAnglePrecision)
+{
+	const float DotResult = FVector::DotProduct(InForward.GetSafeNormal(), InToTarget.GetSafeNormal());
+	return UKismetMathLibrary::DegAcos(DotResult) <= InAnglePrecision;
+}
+
+
+/**
+ * @brief 生成一个不受移动组件影响的角色 --> 旋转只由被测的朝向逻辑修改
+ */
+static ACharacter* SpawnFacingTestCharacter(UWorld* InWorld, const FVector& InLocation, float InYaw)
+{
+	ACharacter* Character = InWorld->SpawnActor<ACharacter>(InLocation, FRotator(0.f, InYaw, 0.f));
+	Character->GetCharacterMovement()->SetComponentTickEnabled(false);
+	return Character;
+}
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFightFacingCosineParityTest, "GASFightDemo.AI.FacingCosineParity",
+	EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FFightFacingCosineParityTest::RunTest(const FString& Parameters)
+{
+	FRandomStream RandomStream(20251019);
+
+	int32 NumCompared = 0;
+	int32 NumMismatches = 0;
+
+	for (int32 Sample = 0; Sample < FightFacingParitySamples; ++Sample)
+	{
+		// 水平向量且长度不一 --> 新判断只看水平分量，原判断在水平面上与之等价
+		const FVector Forward = RandomStream.VRand().GetSafeNormal2D() * RandomStream.FRandRange(0.5f, 2.f);
+		const FVector ToTarget = RandomStream.VRand().GetSafeNormal2D() * RandomStream.FRandRange(10.f, 5000.f);
+		const float AnglePrecision = RandomStream.FRandRange(0.f, 180.f);
+
+		if (Forward.IsNearlyZero() || ToTarget.IsNearlyZero())
+		{
+			continue;
+		}
+
+		const float Angle = UKismetMathLibrary::DegAcos(FVector::DotProduct(Forward.GetSafeNormal(), ToTarget.GetSafeNormal()));
+		if (FMath::Abs(Angle - AnglePrecision) < FightFacingParityBoundaryDegrees)
+		{
+			continue;
+		}
+
+		const float AnglePrecisionCos = FMath::Cos(FMath::DegreesToRadians(AnglePrecision));
+
+		NumCompared++;
+		if (UFightOrientationSubsystem::IsFacingWithinCosine(Forward, ToTarget, AnglePrecisionCos) !=
+			IsFacingByAngle(Forward, ToTarget, AnglePrecision))
+		{
+			NumMismatches++;
+			AddError(FString::Printf(TEXT("Mismatch: angle %.4f, precision %.4f"), Angle, AnglePrecision));
+		}
+	}
+
+	TestTrue(TEXT("Most random samples are compared"), NumCompared > FightFacingParitySamples / 2);
+	TestEqual(TEXT("Cosine test matches the angle test"), NumMismatches, 0);
+
+	// 固定的边界情况
+	const FVector Forward = FVector::ForwardVector;
+	TestTrue(TEXT("Directly ahead is facing for a tight precision"),
+		UFightOrientationSubsystem::IsFacingWithinCosine(Forward, FVector(500.f, 0.f, 0.f), FMath::Cos(FMath::DegreesToRadians(1.f))));
+	TestFalse(TEXT("Directly behind is not facing for a 90 degree precision"),
+		UFightOrientationSubsystem::IsFacingWithinCosine(Forward, FVector(-500.f, 0.f, 0.f), 0.f));
+	TestTrue(TEXT("Directly behind is facing for a 180 degree precision"),
+		UFightOrientationSubsystem::IsFacingWithinCosine(Forward, FVector(-500.f, 0.f, 0.f), -1.f));
+	TestTrue(TEXT("A target at the same horizontal position counts as faced"),
+		UFightOrientationSubsystem::IsFacingWithinCosine(Forward, FVector(0.f, 0.f, 300.f), 1.f));
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFightFacingConvergenceParityTest, "GASFightDemo.AI.FacingConvergenceParity",
+	EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FFightFacingConvergenceParityTest::RunTest(const FString& Parameters)
+{
+	FFightTestWorld TestWorld;
+	UWorld* World = TestWorld.Get();
+
+	UFightOrientationSubsystem* OrientationSubsystem = World->GetSubsystem<UFightOrientationSubsystem>();
+	if (!TestNotNull(TEXT("Orientation subsystem exists in game worlds"), OrientationSubsystem))
+	{
+		return false;
+	}
+
+	const float AnglePrecisionCos = FMath::Cos(FMath::DegreesToRadians(FightFacingConvergencePrecision));
+
+	// 起始Yaw与目标相对位置，覆盖小角度、正背对与跨越±180度的情况
+	struct FFacingCase
+	{
+		float StartYaw;
+		FVector TargetOffset;
+	};
+
+	const FFacingCase Cases[] = {
+		{ 0.f, FVector(0.f, 800.f, 0.f) },
+		{ 0.f, FVector(-800.f, 10.f, 0.f) },
+		{ 170.f, FVector(-500.f, -300.f, 0.f) },
+		{ -135.f, FVector(600.f, 600.f, 0.f) },
+		{ 45.f, FVector(1000.f, 900.f, 0.f) },
+	};
+
+	for (int32 CaseIndex = 0; CaseIndex < UE_ARRAY_COUNT(Cases); ++CaseIndex)
+	{
+		const FFacingCase& Case = Cases[CaseIndex];
+
+		// 两个角色放在相隔很远的位置，互不影响
+		const FVector OldOrigin(0.f, CaseIndex * 10000.f, 0.f);
+		const FVector NewOrigin(5000.f, CaseIndex * 10000.f, 0.f);
+
+		ACharacter* OldPawn = SpawnFacingTestCharacter(World, OldOrigin, Case.StartYaw);
+		ACharacter* OldTarget = SpawnFacingTestCharacter(World, OldOrigin + Case.TargetOffset, 0.f);
+		ACharacter* NewPawn = SpawnFacingTestCharacter(World, NewOrigin, Case.StartYaw);
+		ACharacter* NewTarget = SpawnFacingTestCharacter(World, NewOrigin + Case.TargetOffset, 0.f);
+
+		// 原实现：每帧先判断精度，未达到时FindLookAtRotation + RInterpTo
+		int32 OldFrames = 0;
+		while (OldFrames < FightFacingConvergenceMaxFrames &&
+			!IsFacingByAngle(OldPawn->GetActorForwardVector(), OldTarget->GetActorLocation() - OldPawn->GetActorLocation(),
+				FightFacingConvergencePrecision))
+		{
+			const FRotator LookAtRot = UKismetMathLibrary::FindLookAtRotation(OldPawn->GetActorLocation(), OldTarget->GetActorLocation());
+			OldPawn->SetActorRotation(FMath::RInterpTo(OldPawn->GetActorRotation(), LookAtRot,
+				FightFacingConvergenceDeltaTime, FightFacingConvergenceInterpSpeed));
+			OldFrames++;
+		}
+
+		// 新实现：每帧先判断精度，未达到时由子系统统一旋转
+		OrientationSubsystem->RegisterOrientationRequest(NewPawn, NewTarget, FightFacingConvergenceInterpSpeed, NewPawn);
+
+		int32 NewFrames = 0;
+		while (NewFrames < FightFacingConvergenceMaxFrames &&
+			!UFightOrientationSubsystem::IsFacingWithinCosine(NewPawn->GetActorForwardVector(),
+				NewTarget->GetActorLocation() - NewPawn->GetActorLocation(), AnglePrecisionCos))
+		{
+			OrientationSubsystem->Tick(FightFacingConvergenceDeltaTime);
+			NewFrames++;
+		}
+
+		OrientationSubsystem->UnregisterOrientationRequest(NewPawn, NewPawn);
+
+		const FString CaseName = FString::Printf(TEXT("Case %d (start yaw %.0f)"), CaseIndex, Case.StartYaw);
+		TestTrue(CaseName + TEXT(": the original implementation converges"), OldFrames < FightFacingConvergenceMaxFrames);
+		TestTrue(CaseName + TEXT(": the subsystem converges"), NewFrames < FightFacingConvergenceMaxFrames);
+		TestTrue(CaseName + FString::Printf(TEXT(": frame count matches (%d vs %d)"), NewFrames, OldFrames),
+			FMath::Abs(NewFrames - OldFrames) <= FightFacingConvergenceFrameTolerance);
+
+		const float YawDifference = FMath::Abs(FMath::FindDeltaAngleDegrees(
+			NewPawn->GetActorRotation().Yaw, OldPawn->GetActorRotation().Yaw));
+		TestTrue(CaseName + FString::Printf(TEXT(": final yaw matches (off by %.3f)"), YawDifference),
+			YawDifference <= FightFacingConvergenceYawTolerance);
+
+		OldPawn->Destroy();
+		OldTarget->Destroy();
+		NewPawn->Destroy();
+		NewTarget->Destroy();
+	}
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,195 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "SaveGame/FightProgressSaveFile.h"
+#include "SaveGame/FightSaveGame.h"
+#include "Kismet/GameplayStatics.h"
+#include "Misc/FileHelper.h"
+#include "Serialization/MemoryWriter.h"
+#include "Misc/Paths.h"
+#include "HAL/FileManager.h"
+
+
+// 压缩阈值以内的波次检查点数量 --> 测量的是纯追加写入
+static constexpr int32 FightProgressBenchmarkCheckpoints = 48;
+
+
+/**
+ * @brief 追加一局的开始、若干波次检查点与一次武器解锁，返回写入的最后一个检查点
+ */
+static FFightRunStats AppendBenchmarkRun(FFightProgressSaveFile& InSaveFile, int32 NumCheckpoints)
+{
+	InSaveFile.AppendRunStarted();
+	InSaveFile.AppendWeaponUnlocked(TEXT("Player.Weapon.Axe"));
+
+	FFightRunStats RunStats;
+	for (int32 Wave = 1; Wave <= NumCheckpoints; ++Wave)
+	{
+		RunStats.WaveReached = Wave;
+		RunStats.EnemiesDefeated += 3;
+		RunStats.RunDurationSeconds += 30.f;
+		InSaveFile.AppendWaveCheckpoint(RunStats);
+	}
+
+	return RunStats;
+}
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFightProgressSaveFileRoundTripTest, "GASFightDemo.SaveGame.ProgressFileRoundTrip",
+	EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FFightProgressSaveFileRoundTripTest::RunTest(const FString& Parameters)
+{
+	const FString FilePath = FPaths::Combine(FPaths::AutomationTransientDir(), TEXT("FightProgressRoundTrip.sav"));
+	IFileManager::Get().Delete(*FilePath, false, true, true);
+
+	FFightRunStats LastRunStats;
+	{
+		FFightProgressSaveFile SaveFile(FilePath);
+		TestTrue(TEXT("A missing save file loads as empty progress"), SaveFile.Load());
+
+		LastRunStats = AppendBenchmarkRun(SaveFile, FightProgressBenchmarkCheckpoints);
+		SaveFile.WaitForPendingWrites();
+	}
+
+	// 模拟写入最后一条记录时崩溃：末尾追加半条记录
+	const TArray<uint8> TruncatedRecord = { 2, 0xFF, 0xFF };
+	FFileHelper::SaveArrayToFile(TruncatedRecord, *FilePath, &IFileManager::Get(), FILEWRITE_Append);
+
+	FFightProgressSaveFile ReloadedFile(FilePath);
+	TestTrue(TEXT("A save file with a truncated tail still loads"), ReloadedFile.Load());
+
+	const FFightProgressData& ProgressData = ReloadedFile.GetProgressData();
+	TestEqual(TEXT("Highest wave is replayed"), ProgressData.HighestWaveReached, LastRunStats.WaveReached);
+	TestEqual(TEXT("Run count is replayed"), ProgressData.TotalRunsStarted, 1);
+	TestEqual(TEXT("Current run is replayed"), ProgressData.CurrentRun.EnemiesDefeated, LastRunStats.EnemiesDefeated);
+	TestEqual(TEXT("Unlocked weapons are replayed"), ProgressData.UnlockedWeaponTags.Num(), 1);
+
+	ReloadedFile.WaitForPendingWrites();
+	IFileManager::Get().Delete(*FilePath, false, true, true);
+
+	return true;
+}
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFightProgressSaveFileAsyncLoadTest, "GASFightDemo.SaveGame.ProgressFileAsyncLoad",
+	EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FFightProgressSaveFileAsyncLoadTest::RunTest(const FString& Parameters)
+{
+	const FString FilePath = FPaths::Combine(FPaths::AutomationTransientDir(), TEXT("FightProgressAsyncLoad.sav"));
+	IFileManager::Get().Delete(*FilePath, false, true, true);
+
+	FFightRunStats LastRunStats;
+	{
+		FFightProgressSaveFile SaveFile(FilePath);
+		SaveFile.Load();
+
+		LastRunStats = AppendBenchmarkRun(SaveFile, FightProgressBenchmarkCheckpoints / 2);
+	}
+
+	{
+		FFightProgressSaveFile SaveFile(FilePath);
+		SaveFile.LoadAsync();
+		TestTrue(TEXT("The file is still loading right after LoadAsync"), SaveFile.IsLoading());
+
+		// 读取完成前追加的记录先缓存，回放完文件后再写入
+		SaveFile.AppendWeaponUnlocked(TEXT("Player.Weapon.Sword"));
+		SaveFile.AppendRunStarted();
+
+		// 游戏线程的回调还没执行时同步完成读取
+		SaveFile.WaitForPendingWrites();
+		TestFalse(TEXT("Waiting for pending writes finishes the load"), SaveFile.IsLoading());
+
+		const FFightProgressData& ProgressData = SaveFile.GetProgressData();
+		TestEqual(TEXT("Records on disk are replayed before the queued ones"), ProgressData.HighestWaveReached, LastRunStats.WaveReached);
+		TestEqual(TEXT("Queued run start is applied on top of the file"), ProgressData.TotalRunsStarted, 2);
+		TestEqual(TEXT("Queued weapon unlock is applied on top of the file"), ProgressData.UnlockedWeaponTags.Num(), 2);
+	}
+
+	FFightProgressSaveFile ReloadedFile(FilePath);
+	ReloadedFile.Load();
+
+	const FFightProgressData& ReloadedData = ReloadedFile.GetProgressData();
+	TestEqual(TEXT("Queued records were written to disk"), ReloadedData.TotalRunsStarted, 2);
+	TestEqual(TEXT("Queued weapon unlock was written to disk"), ReloadedData.UnlockedWeaponTags.Num(), 2);
+
+	ReloadedFile.WaitForPendingWrites();
+	IFileManager::Get().Delete(*FilePath, false, true, true);
+
+	return true;
+}
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFightProgressSaveFileBenchmark, "GASFightDemo.SaveGame.ProgressFileBenchmark",
+	EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FFightProgressSaveFileBenchmark::RunTest(const FString& Parameters)
+{
+	const FString FilePath = FPaths::Combine(FPaths::AutomationTransientDir(), TEXT("FightProgressBenchmark.sav"));
+	IFileManager::Get().Delete(*FilePath, false, true, true);
+
+	// 追加路径：每个波次检查点只写一条记录，计时包含等待写入完成
+	double AppendSeconds = 0.0;
+	{
+		FFightProgressSaveFile SaveFile(FilePath);
+		SaveFile.Load();
+
+		const double StartTime = FPlatformTime::Seconds();
+		AppendBenchmarkRun(SaveFile, FightProgressBenchmarkCheckpoints);
+		SaveFile.WaitForPendingWrites();
+		AppendSeconds = FPlatformTime::Seconds() - StartTime;
+	}
+
+	const int64 AppendFileSize = IFileManager::Get().FileSize(*FilePath);
+	IFileManager::Get().Delete(*FilePath, false, true, true);
+
+	// 整体重写路径：每个检查点都把存档对象（标签属性格式）连同完整进度重新序列化并整体写盘
+	// 进度数据与追加路径完全相同，两条路径都计入磁盘IO
+	UFightSaveGame* SaveGameObject = Cast<UFightSaveGame>(UGameplayStatics::CreateSaveGameObject(UFightSaveGame::StaticClass()));
+	FFightProgressData RewriteProgressData;
+	RewriteProgressData.TotalRunsStarted = 1;
+	RewriteProgressData.UnlockedWeaponTags.Add(TEXT("Player.Weapon.Axe"));
+
+	TArray<uint8> RewriteBytes;
+
+	const double RewriteStartTime = FPlatformTime::Seconds();
+	for (int32 Wave = 1; Wave <= FightProgressBenchmarkCheckpoints; ++Wave)
+	{
+		RewriteProgressData.CurrentRun.WaveReached = Wave;
+		RewriteProgressData.CurrentRun.EnemiesDefeated += 3;
+		RewriteProgressData.CurrentRun.RunDurationSeconds += 30.f;
+		RewriteProgressData.HighestWaveReached = Wave;
+		RewriteProgressData.BestRun = RewriteProgressData.CurrentRun;
+
+		RewriteBytes.Reset();
+		UGameplayStatics::SaveGameToMemory(SaveGameObject, RewriteBytes);
+
+		FMemoryWriter ProgressWriter(RewriteBytes, false, true);
+		ProgressWriter << RewriteProgressData;
+
+		FFileHelper::SaveArrayToFile(RewriteBytes, *FilePath);
+	}
+	const double RewriteSeconds = FPlatformTime::Seconds() - RewriteStartTime;
+
+	const int64 RewriteFileSize = IFileManager::Get().FileSize(*FilePath);
+	IFileManager::Get().Delete(*FilePath, false, true, true);
+
+	TestTrue(TEXT("Append path wrote the save file"), AppendFileSize > 0);
+	TestTrue(TEXT("Rewrite path wrote the save file"), RewriteFileSize > 0);
+
+	AddInfo(FString::Printf(TEXT("%d checkpoints: append file %lld bytes total (%.1f bytes written per checkpoint), %.3f ms including disk IO"),
+		FightProgressBenchmarkCheckpoints, AppendFileSize, static_cast<double>(AppendFileSize) / FightProgressBenchmarkCheckpoints,
+		AppendSeconds * 1000.0));
+	AddInfo(FString::Printf(TEXT("%d checkpoints: full rewrite %lld bytes written per checkpoint (%lld total), %.3f ms including disk IO"),
+		FightProgressBenchmarkCheckpoints, RewriteFileSize, RewriteFileSize * FightProgressBenchmarkCheckpoints,
+		RewriteSeconds * 1000.0));
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,123 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Tests/FightTestWorld.h"
+#include "Characters/EnemyCharacter.h"
+#include "DataAsset/StartUpData/DataAsset_StartUpDataBase.h"
+#include "GAS/FightAbilitySystemComponent.h"
+#include "GAS/BasicAttributeSet.h"
+
+
+// 用作基准的敌人启动数据 --> 启动效果只包含快速路径能处理的属性初始化
+static const TCHAR* FightStartUpBenchmarkDataPath = TEXT("/Game/_Game/DataAsset/DA_Guardian.DA_Guardian");
+
+// 每条路径初始化的敌人数量
+static constexpr int32 FightStartUpBenchmarkIterations = 64;
+
+
+/**
+ * @brief 生成一个不被AI控制的敌人，并初始化其能力系统
+ *
+ * 不自动生成控制器 --> 避免PossessedBy去加载角色自身的启动数据
+ */
+static AEnemyCharacter* SpawnStartUpBenchmarkEnemy(UWorld* InWorld)
+{
+	AEnemyCharacter* Enemy = InWorld->SpawnActorDeferred<AEnemyCharacter>(AEnemyCharacter::StaticClass(), FTransform::Identity);
+	Enemy->AutoPossessAI = EAutoPossessAI::Disabled;
+	Enemy->FinishSpawning(FTransform::Identity);
+
+	Enemy->GetFightAbilitySystemComponent()->InitAbilityActorInfo(Enemy, Enemy);
+
+	return Enemy;
+}
+
+/**
+ * @brief 用指定路径初始化一批敌人，返回授予本身的累计耗时（秒），并输出最后一个敌人的属性基础值
+ */
+static double RunStartUpDataInit(UWorld* InWorld, UDataAsset_StartUpDataBase* InStartUpData, bool bUseFastAttributeInit,
+	TMap<FString, float>& OutBaseValues)
+{
+	InStartUpData->SetUseFastAttributeInit(bUseFastAttributeInit);
+
+	// 第一次授予会构建授予包，不计入耗时
+	AEnemyCharacter* WarmUpEnemy = SpawnStartUpBenchmarkEnemy(InWorld);
+	InStartUpData->GiveToAbilitySystemComponent(WarmUpEnemy->GetFightAbilitySystemComponent());
+	WarmUpEnemy->Destroy();
+
+	double ElapsedSeconds = 0.0;
+
+	for (int32 Iteration = 0; Iteration < FightStartUpBenchmarkIterations; ++Iteration)
+	{
+		AEnemyCharacter* Enemy = SpawnStartUpBenchmarkEnemy(InWorld);
+		UFightAbilitySystemComponent* AbilitySystemComponent = Enemy->GetFightAbilitySystemComponent();
+
+		const double StartTime = FPlatformTime::Seconds();
+		InStartUpData->GiveToAbilitySystemComponent(AbilitySystemComponent);
+		ElapsedSeconds += FPlatformTime::Seconds() - StartTime;
+
+		if (Iteration == FightStartUpBenchmarkIterations - 1)
+		{
+			TArray<FGameplayAttribute> Attributes;
+			UAttributeSet::GetAttributesFromSetClass(UBasicAttributeSet::StaticClass(), Attributes);
+
+			OutBaseValues.Reset();
+			for (const FGameplayAttribute& Attribute : Attributes)
+			{
+				OutBaseValues.Add(Attribute.GetName(), AbilitySystemComponent->GetNumericAttributeBase(Attribute));
+			}
+		}
+
+		Enemy->Destroy();
+	}
+
+	return ElapsedSeconds;
+}
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFightStartUpFastAttributeInitBenchmark, "GASFightDemo.StartUpData.FastAttributeInitBenchmark",
+	EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FFightStartUpFastAttributeInitBenchmark::RunTest(const FString& Parameters)
+{
+	UDataAsset_StartUpDataBase* StartUpData = LoadObject<UDataAsset_StartUpDataBase>(nullptr, FightStartUpBenchmarkDataPath);
+	if (!StartUpData)
+	{
+		AddWarning(FString::Printf(TEXT("Benchmark start up data %s could not be loaded, skipping"), FightStartUpBenchmarkDataPath));
+		return true;
+	}
+
+	FFightTestWorld TestWorld;
+	const bool bConfiguredFastAttributeInit = StartUpData->IsUsingFastAttributeInit();
+
+	TMap<FString, float> SlowBaseValues;
+	TMap<FString, float> FastBaseValues;
+
+	const double SlowSeconds = RunStartUpDataInit(TestWorld.Get(), StartUpData, false, SlowBaseValues);
+	const double FastSeconds = RunStartUpDataInit(TestWorld.Get(), StartUpData, true, FastBaseValues);
+
+	// 恢复资产上配置的路径
+	StartUpData->SetUseFastAttributeInit(bConfiguredFastAttributeInit);
+
+	for (const TPair<FString, float>& SlowBaseValue : SlowBaseValues)
+	{
+		const float* FastBaseValue = FastBaseValues.Find(SlowBaseValue.Key);
+		TestTrue(FString::Printf(TEXT("Fast init wrote %s"), *SlowBaseValue.Key), FastBaseValue != nullptr);
+
+		if (FastBaseValue)
+		{
+			TestEqual(FString::Printf(TEXT("Fast init matches effect application for %s"), *SlowBaseValue.Key),
+				*FastBaseValue, SlowBaseValue.Value);
+		}
+	}
+
+	AddInfo(FString::Printf(TEXT("%d enemy start up grants: effect application %.3f ms, fast init %.3f ms"),
+		FightStartUpBenchmarkIterations, SlowSeconds * 1000.0, FastSeconds * 1000.0));
+
+	return true;
+}
+
+#endif
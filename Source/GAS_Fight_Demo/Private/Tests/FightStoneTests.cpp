@@ -0,0 +1,210 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Tests/FightTestWorld.h"
+#include "GAS/FightAbilitySystemComponent.h"
+#include "GameplayEffect.h"
+#include "Items/PickUps/FightStoneBase.h"
+#include "Characters/MainCharacter.h"
+#include "GAS/FightGameplayTags.h"
+#include "GAS/Abilities/PlayerGA_PickUpStones.h"
+#include "GameFramework/CharacterMovementComponent.h"
+
+
+static constexpr int32 FightStoneTestApplyLevel = 3;
+
+// 重叠测试中石头的位置 --> 两块石头相距很近，玩家站上去同时与两块重叠
+static const FVector FightStoneTestStoneLocation(1000.f, 0.f, 0.f);
+static const FVector FightStoneTestSecondStoneOffset(0.f, 40.f, 0.f);
+
+// 玩家离开石头后的位置，远超过拾取球与胶囊体的半径
+static const FVector FightStoneTestAwayLocation(-2000.f, 0.f, 0.f);
+
+
+/**
+ * @brief 生成一块使用指定效果的石头 --> 石头蓝图不在测试中加载，效果类通过测试专用接口指定
+ */
+static AFightStoneBase* SpawnStoneTestStone(UWorld* InWorld, TSubclassOf<UGameplayEffect> InEffectClass, int32 InStackCount,
+	const FVector& InLocation = FVector::ZeroVector)
+{
+	AFightStoneBase* Stone = InWorld->SpawnActor<AFightStoneBase>(InLocation, FRotator::ZeroRotator);
+	Stone->SetStoneGameplayEffectClassForTesting(InEffectClass);
+	Stone->SetStackCount(InStackCount);
+	return Stone;
+}
+
+/**
+ * @brief 在远离石头的位置生成玩家角色 --> 关闭移动组件，位置只由测试修改
+ */
+static AMainCharacter* SpawnStoneTestPlayer(UWorld* InWorld)
+{
+	AMainCharacter* Player = InWorld->SpawnActor<AMainCharacter>(FightStoneTestAwayLocation, FRotator::ZeroRotator);
+	Player->GetCharacterMovement()->SetComponentTickEnabled(false);
+	return Player;
+}
+
+static int32 GetNumOverlappingStones(AMainCharacter* InPlayer)
+{
+	TArray<AFightStoneBase*> OverlappingStones;
+	InPlayer->GetOverlappingStones(OverlappingStones);
+	return OverlappingStones.Num();
+}
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFightConsumeStonesGroupingTest, "GASFightDemo.PickUp.ConsumeStonesGrouping",
+	EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FFightConsumeStonesGroupingTest::RunTest(const FString& Parameters)
+{
+	FFightTestWorld TestWorld;
+	UWorld* World = TestWorld.Get();
+
+	AActor* OwnerActor = World->SpawnActor<AActor>();
+	UFightAbilitySystemComponent* AbilitySystemComponent = NewObject<UFightAbilitySystemComponent>(OwnerActor);
+	AbilitySystemComponent->RegisterComponent();
+	AbilitySystemComponent->InitAbilityActorInfo(OwnerActor, OwnerActor);
+
+	// 记录每次应用 --> 瞬时效果不会留下活动效果，只能从应用回调中观察
+	int32 NumApplications = 0;
+	bool bAllSpecsUseApplyLevel = true;
+
+	const FDelegateHandle AppliedDelegateHandle = AbilitySystemComponent->OnGameplayEffectAppliedDelegateToSelf.AddLambda(
+		[&](UAbilitySystemComponent*, const FGameplayEffectSpec& InSpec, FActiveGameplayEffectHandle)
+		{
+			NumApplications++;
+			bAllSpecsUseApplyLevel &= InSpec.GetLevel() == FightStoneTestApplyLevel;
+		});
+
+	// 合并过的石头代表多层 --> 1 + 2 + 4层同一效果，中间夹一个空指针
+	AFightStoneBase* const Stones[] = {
+		SpawnStoneTestStone(World, UGameplayEffect::StaticClass(), 1),
+		nullptr,
+		SpawnStoneTestStone(World, UGameplayEffect::StaticClass(), 2),
+		SpawnStoneTestStone(World, UGameplayEffect::StaticClass(), 4)
+	};
+
+	AFightStoneBase::ConsumeStones(Stones, AbilitySystemComponent, FightStoneTestApplyLevel);
+
+	TestEqual(TEXT("An instant effect is executed once per stack across all stones"), NumApplications, 7);
+	TestTrue(TEXT("Every spec is made at the ability level"), bAllSpecsUseApplyLevel);
+
+	// 单独消耗一块石头同样按层数执行
+	Stones[3]->Consume(AbilitySystemComponent, FightStoneTestApplyLevel);
+
+	TestEqual(TEXT("Consuming a single stone applies its stacks"), NumApplications, 11);
+	TestTrue(TEXT("A single consume still uses the ability level"), bAllSpecsUseApplyLevel);
+
+	AbilitySystemComponent->OnGameplayEffectAppliedDelegateToSelf.Remove(AppliedDelegateHandle);
+
+	for (AFightStoneBase* Stone : Stones)
+	{
+		if (Stone)
+		{
+			Stone->Destroy();
+		}
+	}
+
+	OwnerActor->Destroy();
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFightStoneOverlapSetTest, "GASFightDemo.PickUp.StoneOverlapSet",
+	EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FFightStoneOverlapSetTest::RunTest(const FString& Parameters)
+{
+	FFightTestWorld TestWorld;
+	UWorld* World = TestWorld.Get();
+
+	AFightStoneBase* FirstStone = SpawnStoneTestStone(World, UGameplayEffect::StaticClass(), 1, FightStoneTestStoneLocation);
+	AFightStoneBase* SecondStone = SpawnStoneTestStone(World, UGameplayEffect::StaticClass(), 1,
+		FightStoneTestStoneLocation + FightStoneTestSecondStoneOffset);
+	AMainCharacter* Player = SpawnStoneTestPlayer(World);
+
+	TestEqual(TEXT("No stones overlap before the player walks onto them"), GetNumOverlappingStones(Player), 0);
+
+	// 开始重叠 --> 石头登记到玩家的重叠集合
+	Player->SetActorLocation(FightStoneTestStoneLocation);
+	TestEqual(TEXT("Begin overlap registers both stones"), GetNumOverlappingStones(Player), 2);
+
+	// 结束重叠 --> 石头从重叠集合中移除
+	Player->SetActorLocation(FightStoneTestAwayLocation);
+	TestEqual(TEXT("End overlap unregisters both stones"), GetNumOverlappingStones(Player), 0);
+
+	// 石头失活时关闭碰撞，不再算作重叠
+	Player->SetActorLocation(FightStoneTestStoneLocation);
+	FirstStone->SetPickUpActive(false);
+
+	TArray<AFightStoneBase*> OverlappingStones;
+	Player->GetOverlappingStones(OverlappingStones);
+	TestEqual(TEXT("A deactivated stone leaves the overlap set"), OverlappingStones.Num(), 1);
+	TestTrue(TEXT("The remaining entry is the still active stone"), OverlappingStones.Num() == 1 && OverlappingStones[0] == SecondStone);
+
+	// 已销毁的石头同样不再算作重叠
+	SecondStone->Destroy();
+	TestEqual(TEXT("A destroyed stone leaves the overlap set"), GetNumOverlappingStones(Player), 0);
+
+	Player->Destroy();
+	FirstStone->Destroy();
+
+	return true;
+}
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFightStonePickUpActivationOncePerFrameTest, "GASFightDemo.PickUp.ActivationOncePerFrame",
+	EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FFightStonePickUpActivationOncePerFrameTest::RunTest(const FString& Parameters)
+{
+	FFightTestWorld TestWorld;
+	UWorld* World = TestWorld.Get();
+
+	AMainCharacter* Player = SpawnStoneTestPlayer(World);
+	UFightAbilitySystemComponent* AbilitySystemComponent = Player->GetFightAbilitySystemComponent();
+	AbilitySystemComponent->GiveAbility(FGameplayAbilitySpec(UPlayerGA_PickUpStones::StaticClass(), 1));
+
+	int32 NumActivations = 0;
+	const FDelegateHandle ActivatedDelegateHandle = AbilitySystemComponent->AbilityActivatedCallbacks.AddLambda(
+		[&NumActivations](UGameplayAbility*)
+		{
+			NumActivations++;
+		});
+
+	AFightStoneBase* FirstStone = SpawnStoneTestStone(World, UGameplayEffect::StaticClass(), 1);
+	AFightStoneBase* SecondStone = SpawnStoneTestStone(World, UGameplayEffect::StaticClass(), 1);
+
+	// 测试在同一帧内执行 --> 第一块石头登记时激活，之后的登记只加入重叠集合
+	Player->RegisterOverlappingStone(FirstStone);
+	TestEqual(TEXT("The first stone of the frame activates the pick up ability"), NumActivations, 1);
+
+	// 先结束能力，排除能力仍处于激活状态造成的拒绝
+	AbilitySystemComponent->CancelAllAbilities();
+
+	Player->RegisterOverlappingStone(SecondStone);
+	Player->RegisterOverlappingStone(FirstStone);
+	TestEqual(TEXT("Further stones in the same frame do not activate again"), NumActivations, 1);
+	TestEqual(TEXT("Every stone is still added to the overlap set once"), GetNumOverlappingStones(Player), 2);
+
+	// 能力本身仍可激活 --> 上面没有激活只因为本帧已经尝试过
+	TestTrue(TEXT("The ability can still be activated directly"),
+		AbilitySystemComponent->TryActivateAbilityByTag(FightGameplayTags::Player_Ability_PickUp_Stones));
+	TestEqual(TEXT("The direct activation is counted"), NumActivations, 2);
+
+	Player->UnregisterOverlappingStone(FirstStone);
+	TestEqual(TEXT("Unregistering removes only that stone"), GetNumOverlappingStones(Player), 1);
+
+	AbilitySystemComponent->AbilityActivatedCallbacks.Remove(ActivatedDelegateHandle);
+
+	Player->Destroy();
+	FirstStone->Destroy();
+	SecondStone->Destroy();
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,160 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Misc/AutomationTest.h"
+
+// 需要在编辑器中以PIE启动专用服务器与多个客户端
+#if WITH_DEV_AUTOMATION_TESTS && WITH_EDITOR
+
+#include "Tests/AutomationCommon.h"
+#include "Tests/AutomationEditorCommon.h"
+#include "Settings/LevelEditorPlaySettings.h"
+#include "Engine/Engine.h"
+#include "Engine/NetDriver.h"
+#include "EngineUtils.h"
+#include "Characters/EnemyCharacter.h"
+
+
+// 带生存模式的测试地图
+static const TCHAR* FightSoakMapName = TEXT("/Game/_Game/Maps/GameModeTestMap");
+
+static constexpr int32 FightSoakNumClients = 4;
+
+// 等待客户端连上、第一波敌人生成后再开始统计
+static constexpr float FightSoakWarmUpSeconds = 10.f;
+
+static constexpr double FightSoakMeasureSeconds = 60.0;
+
+
+/**
+ * @brief 找到PIE中的专用服务器世界
+ */
+static UWorld* FindSoakServerWorld()
+{
+	for (const FWorldContext& WorldContext : GEngine->GetWorldContexts())
+	{
+		UWorld* World = WorldContext.World();
+		if (WorldContext.WorldType == EWorldType::PIE && World && World->GetNetMode() == NM_DedicatedServer)
+		{
+			return World;
+		}
+	}
+
+	return nullptr;
+}
+
+
+/**
+ * @brief 在专用服务器上统计一段时间内的发送字节数，按连接数与存活敌人数折算为每个敌人的带宽
+ */
+class FFightSoakMeasureBandwidthCommand : public IAutomationLatentCommand
+{
+public:
+	explicit FFightSoakMeasureBandwidthCommand(FAutomationTestBase* InTest)
+		: Test(InTest)
+	{
+	}
+
+	virtual bool Update() override
+	{
+		UWorld* ServerWorld = FindSoakServerWorld();
+		UNetDriver* NetDriver = ServerWorld ? ServerWorld->GetNetDriver() : nullptr;
+		if (!NetDriver)
+		{
+			Test->AddError(TEXT("No dedicated server net driver found in the PIE session"));
+			return true;
+		}
+
+		// 每次更新都采样敌人数量，取平均值折算
+		int32 NumEnemies = 0;
+		for (TActorIterator<AEnemyCharacter> EnemyIt(ServerWorld); EnemyIt; ++EnemyIt)
+		{
+			NumEnemies++;
+		}
+
+		if (StartTime < 0.0)
+		{
+			StartTime = FPlatformTime::Seconds();
+			StartOutBytes = NetDriver->OutTotalBytes;
+			return false;
+		}
+
+		EnemySamplesSum += NumEnemies;
+		NumEnemySamples++;
+
+		const double ElapsedSeconds = FPlatformTime::Seconds() - StartTime;
+		if (ElapsedSeconds < FightSoakMeasureSeconds)
+		{
+			return false;
+		}
+
+		const int32 NumConnections = NetDriver->ClientConnections.Num();
+		Test->TestEqual(TEXT("All soak clients stay connected"), NumConnections, FightSoakNumClients);
+
+		const double AverageEnemies = static_cast<double>(EnemySamplesSum) / FMath::Max(NumEnemySamples, 1);
+		if (AverageEnemies < 1.0)
+		{
+			Test->AddWarning(TEXT("No enemies were alive during the soak, per-enemy bandwidth is not meaningful"));
+			return true;
+		}
+
+		const double BytesPerSecond = static_cast<double>(NetDriver->OutTotalBytes - StartOutBytes) / ElapsedSeconds;
+		const double BytesPerSecondPerConnection = BytesPerSecond / FMath::Max(NumConnections, 1);
+
+		Test->AddInfo(FString::Printf(TEXT("Server out: %.1f B/s total, %.1f B/s per client, %.1f enemies alive on average"),
+			BytesPerSecond, BytesPerSecondPerConnection, AverageEnemies));
+		Test->AddInfo(FString::Printf(TEXT("Per-enemy bandwidth: %.1f B/s per client"), BytesPerSecondPerConnection / AverageEnemies));
+
+		return true;
+	}
+
+private:
+	FAutomationTestBase* Test = nullptr;
+	double StartTime = -1.0;
+	uint64 StartOutBytes = 0;
+	int64 EnemySamplesSum = 0;
+	int32 NumEnemySamples = 0;
+};
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFightSurvivalBandwidthSoakTest, "GASFightDemo.Network.SurvivalBandwidthSoak",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::StressFilter)
+
+bool FFightSurvivalBandwidthSoakTest::RunTest(const FString& Parameters)
+{
+	AutomationOpenMap(FightSoakMapName);
+
+	// 以专用服务器 + 4个客户端启动PIE，结束后恢复原来的设置
+	ULevelEditorPlaySettings* PlaySettings = GetMutableDefault<ULevelEditorPlaySettings>();
+
+	EPlayNetMode OriginalNetMode = PIE_Standalone;
+	PlaySettings->GetPlayNetMode(OriginalNetMode);
+	int32 OriginalNumClients = 1;
+	PlaySettings->GetPlayNumberOfClients(OriginalNumClients);
+	bool bOriginalRunUnderOneProcess = true;
+	PlaySettings->GetRunUnderOneProcess(bOriginalRunUnderOneProcess);
+	const bool bOriginalLaunchSeparateServer = PlaySettings->bLaunchSeparateServer;
+
+	PlaySettings->SetPlayNetMode(PIE_Client);
+	PlaySettings->SetPlayNumberOfClients(FightSoakNumClients);
+	PlaySettings->SetRunUnderOneProcess(true);
+	PlaySettings->bLaunchSeparateServer = true;
+
+	ADD_LATENT_AUTOMATION_COMMAND(FStartPIECommand(false));
+	ADD_LATENT_AUTOMATION_COMMAND(FEngineWaitLatentCommand(FightSoakWarmUpSeconds));
+	ADD_LATENT_AUTOMATION_COMMAND(FFightSoakMeasureBandwidthCommand(this));
+	ADD_LATENT_AUTOMATION_COMMAND(FEndPlayMapCommand());
+	ADD_LATENT_AUTOMATION_COMMAND(FFunctionLatentCommand([PlaySettings, OriginalNetMode, OriginalNumClients,
+		bOriginalRunUnderOneProcess, bOriginalLaunchSeparateServer]()
+	{
+		PlaySettings->SetPlayNetMode(OriginalNetMode);
+		PlaySettings->SetPlayNumberOfClients(OriginalNumClients);
+		PlaySettings->SetRunUnderOneProcess(bOriginalRunUnderOneProcess);
+		PlaySettings->bLaunchSeparateServer = bOriginalLaunchSeparateServer;
+		return true;
+	}));
+
+	return true;
+}
+
+#endif
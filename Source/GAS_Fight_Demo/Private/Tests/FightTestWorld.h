@@ -0,0 +1,47 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+
+
+/**
+ * @brief 自动化测试使用的临时游戏世界
+ *
+ * 构造时创建并开始游戏，析构时销毁 --> 需要生成Actor、注册组件的测试在栈上创建一个即可
+ */
+class FFightTestWorld
+{
+public:
+	FFightTestWorld()
+	{
+		World = UWorld::CreateWorld(EWorldType::Game, false);
+
+		FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+		WorldContext.SetCurrentWorld(World);
+
+		World->InitializeActorsForPlay(FURL());
+		World->BeginPlay();
+	}
+
+	~FFightTestWorld()
+	{
+		GEngine->DestroyWorldContext(World);
+		World->DestroyWorld(false);
+	}
+
+	FFightTestWorld(const FFightTestWorld&) = delete;
+	FFightTestWorld& operator=(const FFightTestWorld&) = delete;
+
+	FORCEINLINE UWorld* Get() const { return World; }
+
+private:
+	UWorld* World = nullptr;
+};
+
+#endif
@@ -0,0 +1,60 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Widgets/FightUIAssetCacheSubsystem.h"
+#include "UObject/UObjectGlobals.h"
+
+
+// 不存在的资源路径 --> 加载必定失败
+static const TCHAR* FightUIAssetCacheTestMissingPath = TEXT("/Game/FightTests/MissingUIAsset.MissingUIAsset");
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFightUIAssetCacheLoadFailureTest, "GASFightDemo.UI.AssetCacheLoadFailure",
+	EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FFightUIAssetCacheLoadFailureTest::RunTest(const FString& Parameters)
+{
+	// 缓存只依赖流式管理器，不需要游戏实例
+	UFightUIAssetCacheSubsystem* UIAssetCache = NewObject<UFightUIAssetCacheSubsystem>(GetTransientPackage());
+	const FSoftObjectPath MissingAssetPath(FightUIAssetCacheTestMissingPath);
+
+	int32 NumCallbacks = 0;
+	bool bAllCallbacksReceivedNull = true;
+	auto MakeCallback = [&NumCallbacks, &bAllCallbacksReceivedNull]()
+	{
+		return FFightOnUIAssetLoadedDelegate::CreateLambda([&NumCallbacks, &bAllCallbacksReceivedNull](UObject* LoadedAsset)
+		{
+			NumCallbacks++;
+			bAllCallbacksReceivedNull &= LoadedAsset == nullptr;
+		});
+	};
+
+	// 两个请求共享同一次加载
+	UIAssetCache->AcquireAsset(MissingAssetPath, MakeCallback());
+	UIAssetCache->AcquireAsset(MissingAssetPath, MakeCallback());
+	FlushAsyncLoading();
+
+	TestEqual(TEXT("Every waiting callback runs when the load fails"), NumCallbacks, 2);
+	TestTrue(TEXT("Failed loads report a null asset"), bAllCallbacksReceivedNull);
+
+	// 失败后的请求重新尝试加载，而不是等待已经结束的加载
+	UIAssetCache->AcquireAsset(MissingAssetPath, MakeCallback());
+	FlushAsyncLoading();
+
+	TestEqual(TEXT("A request after a failed load is answered too"), NumCallbacks, 3);
+	TestTrue(TEXT("The retried load also reports a null asset"), bAllCallbacksReceivedNull);
+	TestNull(TEXT("Nothing is cached for a failed load"), UIAssetCache->GetLoadedAsset(MissingAssetPath));
+
+	for (int32 ReleaseIndex = 0; ReleaseIndex < 3; ++ReleaseIndex)
+	{
+		UIAssetCache->ReleaseAsset(MissingAssetPath);
+	}
+
+	return true;
+}
+
+#endif
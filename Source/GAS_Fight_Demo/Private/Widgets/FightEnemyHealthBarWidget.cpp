@@ -0,0 +1,17 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Widgets/FightEnemyHealthBarWidget.h"
+#include "Components/ProgressBar.h"
+
+
+void UFightEnemyHealthBarWidget::SetHealthPercent(float InHealthPercent)
+{
+	if (FMath::IsNearlyEqual(CachedHealthPercent, InHealthPercent))
+	{
+		return;
+	}
+
+	CachedHealthPercent = InHealthPercent;
+	HealthProgressBar->SetPercent(InHealthPercent);
+}
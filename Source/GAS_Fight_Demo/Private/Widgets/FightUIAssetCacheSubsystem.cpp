@@ -0,0 +1,157 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Widgets/FightUIAssetCacheSubsystem.h"
+#include "GAS_Fight_Demo.h"
+#include "Engine/AssetManager.h"
+
+
+void UFightUIAssetCacheSubsystem::Deinitialize()
+{
+	for (TPair<FSoftObjectPath, FFightUIAssetEntry>& AssetEntry : AssetEntries)
+	{
+		if (AssetEntry.Value.StreamableHandle.IsValid())
+		{
+			AssetEntry.Value.StreamableHandle->CancelHandle();
+		}
+	}
+
+	AssetEntries.Empty();
+
+	Super::Deinitialize();
+}
+
+void UFightUIAssetCacheSubsystem::AcquireAsset(const FSoftObjectPath& InAssetPath, FFightOnUIAssetLoadedDelegate InOnLoaded)
+{
+	if (InAssetPath.IsNull())
+	{
+		InOnLoaded.ExecuteIfBound(nullptr);
+		return;
+	}
+
+	FFightUIAssetEntry& AssetEntry = AssetEntries.FindOrAdd(InAssetPath);
+	AssetEntry.RefCount++;
+
+	if (AssetEntry.LoadedAsset)
+	{
+		InOnLoaded.ExecuteIfBound(AssetEntry.LoadedAsset);
+		return;
+	}
+
+	if (InOnLoaded.IsBound())
+	{
+		AssetEntry.PendingCallbacks.Add(MoveTemp(InOnLoaded));
+	}
+
+	// 已有加载在进行中，只需等待
+	if (AssetEntry.StreamableHandle.IsValid())
+	{
+		return;
+	}
+
+	// 资源已经在内存中（如被其他系统加载过），不必再发起异步加载
+	if (UObject* ResidentAsset = InAssetPath.ResolveObject())
+	{
+		AssetEntry.LoadedAsset = ResidentAsset;
+		FlushPendingCallbacks(InAssetPath);
+		return;
+	}
+
+	TSharedPtr<FStreamableHandle> StreamableHandle = UAssetManager::GetStreamableManager().RequestAsyncLoad(
+		InAssetPath, FStreamableDelegate::CreateUObject(this, &ThisClass::OnAssetLoaded, InAssetPath));
+
+	// 加载回调可能已经同步执行并修改了映射，这里重新查找
+	FFightUIAssetEntry* FoundEntry = AssetEntries.Find(InAssetPath);
+	if (!FoundEntry)
+	{
+		return;
+	}
+
+	if (StreamableHandle.IsValid() && (FoundEntry->LoadedAsset || StreamableHandle->IsLoadingInProgress()))
+	{
+		FoundEntry->StreamableHandle = StreamableHandle;
+		return;
+	}
+
+	// 请求无效或已同步失败 --> 不保留句柄，等待中的回调收到nullptr，之后的请求重新尝试加载
+	if (StreamableHandle.IsValid())
+	{
+		StreamableHandle->ReleaseHandle();
+	}
+
+	FlushPendingCallbacks(InAssetPath);
+}
+
+void UFightUIAssetCacheSubsystem::ReleaseAsset(const FSoftObjectPath& InAssetPath)
+{
+	FFightUIAssetEntry* AssetEntry = AssetEntries.Find(InAssetPath);
+	if (!AssetEntry || --AssetEntry->RefCount > 0)
+	{
+		return;
+	}
+
+	if (AssetEntry->StreamableHandle.IsValid())
+	{
+		// 仍在加载中的句柄直接取消，已完成的句柄释放对资源的引用
+		if (AssetEntry->StreamableHandle->IsLoadingInProgress())
+		{
+			AssetEntry->StreamableHandle->CancelHandle();
+		}
+		else
+		{
+			AssetEntry->StreamableHandle->ReleaseHandle();
+		}
+	}
+
+	AssetEntries.Remove(InAssetPath);
+}
+
+UObject* UFightUIAssetCacheSubsystem::GetLoadedAsset(const FSoftObjectPath& InAssetPath) const
+{
+	const FFightUIAssetEntry* AssetEntry = AssetEntries.Find(InAssetPath);
+
+	return AssetEntry ? AssetEntry->LoadedAsset : nullptr;
+}
+
+void UFightUIAssetCacheSubsystem::OnAssetLoaded(FSoftObjectPath InAssetPath)
+{
+	FFightUIAssetEntry* AssetEntry = AssetEntries.Find(InAssetPath);
+	if (!AssetEntry)
+	{
+		return;
+	}
+
+	AssetEntry->LoadedAsset = InAssetPath.ResolveObject();
+
+	// 加载失败时同样回调，等待方收到nullptr；释放句柄，之后的请求重新尝试加载而不是一直等待这次失败的加载
+	if (!AssetEntry->LoadedAsset)
+	{
+		UE_LOG(LogFight, Warning, TEXT("Failed to load UI asset %s"), *InAssetPath.ToString());
+
+		if (AssetEntry->StreamableHandle.IsValid())
+		{
+			AssetEntry->StreamableHandle->ReleaseHandle();
+			AssetEntry->StreamableHandle.Reset();
+		}
+	}
+
+	FlushPendingCallbacks(InAssetPath);
+}
+
+void UFightUIAssetCacheSubsystem::FlushPendingCallbacks(const FSoftObjectPath& InAssetPath)
+{
+	FFightUIAssetEntry* AssetEntry = AssetEntries.Find(InAssetPath);
+	if (!AssetEntry || AssetEntry->PendingCallbacks.IsEmpty())
+	{
+		return;
+	}
+
+	// 回调中可能再次请求或释放资源，先移出回调列表与资源指针
+	TArray<FFightOnUIAssetLoadedDelegate> CallbacksToExecute = MoveTemp(AssetEntry->PendingCallbacks);
+	UObject* LoadedAsset = AssetEntry->LoadedAsset;
+
+	for (FFightOnUIAssetLoadedDelegate& Callback : CallbacksToExecute)
+	{
+		Callback.ExecuteIfBound(LoadedAsset);
+	}
+}
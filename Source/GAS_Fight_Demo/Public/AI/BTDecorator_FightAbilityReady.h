@@ -0,0 +1,52 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BehaviorTree/BTDecorator.h"
+#include "GameplayTagContainer.h"
+#include "BTDecorator_FightAbilityReady.generated.h"
+
+
+/**
+ * @brief 装饰器内存：该分支上次被选中的时间
+ */
+struct FFightAbilityReadyDecoratorMemory
+{
+	double LastActivationTime = 0.0;
+	bool bHasActivated = false;
+};
+
+
+/**
+ * @brief 按冷却筛选分支：存在可选择且不在冷却中的AbilityTag能力时通过
+ *
+ * @details
+ * 1. 冷却判断直接使用能力系统中的冷却效果，攻击选择不再需要在蓝图中查询
+ * 2. MinReselectInterval为该AI在此分支上的额外间隔，分支被选中时开始计时
+ */
+UCLASS()
+class GAS_FIGHT_DEMO_API UBTDecorator_FightAbilityReady : public UBTDecorator
+{
+	GENERATED_BODY()
+
+	UBTDecorator_FightAbilityReady();
+
+	// ~Begin UBTNode Interface
+	virtual uint16 GetInstanceMemorySize() const override;
+	virtual void InitializeMemory(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, EBTMemoryInit::Type InitType) const override;
+	virtual void CleanupMemory(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, EBTMemoryClear::Type CleanupType) const override;
+	virtual FString GetStaticDescription() const override;
+	// ~End UBTNode Interface
+
+	// ~Begin UBTDecorator Interface
+	virtual bool CalculateRawConditionValue(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory) const override;
+	virtual void OnNodeActivation(FBehaviorTreeSearchData& SearchData) override;
+	// ~End UBTDecorator Interface
+
+	UPROPERTY(EditAnywhere, Category = "Ability", meta = (Categories = "Enemy.Ability"))
+	FGameplayTag AbilityTag;
+
+	UPROPERTY(EditAnywhere, Category = "Ability", meta = (ClampMin = "0.0"))
+	float MinReselectInterval;
+};
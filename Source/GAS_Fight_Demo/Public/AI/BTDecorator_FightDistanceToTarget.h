@@ -0,0 +1,43 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BehaviorTree/BTDecorator.h"
+#include "BTDecorator_FightDistanceToTarget.generated.h"
+
+
+/**
+ * @brief 到目标的距离在[MinDistance, MaxDistance]之间时通过
+ *
+ * 设置了观察者中断时每帧重新判断，结果变化后请求行为树重新选择分支
+ */
+UCLASS()
+class GAS_FIGHT_DEMO_API UBTDecorator_FightDistanceToTarget : public UBTDecorator
+{
+	GENERATED_BODY()
+
+	UBTDecorator_FightDistanceToTarget();
+
+	// ~Begin UBTNode Interface
+	virtual void InitializeFromAsset(UBehaviorTree& Asset) override;
+	virtual FString GetStaticDescription() const override;
+	// ~End UBTNode Interface
+
+	// ~Begin UBTDecorator Interface
+	virtual bool CalculateRawConditionValue(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory) const override;
+	virtual void TickNode(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, float DeltaSeconds) override;
+	// ~End UBTDecorator Interface
+
+	UPROPERTY(EditAnywhere, Category = "Target")
+	FBlackboardKeySelector InTargetActorKey;
+
+	UPROPERTY(EditAnywhere, Category = "Target", meta = (ClampMin = "0.0"))
+	float MinDistance;
+
+	UPROPERTY(EditAnywhere, Category = "Target", meta = (ClampMin = "0.0"))
+	float MaxDistance;
+
+	UPROPERTY(EditAnywhere, Category = "Target")
+	bool bUse2DDistance;
+};
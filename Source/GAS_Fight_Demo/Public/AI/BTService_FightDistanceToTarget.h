@@ -0,0 +1,63 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BehaviorTree/BTService.h"
+#include "BTService_FightDistanceToTarget.generated.h"
+
+
+/**
+ * @brief 服务内存：上次写入黑板的值
+ */
+struct FFightDistanceToTargetServiceMemory
+{
+	float LastWrittenDistance = -1.f;
+	int8 LastWrittenInRange = INDEX_NONE;
+};
+
+
+/**
+ * @brief 按间隔计算到目标的距离并写入黑板，替代蓝图中每次Tick的距离判断
+ *
+ * 距离变化小于DistanceWriteTolerance、是否在范围内未变化时不写黑板，避免无谓地触发黑板观察者
+ */
+UCLASS()
+class GAS_FIGHT_DEMO_API UBTService_FightDistanceToTarget : public UBTService
+{
+	GENERATED_BODY()
+
+	UBTService_FightDistanceToTarget();
+
+	// ~Begin UBTNode Interface
+	virtual void InitializeFromAsset(UBehaviorTree& Asset) override;
+	virtual uint16 GetInstanceMemorySize() const override;
+	virtual void InitializeMemory(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, EBTMemoryInit::Type InitType) const override;
+	virtual void CleanupMemory(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, EBTMemoryClear::Type CleanupType) const override;
+	virtual FString GetStaticDescription() const override;
+	// ~End UBTNode Interface
+
+	virtual void TickNode(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, float DeltaSeconds) override;
+
+	// 目标Actor的黑板键
+	UPROPERTY(EditAnywhere, Category = "Target")
+	FBlackboardKeySelector InTargetActorKey;
+
+	// 写入距离的浮点黑板键，可不设置
+	UPROPERTY(EditAnywhere, Category = "Target")
+	FBlackboardKeySelector OutDistanceKey;
+
+	// 写入是否在InRangeDistance以内的布尔黑板键，可不设置
+	UPROPERTY(EditAnywhere, Category = "Target")
+	FBlackboardKeySelector OutIsInRangeKey;
+
+	UPROPERTY(EditAnywhere, Category = "Target", meta = (ClampMin = "0.0"))
+	float InRangeDistance;
+
+	UPROPERTY(EditAnywhere, Category = "Target", meta = (ClampMin = "0.0"))
+	float DistanceWriteTolerance;
+
+	// 只计算水平距离
+	UPROPERTY(EditAnywhere, Category = "Target")
+	bool bUse2DDistance;
+};
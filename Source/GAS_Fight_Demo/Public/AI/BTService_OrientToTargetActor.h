@@ -31,11 +31,14 @@ class GAS_FIGHT_DEMO_API UBTService_OrientToTargetActor : public UBTService
 	// ~End UBTNode Interface
 
 	/**
-	 * @brief 行为树服务节点的每帧更新函数
-	 * 
-	 * 主要功能：让AI角色平滑旋转朝向目标Actor
+	 * @brief 服务节点激活时调用：向朝向子系统注册，之后由子系统每帧批量旋转
+	 */
+	virtual void OnBecomeRelevant(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory) override;
+
+	/**
+	 * @brief 服务节点失活时调用：从朝向子系统注销
 	 */
-	virtual void TickNode(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, float DeltaSeconds) override;
+	virtual void OnCeaseRelevant(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory) override;
 
 	// 目标Actor的黑板键选择器，用于指定要朝向哪个目标
 	UPROPERTY(EditAnywhere, Category = "Target")
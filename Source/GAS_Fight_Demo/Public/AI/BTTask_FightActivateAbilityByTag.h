@@ -0,0 +1,67 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BehaviorTree/BTTaskNode.h"
+#include "GameplayTagContainer.h"
+#include "GameplayAbilitySpec.h"
+#include "BTTask_FightActivateAbilityByTag.generated.h"
+
+
+class UFightAbilitySystemComponent;
+
+
+/**
+ * @brief 任务内存：被激活的能力及已等待的时间
+ */
+struct FFightActivateAbilityByTagTaskMemory
+{
+	TWeakObjectPtr<UFightAbilitySystemComponent> AbilitySystemComponent;
+	FGameplayAbilitySpecHandle ActivatedSpecHandle;
+	float ElapsedTime = 0.f;
+};
+
+
+/**
+ * @brief 按标签激活能力，并可等待能力结束
+ *
+ * @details
+ * 1. 激活走UFightAbilitySystemComponent的按标签加权选择，与蓝图中的TryActivateAbilityByTag一致
+ * 2. 等待期间每帧只按句柄查询能力是否仍在激活中，不绑定能力结束委托 --> 节点不实例化，多个AI共享同一节点
+ * 3. 超时后取消能力并返回失败；任务被中断时可选择取消能力
+ */
+UCLASS()
+class GAS_FIGHT_DEMO_API UBTTask_FightActivateAbilityByTag : public UBTTaskNode
+{
+	GENERATED_BODY()
+
+	UBTTask_FightActivateAbilityByTag();
+
+	// ~Begin UBTNode Interface
+	virtual uint16 GetInstanceMemorySize() const override;
+	virtual void InitializeMemory(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, EBTMemoryInit::Type InitType) const override;
+	virtual void CleanupMemory(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, EBTMemoryClear::Type CleanupType) const override;
+	virtual FString GetStaticDescription() const override;
+	// ~End UBTNode Interface
+
+	// ~Begin UBTTaskNode Interface
+	virtual EBTNodeResult::Type ExecuteTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory) override;
+	virtual EBTNodeResult::Type AbortTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory) override;
+	virtual void TickTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, float DeltaSeconds) override;
+	// ~End UBTTaskNode Interface
+
+	UPROPERTY(EditAnywhere, Category = "Ability", meta = (Categories = "Enemy.Ability"))
+	FGameplayTag AbilityTag;
+
+	// 关闭时激活成功立即返回成功
+	UPROPERTY(EditAnywhere, Category = "Ability")
+	bool bWaitForAbilityEnd;
+
+	// 等待的最长时间，小于等于0时不限制
+	UPROPERTY(EditAnywhere, Category = "Ability", meta = (EditCondition = "bWaitForAbilityEnd"))
+	float TimeLimit;
+
+	UPROPERTY(EditAnywhere, Category = "Ability", meta = (EditCondition = "bWaitForAbilityEnd"))
+	bool bCancelAbilityOnAbort;
+};
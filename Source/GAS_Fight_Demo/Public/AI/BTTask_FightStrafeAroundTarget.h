@@ -0,0 +1,78 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BehaviorTree/BTTaskNode.h"
+#include "BTTask_FightStrafeAroundTarget.generated.h"
+
+
+/**
+ * @brief 任务内存：扫射状态与进入扫射前的移动设置
+ */
+struct FFightStrafeAroundTargetTaskMemory
+{
+	TWeakObjectPtr<APawn> OwningPawn;
+	TWeakObjectPtr<AActor> TargetActor;
+
+	float RemainingTime = 0.f;
+
+	// 1为逆时针，-1为顺时针
+	float DirectionSign = 1.f;
+	float DesiredRadius = 0.f;
+
+	bool bSavedOrientRotationToMovement = false;
+	bool bSavedUseControllerDesiredRotation = false;
+};
+
+
+/**
+ * @brief 面向目标绕圈扫射一段时间
+ *
+ * @details
+ * 1. 执行期间给Pawn添加Enemy.Status.Strafing标签，并让控制器聚焦目标，角色朝向改为跟随控制器
+ * 2. 每帧沿切线方向移动，并按与期望半径的偏差向内/向外修正
+ * 3. 结束或被中断时移除标签、清除聚焦并还原移动设置
+ */
+UCLASS()
+class GAS_FIGHT_DEMO_API UBTTask_FightStrafeAroundTarget : public UBTTaskNode
+{
+	GENERATED_BODY()
+
+	UBTTask_FightStrafeAroundTarget();
+
+	// ~Begin UBTNode Interface
+	virtual void InitializeFromAsset(UBehaviorTree& Asset) override;
+	virtual uint16 GetInstanceMemorySize() const override;
+	virtual void InitializeMemory(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, EBTMemoryInit::Type InitType) const override;
+	virtual void CleanupMemory(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, EBTMemoryClear::Type CleanupType) const override;
+	virtual FString GetStaticDescription() const override;
+	// ~End UBTNode Interface
+
+	// ~Begin UBTTaskNode Interface
+	virtual EBTNodeResult::Type ExecuteTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory) override;
+	virtual void TickTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, float DeltaSeconds) override;
+	virtual void OnTaskFinished(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, EBTNodeResult::Type TaskResult) override;
+	// ~End UBTTaskNode Interface
+
+	UPROPERTY(EditAnywhere, Category = "Strafe")
+	FBlackboardKeySelector InTargetActorKey;
+
+	// 绕圈的期望半径，小于等于0时保持开始扫射时的距离
+	UPROPERTY(EditAnywhere, Category = "Strafe")
+	float StrafeRadius;
+
+	UPROPERTY(EditAnywhere, Category = "Strafe", meta = (ClampMin = "0.0"))
+	float StrafeDuration;
+
+	UPROPERTY(EditAnywhere, Category = "Strafe", meta = (ClampMin = "0.0"))
+	float StrafeDurationDeviation;
+
+	// 半径偏差的修正强度
+	UPROPERTY(EditAnywhere, Category = "Strafe", meta = (ClampMin = "0.0"))
+	float RadiusCorrectionStrength;
+
+	// 开启时随机选择绕圈方向，否则总是逆时针
+	UPROPERTY(EditAnywhere, Category = "Strafe")
+	bool bRandomDirection;
+};
@@ -20,6 +20,11 @@ struct FRotateToFaceTargetTaskMemory
 	void Reset();
 };
 
+/**
+ * @brief 平滑旋转至面向目标，达到角度精度后成功
+ *
+ * 旋转交给UFightOrientationSubsystem在每帧统一批量处理，任务每帧只做一次水平朝向的精度判断
+ */
 UCLASS()
 class GAS_FIGHT_DEMO_API UBTTask_RotateToFaceTarget : public UBTTaskNode
 {
@@ -51,7 +56,12 @@ class GAS_FIGHT_DEMO_API UBTTask_RotateToFaceTarget : public UBTTaskNode
 	virtual void TickTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, float DeltaSeconds) override;
 
 	/**
-	 * @brief 检查AI是否已达到面向目标的角度精度
+	 * @brief 任务结束（成功/失败/中断）时注销朝向请求
+	 */
+	virtual void OnTaskFinished(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, EBTNodeResult::Type TaskResult) override;
+
+	/**
+	 * @brief 检查AI是否已达到面向目标的角度精度 --> 只比较水平朝向
 	 */
 	bool HasReachedAnglePrecision(APawn* QueryPawn, AActor* TargetActor) const;
 
@@ -63,4 +73,7 @@ class GAS_FIGHT_DEMO_API UBTTask_RotateToFaceTarget : public UBTTaskNode
 
 	UPROPERTY(EditAnywhere, Category = "Face Target")
 	FBlackboardKeySelector InTargetToFaceKey;
+
+	// AnglePrecision的余弦值，在InitializeFromAsset中预先计算
+	float AnglePrecisionCos;
 };
@@ -0,0 +1,14 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Stats/Stats.h"
+
+
+/**
+ * @brief 原生行为树节点的耗时统计组
+ *
+ * 每个节点在自己的源文件中声明周期统计，控制台输入 stat FightBT 查看
+ */
+DECLARE_STATS_GROUP(TEXT("FightBT"), STATGROUP_FightBT, STATCAT_Advanced);
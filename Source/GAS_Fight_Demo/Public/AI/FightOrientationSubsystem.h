@@ -0,0 +1,154 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "BehaviorTree/BehaviorTreeTypes.h"
+#include "UObject/ObjectKey.h"
+#include "FightOrientationSubsystem.generated.h"
+
+
+class UBlackboardComponent;
+
+
+/**
+ * @brief 被其它请求者覆盖而挂起的朝向请求，覆盖者注销后恢复
+ */
+struct FFightSuspendedOrientationRequest
+{
+	TWeakObjectPtr<APawn> Pawn;
+	TWeakObjectPtr<AActor> TargetActor;
+	TWeakObjectPtr<UBlackboardComponent> Blackboard;
+	FBlackboard::FKey TargetKeyID = FBlackboard::InvalidKey;
+	float InterpSpeed = 0.f;
+	const UObject* Requester = nullptr;
+};
+
+/**
+ * @brief 群体朝向处理器：统一处理所有请求"朝向目标"的Pawn
+ *
+ * 行为树服务/任务只负责注册与注销，每帧由本子系统集中完成：
+ * 1. 收集阶段：解析Pawn与目标位置，写入连续的SoA数组
+ * 2. 计算阶段：在一个紧凑循环中只对Yaw做插值（对SIMD/自动向量化友好）
+ * 3. 应用阶段：只对Yaw确实发生变化的Pawn提交旋转，跳过其余Pawn的变换更新
+ *
+ * 同一Pawn同时只有一个请求生效：后注册的请求者覆盖并挂起之前的请求，注销后恢复被挂起的请求
+ */
+UCLASS()
+class GAS_FIGHT_DEMO_API UFightOrientationSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	// ~Begin USubsystem Interface
+	virtual void Deinitialize() override;
+	// ~End USubsystem Interface
+
+	// ~Begin FTickableGameObject Interface
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+	// ~End FTickableGameObject Interface
+
+	/**
+	 * @brief 注册朝向请求，目标每帧从黑板键中读取
+	 *
+	 * @param InPawn 需要旋转的Pawn
+	 * @param InBlackboard 存放目标Actor的黑板组件
+	 * @param InTargetKeyID 目标Actor对应的黑板键ID
+	 * @param InInterpSpeed 旋转插值速度
+	 * @param InRequester 请求者（服务/任务节点），注销时用于匹配
+	 */
+	void RegisterOrientationRequest(APawn* InPawn, UBlackboardComponent* InBlackboard, FBlackboard::FKey InTargetKeyID,
+		float InInterpSpeed, const UObject* InRequester);
+
+	/**
+	 * @brief 注册朝向请求，目标为固定的Actor
+	 */
+	void RegisterOrientationRequest(APawn* InPawn, AActor* InTargetActor, float InInterpSpeed, const UObject* InRequester);
+
+	/**
+	 * @brief 注销朝向请求，只有请求者匹配时才会移除
+	 *
+	 * 请求者的请求正处于挂起状态时直接丢弃
+	 */
+	void UnregisterOrientationRequest(const APawn* InPawn, const UObject* InRequester);
+
+	/**
+	 * @brief 只用水平分量判断朝向与指向目标方向的夹角是否不超过阈值
+	 *
+	 * @param InForward 当前朝向，不要求归一化
+	 * @param InToTarget 指向目标的向量，不要求归一化
+	 * @param InCosThreshold 角度阈值的余弦值，由调用方预先计算
+	 * @return 夹角不超过阈值时返回true；与目标水平重合时视为已面向
+	 */
+	static FORCEINLINE bool IsFacingWithinCosine(const FVector& InForward, const FVector& InToTarget, float InCosThreshold)
+	{
+		// cosθ >= 阈值 两边同乘两向量长度后再平方比较 --> 不需要开方与反余弦
+		const double Dot = InForward.X * InToTarget.X + InForward.Y * InToTarget.Y;
+		const double LengthSquaredProduct = InForward.SizeSquared2D() * InToTarget.SizeSquared2D();
+		if (LengthSquaredProduct <= UE_SMALL_NUMBER)
+		{
+			return true;
+		}
+
+		const double ThresholdSquared = static_cast<double>(InCosThreshold) * InCosThreshold * LengthSquaredProduct;
+		return InCosThreshold >= 0.f ?
+			Dot > 0.0 && Dot * Dot >= ThresholdSquared :
+			Dot >= 0.0 || Dot * Dot <= ThresholdSquared;
+	}
+
+protected:
+	// ~Begin UWorldSubsystem Interface
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	// ~End UWorldSubsystem Interface
+
+private:
+	/**
+	 * @brief 查找Pawn对应的请求下标，不存在时返回INDEX_NONE --> 通过RequestIndexByPawn查找，不遍历请求数组
+	 */
+	int32 FindRequestIndex(const APawn* InPawn) const;
+
+	/**
+	 * @brief 找到或新增一条请求，返回其下标
+	 */
+	int32 FindOrAddRequest(APawn* InPawn);
+
+	/**
+	 * @brief 以交换删除的方式移除请求，保持所有数组紧凑
+	 */
+	void RemoveRequestAtSwap(int32 InIndex);
+
+	/**
+	 * @brief 新的请求者覆盖已有请求前，把已有请求移入挂起列表
+	 */
+	void SuspendRequest(int32 InIndex, const UObject* InNewRequester);
+
+	/**
+	 * @brief 恢复该Pawn最近一次被挂起的请求
+	 */
+	void ResumeSuspendedRequest(const APawn* InPawn);
+
+	// 注册的请求，以SoA方式存放，同一下标对应同一个请求
+	TArray<TWeakObjectPtr<APawn>> RequestPawns;
+	TArray<TObjectKey<APawn>> RequestPawnKeys;
+	TArray<TWeakObjectPtr<AActor>> RequestTargetActors;
+	TArray<TWeakObjectPtr<UBlackboardComponent>> RequestBlackboards;
+	TArray<FBlackboard::FKey> RequestTargetKeyIDs;
+	TArray<float> RequestInterpSpeeds;
+	TArray<const UObject*> RequestOwners;
+
+	// Pawn到请求下标的映射 --> 使用TObjectKey，Pawn被销毁后仍能按原键移除
+	TMap<TObjectKey<APawn>, int32> RequestIndexByPawn;
+
+	// 被覆盖的请求，数量很少，按挂起顺序存放
+	TArray<FFightSuspendedOrientationRequest> SuspendedRequests;
+
+	// 每帧复用的临时数组 --> 只存放本帧有效的请求，Reset不会释放内存
+	TArray<APawn*> FramePawns;
+	TArray<float> FrameDeltaX;
+	TArray<float> FrameDeltaY;
+	TArray<float> FrameInterpSpeeds;
+	TArray<float> FrameCurrentYaws;
+	TArray<float> FrameNewYaws;
+};
@@ -61,6 +61,7 @@ public:
 
 protected:
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 	/**
 	 * @brief 角色被控制器占有时的回调函数
@@ -117,6 +118,14 @@ protected:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "UI")
 	UWidgetComponent* EnemyHealthWidgetComponent;
 
+	/**
+	 * @brief 是否使用玩家控制器上的共享血条覆盖层
+	 *
+	 * 为true且覆盖层可用时，BeginPlay中会停用EnemyHealthWidgetComponent（不创建控件、隐藏、不Tick，组件保留），改由覆盖层统一绘制血条
+	 */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "UI")
+	bool bUseSharedHealthBarOverlay = true;
+
 	UFUNCTION()
 	virtual void OnBodyCollisionBoxBeginOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor,
 		UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult);
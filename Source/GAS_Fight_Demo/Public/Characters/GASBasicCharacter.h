@@ -72,6 +72,13 @@ public:
 
 protected:
 
+	//~ Begin AActor Interface.
+	/**
+	 * @brief 组件初始化完成后初始化能力系统的Actor信息 --> 服务器与所有客户端都执行
+	 */
+	virtual void PostInitializeComponents() override;
+	//~ End AActor Interface.
+
 	//~ Begin APawn Interface.
 	/**
 	 * @brief 角色被控制器占有时的回调函数
@@ -83,11 +90,16 @@ protected:
 	 *
 	 * @details
 	 * 1. 调用父类的PossessedBy函数
-	 * 2. 初始化能力系统组件的Actor信息
+	 * 2. 刷新能力系统组件的Actor信息
 	 * 3. 将属性集注册到能力系统组件
 	 * 4. 检查并确保启动数据已分配
 	 */
 	virtual void PossessedBy(AController* NewController) override;
+
+	/**
+	 * @brief 客户端收到控制器复制时刷新能力系统的Actor信息 --> 服务器在PossessedBy中完成同样的刷新
+	 */
+	virtual void OnRep_Controller() override;
 	//~ End APawn Interface.
 
 	/**
@@ -12,7 +12,11 @@ class USpringArmComponent;
 class UCameraComponent;
 class UDataAsset_InputConfig;
 struct FInputActionValue;
+struct FFightInputLogEvent;
+class UPlayerInputComponent;
 class UPlayerCombatComponent;
+class UFightHitStopComponent;
+class AFightStoneBase;
 class UPlayerUIComponent;
 
 /**
@@ -55,8 +59,24 @@ public:
 	virtual UPlayerUIComponent* GetPlayerUIComponent() const override;
 	//~ End IPawnUIInterface Interface.
 
+	virtual void Tick(float DeltaTime) override;
+
+	/**
+	 * @brief 登记/注销与玩家重叠的石头，由石头的重叠事件维护
+	 *
+	 * 登记时尝试激活捡石头能力，同一帧内多块石头重叠只尝试一次
+	 */
+	void RegisterOverlappingStone(AFightStoneBase* InStone);
+	void UnregisterOverlappingStone(AFightStoneBase* InStone);
+
+	/**
+	 * @brief 获取当前与玩家重叠的石头，顺带清理已失效的条目
+	 */
+	void GetOverlappingStones(TArray<AFightStoneBase*>& OutStones);
+
 protected:
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 	/**
 	 * @brief 设置玩家输入组件
@@ -107,6 +127,14 @@ private:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Combat", meta = (AllowPrivateAccess = "true"))
 	TObjectPtr<UPlayerCombatComponent> PlayerCombatComponent;
 
+	/**
+	 * @brief 顿帧调度组件
+	 *
+	 * 合并同一时间段内的多次命中顿帧
+	 */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Combat", meta = (AllowPrivateAccess = "true"))
+	TObjectPtr<UFightHitStopComponent> FightHitStopComponent;
+
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "UI", meta = (AllowPrivateAccess = "true"))
 	UPlayerUIComponent* PlayerUIComponent;
 
@@ -158,11 +186,35 @@ private:
 	 */
 	void Input_AbilityInputReleased(FGameplayTag InInputTag);
 
+	/**
+	 * @brief 按游戏模式的确定性选项开始录制或回放输入
+	 */
+	void InitInputRecordingAndReplay(UPlayerInputComponent* InFightInputComponent);
+
+	/**
+	 * @brief 把回放事件派发到对应的输入处理函数
+	 */
+	void HandleReplayInputEvent(const FFightInputLogEvent& InEvent, const FGameplayTag& InInputTag);
+
+	UPROPERTY()
+	TObjectPtr<UPlayerInputComponent> CachedFightInputComponent;
+
 #pragma endregion
 
+	// 当前与玩家重叠的石头
+	TArray<TWeakObjectPtr<AFightStoneBase>> OverlappingStones;
+
+	// 上次尝试激活捡石头能力的帧
+	uint64 LastPickUpStonesActivationFrame = 0;
+
 public:
 	FORCEINLINE UPlayerCombatComponent* GetPlayerCombatComponent() const
 	{
 		return PlayerCombatComponent;
 	}
+
+	FORCEINLINE UFightHitStopComponent* GetFightHitStopComponent() const
+	{
+		return FightHitStopComponent;
+	}
 };
@@ -0,0 +1,123 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/PawnExtensionComponentBase.h"
+#include "FightTypes/FightTimerWheel.h"
+#include "FightHitStopComponent.generated.h"
+
+
+class USkeletalMeshComponent;
+
+/**
+ * @brief 仅放慢表现时被放慢的骨骼网格体及其原本的动画播放倍率
+ */
+struct FFightHitStopMesh
+{
+	TWeakObjectPtr<USkeletalMeshComponent> Mesh;
+	float OriginalAnimRateScale = 1.f;
+};
+
+/**
+ * @brief 顿帧期间被放慢的Actor及其原本的时间膨胀
+ */
+struct FFightHitStopActor
+{
+	TWeakObjectPtr<AActor> Actor;
+	float OriginalTimeDilation = 1.f;
+
+	// 仅放慢表现时不改动Actor的时间膨胀，只记录被放慢的骨骼网格体
+	bool bDilatedVisualsOnly = false;
+	TArray<FFightHitStopMesh> Meshes;
+};
+
+
+/**
+ * @brief 顿帧调度组件
+ *
+ * 替代每次命中都发送Player.Event.HitPause并激活一次顿帧能力的做法，
+ * 把重叠的顿帧请求合并为同一个CustomTimeDilation窗口，作用于拥有者与被命中的目标
+ *
+ * @details
+ * 1. 窗口未开启时，请求开启窗口并放慢拥有者；窗口内的请求只追加目标并在上限内延长结束时间
+ * 2. 窗口从开启时刻起最长持续MaxHitStopDuration，一次挥砍穿过大群敌人也不会越顿越久
+ * 3. 结束时间由战斗定时器子系统计时，不受被放慢的Actor自身的时间膨胀影响
+ * 4. 顿帧只是本地手感，仅在拥有者被本地控制时生效，服务器上的远端角色不做处理
+ * 5. 联网时只放慢骨骼网格体的动画播放倍率 --> 改动自主代理的CustomTimeDilation会让本地移动模拟与服务器不一致，引发移动纠正
+ */
+UCLASS(ClassGroup=(Custom), meta=(BlueprintSpawnableComponent))
+class GAS_FIGHT_DEMO_API UFightHitStopComponent : public UPawnExtensionComponentBase
+{
+	GENERATED_BODY()
+
+public:
+	UFightHitStopComponent();
+
+	/**
+	 * @brief 请求一次顿帧
+	 *
+	 * @param InHitActor 被命中的目标，为空时只放慢拥有者
+	 */
+	void RequestHitStop(AActor* InHitActor);
+
+	/**
+	 * @brief 立即结束当前顿帧窗口并还原所有Actor的时间膨胀
+	 */
+	void EndHitStop();
+
+	FORCEINLINE bool IsHitStopSchedulerEnabled() const { return bUseHitStopScheduler; }
+	FORCEINLINE bool IsHitStopActive() const { return !DilatedActors.IsEmpty(); }
+
+#if WITH_DEV_AUTOMATION_TESTS
+	/**
+	 * @brief 仅供自动化测试使用 --> 测试世界是单机模式，强制走联网时只放慢表现的分支
+	 */
+	FORCEINLINE void SetDilateVisualsOnlyForTesting(bool bInDilateVisualsOnly) { bForceDilateVisualsOnlyForTesting = bInDilateVisualsOnly; }
+#endif
+
+protected:
+	// ~Begin UActorComponent Interface
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+	// ~End UActorComponent Interface
+
+private:
+	void AddDilatedActor(AActor* InActor);
+	void RestoreDilatedActor(const FFightHitStopActor& InDilatedActor) const;
+
+	/**
+	 * @brief 是否只放慢表现 --> 单机时放慢整个Actor，联网时只放慢骨骼网格体的动画
+	 */
+	bool ShouldDilateVisualsOnly() const;
+
+	// 关闭时回退到发送Player.Event.HitPause，由顿帧能力处理
+	UPROPERTY(EditDefaultsOnly, Category = "HitStop")
+	bool bUseHitStopScheduler = true;
+
+	// 单次命中的顿帧时长
+	UPROPERTY(EditDefaultsOnly, Category = "HitStop", meta = (ClampMin = "0.0", EditCondition = "bUseHitStopScheduler"))
+	float HitStopDuration = 0.08f;
+
+	// 合并后的顿帧窗口最长时长
+	UPROPERTY(EditDefaultsOnly, Category = "HitStop", meta = (ClampMin = "0.0", EditCondition = "bUseHitStopScheduler"))
+	float MaxHitStopDuration = 0.2f;
+
+	// 顿帧期间的时间膨胀
+	UPROPERTY(EditDefaultsOnly, Category = "HitStop", meta = (ClampMin = "0.0", ClampMax = "1.0", EditCondition = "bUseHitStopScheduler"))
+	float HitStopTimeDilation = 0.05f;
+
+	// 是否同时放慢被命中的目标
+	UPROPERTY(EditDefaultsOnly, Category = "HitStop", meta = (EditCondition = "bUseHitStopScheduler"))
+	bool bDilateHitTargets = true;
+
+	TArray<FFightHitStopActor> DilatedActors;
+
+	double WindowStartTime = 0.0;
+	double WindowEndTime = 0.0;
+
+	FFightTimerHandle EndHitStopTimerHandle;
+
+#if WITH_DEV_AUTOMATION_TESTS
+	bool bForceDilateVisualsOnlyForTesting = false;
+#endif
+};
@@ -31,6 +31,22 @@ enum class EToggleDamageType : uint8
 };
 
 
+/**
+ * @brief 携带武器的复制条目 --> TMap无法复制，武器映射表以数组形式同步给客户端
+ */
+USTRUCT()
+struct FFightCarriedWeaponEntry
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	FGameplayTag WeaponTag;
+
+	UPROPERTY()
+	TObjectPtr<AFightWeaponBase> Weapon;
+};
+
+
 /**
  * @brief Pawn战斗组件类
  *
@@ -51,6 +67,12 @@ class GAS_FIGHT_DEMO_API UPawnCombatComponent : public UPawnExtensionComponentBa
 	GENERATED_BODY()
 	
 public:
+	UPawnCombatComponent();
+
+	// ~Begin UObject Interface
+	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+	// ~End UObject Interface
+
 	/**
 	 * @brief 注册已生成的武器到角色武器映射中
 	 *
@@ -91,11 +113,19 @@ public:
 	 * @brief 当前装备武器的Gameplay标签
 	 *
 	 * 用于标识角色当前正在使用的武器
-	 * 可在蓝图中读取和修改
+	 * 可在蓝图中读取和修改，修改需经过SetCurrentEquippedWeaponTag以标记复制并切换武器的网络休眠
 	 */
-	UPROPERTY(BlueprintReadWrite, Category = "Combat")
+	UPROPERTY(BlueprintReadWrite, BlueprintSetter = SetCurrentEquippedWeaponTag, Replicated, Category = "Combat")
 	FGameplayTag CurrentEquippedWeaponTag;
 
+	/**
+	 * @brief 设置当前装备武器的标签
+	 *
+	 * 标签变化时标记推送复制，装备中的武器保持唤醒，被卸下的武器进入网络休眠
+	 */
+	UFUNCTION(BlueprintSetter)
+	void SetCurrentEquippedWeaponTag(FGameplayTag InWeaponTag);
+
 	/**
 	 * @brief 获取角色当前装备的武器实例
 	 *
@@ -160,6 +190,11 @@ protected:
 	 */
 	virtual void ToggleBodyCollisionBoxCollision(bool bShouldEnable, EToggleDamageType ToggleDamageType);
 
+	/**
+	 * @brief 武器注册完成后调用，供子类扩展
+	 */
+	virtual void OnWeaponRegistered(FGameplayTag InWeaponTag, AFightWeaponBase* InWeapon) {}
+
 	/**
 	 * @brief 重叠的演员列表
 	 *
@@ -176,4 +211,16 @@ private:
 	 * 用于快速查找和管理角色携带的各种武器
 	 */
 	TMap<FGameplayTag, AFightWeaponBase*> CharacterCarriedWeaponMap;
+
+	/**
+	 * @brief 把武器的命中/拔出委托绑定到本组件，每把武器只绑定一次
+	 */
+	void BindWeaponDelegates(AFightWeaponBase* InWeapon);
+
+	UFUNCTION()
+	void OnRep_CarriedWeapons();
+
+	// 武器映射表的复制副本，只在注册武器时变化
+	UPROPERTY(ReplicatedUsing = OnRep_CarriedWeapons)
+	TArray<FFightCarriedWeaponEntry> ReplicatedCarriedWeapons;
 };
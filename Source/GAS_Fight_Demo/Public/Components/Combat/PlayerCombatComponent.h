@@ -69,4 +69,43 @@ public:
 	 * @param InteractedActor 交互的目标Actor
 	 */
 	virtual void OnWeaponPulledFromTarget(AActor* InteractedActor) override;
+
+protected:
+	/**
+	 * @brief 本地玩家获得玩家武器（标签位于Player.Weapon之下）时记录到进度存档中
+	 */
+	virtual void OnWeaponRegistered(FGameplayTag InWeaponTag, AFightWeaponBase* InWeapon) override;
+
+	/**
+	 * @brief 开启武器碰撞时视为一次新的挥砍，挥砍ID递增
+	 */
+	virtual void ToggleCurrentEquippedWeaponCollision(bool bShouldEnable) override;
+
+private:
+	/**
+	 * @brief 确认命中后发送近战命中与顿帧事件 --> 伤害仍由监听Shared.Event.MeleeHit的能力施加
+	 */
+	void ApplyConfirmedMeleeHit(AActor* HitActor);
+
+	/**
+	 * @brief 请求顿帧 --> 优先交给拥有者的顿帧调度组件合并，未启用时回退到发送Player.Event.HitPause
+	 */
+	void RequestHitPause(AActor* InHitActor);
+
+	/**
+	 * @brief 客户端上报命中，服务器回溯校验后施加
+	 *
+	 * @param HitActor 客户端本地重叠到的目标
+	 * @param InSwingId 命中所属的挥砍ID
+	 * @param InClaimServerTime 命中发生时客户端估算的服务器时间
+	 */
+	UFUNCTION(Server, Reliable)
+	void Server_ConfirmMeleeHit(AActor* HitActor, int32 InSwingId, double InClaimServerTime);
+
+	// 本地挥砍计数，客户端与服务器各自在开启武器碰撞时递增，两端不做同步 --> 服务器只要求上报的ID单调递增
+	int32 CurrentSwingId = 0;
+
+	// 服务器：最近一次被确认命中的挥砍ID及该次挥砍已命中的目标，防止重复上报
+	int32 LastConfirmedSwingId = 0;
+	TArray<TWeakObjectPtr<AActor>> ConfirmedTargetsThisSwing;
 };
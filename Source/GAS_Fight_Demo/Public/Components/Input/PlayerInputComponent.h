@@ -6,8 +6,13 @@
 #include "EnhancedInputComponent.h"
 #include "GameplayTagContainer.h"
 #include "DataAsset/Input/DataAsset_InputConfig.h"
+#include "FightTypes/FightInputLog.h"
 #include "PlayerInputComponent.generated.h"
 
+
+DECLARE_DELEGATE_TwoParams(FOnFightReplayInputEventDelegate, const FFightInputLogEvent&, const FGameplayTag&);
+
+
 /**
  * 自定义的输入组件类，继承自UEnhancedInputComponent
  * 提供了绑定原生输入动作和能力输入动作的模板函数
@@ -47,6 +52,69 @@ public:
 	template<class UserObject, typename CallbackFunc>
 	void BindAbilityInputAction(const UDataAsset_InputConfig* InInputConfig, UserObject* ContextObject,
 		CallbackFunc InputPressedFunc, CallbackFunc InputReleasedFunc);
+
+	/**
+	 * @brief 开始录制输入，帧序号从当前帧开始计数
+	 */
+	void StartInputRecording(int32 InRandomSeed, float InFixedDeltaTime);
+
+	/**
+	 * @brief 停止录制并写入文件
+	 */
+	bool StopInputRecording(const FString& InFilePath);
+
+	/**
+	 * @brief 开始回放输入日志，回放期间忽略设备输入
+	 */
+	void StartInputReplay(const TSharedRef<const FFightInputLog>& InReplayLog);
+
+	/**
+	 * @brief 结束回放，恢复设备输入
+	 */
+	void StopInputReplay();
+
+	/**
+	 * @brief 每帧调用一次，派发到达当前帧的回放事件
+	 *
+	 * @return 回放仍未结束时返回true
+	 */
+	bool TickInputReplay();
+
+	/**
+	 * @brief 输入处理函数的入口过滤：录制时记录事件；回放时只放行回放派发的事件
+	 *
+	 * @return 该事件应该被处理时返回true
+	 */
+	bool PreprocessInputEvent(EFightInputLogEventType InType, const FVector2f& InValue = FVector2f::ZeroVector,
+		const FGameplayTag& InTag = FGameplayTag());
+
+	FORCEINLINE bool IsRecordingInput() const { return bIsRecordingInput; }
+	FORCEINLINE bool IsReplayingInput() const { return ReplayInputLog.IsValid(); }
+
+	/**
+	 * @brief 以外部计数代替全局帧号计算输入帧（仅用于自动化测试），传入nullptr恢复使用全局帧号
+	 */
+	FORCEINLINE void SetFrameCounterOverride(const uint64* InFrameCounter) { FrameCounterOverride = InFrameCounter; }
+
+	// 回放事件派发目标，由拥有者绑定到对应的输入处理函数
+	FOnFightReplayInputEventDelegate OnReplayInputEvent;
+
+private:
+	uint32 GetInputFrame() const;
+
+	FORCEINLINE uint64 GetFrameCounter() const { return FrameCounterOverride ? *FrameCounterOverride : GFrameCounter; }
+
+	FFightInputLog RecordingInputLog;
+	bool bIsRecordingInput = false;
+
+	TSharedPtr<const FFightInputLog> ReplayInputLog;
+	int32 NextReplayEventIndex = 0;
+	bool bIsDispatchingReplayEvent = false;
+
+	// 录制/回放开始时的全局帧号
+	uint64 InputStartFrameCounter = 0;
+
+	const uint64* FrameCounterOverride = nullptr;
 };
 
 template<class UserObject, typename CallbackFunc>
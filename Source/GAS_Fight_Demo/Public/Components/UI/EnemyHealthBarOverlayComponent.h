@@ -0,0 +1,86 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "EnemyHealthBarOverlayComponent.generated.h"
+
+
+class AEnemyCharacter;
+class UFightEnemyHealthBarWidget;
+
+
+/**
+ * @brief 敌人血条的屏幕空间覆盖层，挂在本地玩家控制器上
+ *
+ * 取代每个敌人各自的UWidgetComponent：
+ * 1. 敌人只在此处登记，不再创建自己的血条控件
+ * 2. 每帧对所有登记的敌人读取一次血量、投影一次屏幕位置
+ * 3. 只为可见且已受伤的敌人（按距离由近到远）分配池化控件，控件数量恒定为HealthBarPoolSize
+ */
+UCLASS(ClassGroup = (UI), meta = (BlueprintSpawnableComponent))
+class GAS_FIGHT_DEMO_API UEnemyHealthBarOverlayComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+	UEnemyHealthBarOverlayComponent();
+
+	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+
+	/**
+	 * @brief 获取本地玩家控制器上的覆盖层组件，不存在时返回nullptr
+	 */
+	static UEnemyHealthBarOverlayComponent* FindLocalOverlay(const UObject* WorldContextObject);
+
+	void RegisterEnemy(AEnemyCharacter* InEnemy);
+	void UnregisterEnemy(const AEnemyCharacter* InEnemy);
+
+	FORCEINLINE bool IsOverlayEnabled() const { return HealthBarWidgetClass != nullptr; }
+
+protected:
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	UPROPERTY(EditDefaultsOnly, Category = "UI")
+	TSubclassOf<UFightEnemyHealthBarWidget> HealthBarWidgetClass;
+
+	// 同屏最多显示的血条数量，也是控件池的大小
+	UPROPERTY(EditDefaultsOnly, Category = "UI", meta = (ClampMin = "1"))
+	int32 HealthBarPoolSize = 16;
+
+	// 超过该距离的敌人不显示血条
+	UPROPERTY(EditDefaultsOnly, Category = "UI")
+	float MaxDrawDistance = 3000.f;
+
+	// 血条锚点相对敌人位置的偏移
+	UPROPERTY(EditDefaultsOnly, Category = "UI")
+	FVector HealthBarWorldOffset = FVector(0.f, 0.f, 120.f);
+
+	// 为true时只为受过伤的敌人显示血条
+	UPROPERTY(EditDefaultsOnly, Category = "UI")
+	bool bOnlyShowDamagedEnemies = true;
+
+private:
+	/**
+	 * @brief 本帧需要显示血条的候选敌人
+	 */
+	struct FHealthBarCandidate
+	{
+		float DistSquared;
+		float HealthPercent;
+		FVector2D ScreenPosition;
+	};
+
+	UPROPERTY()
+	TArray<UFightEnemyHealthBarWidget*> HealthBarWidgetPool;
+
+	TArray<TWeakObjectPtr<AEnemyCharacter>> TrackedEnemies;
+
+	// 每帧复用的候选数组
+	TArray<FHealthBarCandidate> FrameCandidates;
+
+	// 上一帧显示中的控件数量，用于只隐藏多出来的控件
+	int32 NumVisibleWidgets = 0;
+};
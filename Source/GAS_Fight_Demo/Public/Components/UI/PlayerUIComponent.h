@@ -12,6 +12,8 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnEquippedweaponChangedDelegate, TS
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnAbilityIconSlotUpdatedDelegate, FGameplayTag, AbilityInputTag, TSoftObjectPtr<UMaterialInterface>, SoftAbilityIconMaterial);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FOnAbilityCooldownBeginDelegate, FGameplayTag, AbilityInputTag, float, TotalCooldownTime, float, RemainingCooldownTime);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnStoneInteractionDelegate, bool, bShouldDisplayIconInputKey);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnEquippedWeaponIconResolvedDelegate, UTexture2D*, WeaponIcon);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnAbilityIconSlotResolvedDelegate, FGameplayTag, AbilityInputTag, UMaterialInterface*, AbilityIconMaterial);
 
 
 UCLASS()
@@ -32,6 +34,39 @@ public:
 	UPROPERTY(BlueprintCallable, BlueprintAssignable)
 	FOnAbilityCooldownBeginDelegate OnAbilityCooldownBegin;
 
+	/**
+	 * @brief 是否由能力系统组件在冷却效果添加时自动广播OnAbilityCooldownBegin
+	 *
+	 * 现有蓝图能力在提交后自己广播该事件，默认关闭以免UI收到两次；移除蓝图中的广播后再开启
+	 */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Cooldown")
+	bool bBroadcastCooldownBeginNatively = false;
+
 	UPROPERTY(BlueprintCallable, BlueprintAssignable)
 	FOnStoneInteractionDelegate OnStoneInteraction;
+
+	// OnEquippedWeaponChanged的已解析版本 --> 图标经UI资源缓存异步加载完成后才广播，控件无需再自行加载
+	UPROPERTY(BlueprintAssignable)
+	FOnEquippedWeaponIconResolvedDelegate OnEquippedWeaponIconResolved;
+
+	// OnAbilityIconSlotUpdated的已解析版本
+	UPROPERTY(BlueprintAssignable)
+	FOnAbilityIconSlotResolvedDelegate OnAbilityIconSlotResolved;
+
+protected:
+	// ~Begin UActorComponent Interface
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+	// ~End UActorComponent Interface
+
+private:
+	UFUNCTION()
+	void HandleEquippedWeaponChanged(TSoftObjectPtr<UTexture2D> InSoftWeaponIcon);
+
+	UFUNCTION()
+	void HandleAbilityIconSlotUpdated(FGameplayTag InAbilityInputTag, TSoftObjectPtr<UMaterialInterface> InSoftAbilityIconMaterial);
+
+	// 当前显示中的图标，UI持有其引用直到被替换
+	FSoftObjectPath DisplayedWeaponIconPath;
+	TMap<FGameplayTag, FSoftObjectPath> DisplayedAbilityIconPaths;
 };
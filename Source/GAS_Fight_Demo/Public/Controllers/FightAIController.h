@@ -18,6 +18,9 @@ class GAS_FIGHT_DEMO_API AFightAIController : public AAIController
 public:
 	AFightAIController(const FObjectInitializer& ObjectInitializer);
 
+	// 存放攻击目标的黑板键名，应与行为树黑板中的键名一致 --> 读写该键的代码都使用这个常量
+	static const FName TargetActorKeyName;
+
 	//~ Begin IGenericTeamAgentInterface Interface.
 	/**
 	 * @brief 获取本AI控制器对另一个Actor的团队态度（敌对、友好、中立）
@@ -9,6 +9,7 @@
 
 
 class UInputMappingContext;
+class UEnemyHealthBarOverlayComponent;
 
 
 UCLASS()
@@ -25,4 +26,8 @@ public:
 
 private:
 	FGenericTeamId PlayerTeamId;
+
+	// 所有敌人共享的屏幕空间血条覆盖层
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "UI", meta = (AllowPrivateAccess = "true"))
+	UEnemyHealthBarOverlayComponent* EnemyHealthBarOverlayComponent;
 };
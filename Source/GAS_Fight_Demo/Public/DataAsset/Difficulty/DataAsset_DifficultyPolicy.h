@@ -0,0 +1,68 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "FightTypes/FightEnumTypes.h"
+#include "DataAsset_DifficultyPolicy.generated.h"
+
+
+/**
+ * @brief 单个难度下的数值配置
+ *
+ * 等级用于授予启动数据时的能力/效果等级（曲线表取值），
+ * 伤害倍率在伤害计算中按攻击方阵营生效，生成倍率作用于生存模式每波敌人数量
+ */
+USTRUCT(BlueprintType)
+struct FFightDifficultyPolicyEntry
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, meta = (ClampMin = "1"))
+	int32 PlayerAbilityApplyLevel = 1;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, meta = (ClampMin = "1"))
+	int32 EnemyAbilityApplyLevel = 1;
+
+	// 玩家造成伤害的倍率
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, meta = (ClampMin = "0.0"))
+	float PlayerDamageMultiplier = 1.f;
+
+	// 敌人造成伤害的倍率
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, meta = (ClampMin = "0.0"))
+	float EnemyDamageMultiplier = 1.f;
+
+	// 每波敌人数量的倍率 --> 作用于波次总数与单次生成数量
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, meta = (ClampMin = "0.0"))
+	float EnemySpawnCountMultiplier = 1.f;
+};
+
+
+/**
+ * @brief 难度策略数据资产
+ *
+ * 取代角色类中按难度硬编码的等级表，游戏模式在初始化时解析一次并缓存当前难度的配置
+ */
+UCLASS()
+class GAS_FIGHT_DEMO_API UDataAsset_DifficultyPolicy : public UDataAsset
+{
+	GENERATED_BODY()
+
+public:
+	/**
+	 * @brief 查找指定难度的配置
+	 *
+	 * @return 资产中配置了该难度时返回true
+	 */
+	bool FindDifficultyPolicyEntry(EFightGameDifficulty InDifficulty, FFightDifficultyPolicyEntry& OutEntry) const;
+
+	/**
+	 * @brief 未配置难度策略资产（或资产缺少该难度）时使用的默认配置，与原先硬编码的等级表一致
+	 */
+	static FFightDifficultyPolicyEntry MakeDefaultDifficultyPolicyEntry(EFightGameDifficulty InDifficulty);
+
+private:
+	UPROPERTY(EditDefaultsOnly, Category = "Difficulty")
+	TMap<EFightGameDifficulty, FFightDifficultyPolicyEntry> DifficultyPolicies;
+};
@@ -16,8 +16,8 @@ class GAS_FIGHT_DEMO_API UDataAsset_EnemyStartUpData : public UDataAsset_StartUp
 {
 	GENERATED_BODY()
 	
-public:
-	virtual void GiveToAbilitySystemComponent(UFightAbilitySystemComponent* InASCToGive, int32 ApplyLevel = 1) override;
+protected:
+	virtual void BuildGrantBundle(FFightStartUpGrantBundle& OutBundle, int32 ApplyLevel) const override;
 
 private:
 	/**
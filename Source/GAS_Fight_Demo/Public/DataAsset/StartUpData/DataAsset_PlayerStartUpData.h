@@ -13,8 +13,8 @@ class GAS_FIGHT_DEMO_API UDataAsset_PlayerStartUpData : public UDataAsset_StartU
 {
 	GENERATED_BODY()
 	
-public:
-	virtual void GiveToAbilitySystemComponent(UFightAbilitySystemComponent* InASCToGive, int32 ApplyLevel = 1) override;
+protected:
+	virtual void BuildGrantBundle(FFightStartUpGrantBundle& OutBundle, int32 ApplyLevel) const override;
 
 private:
 	UPROPERTY(EditDefaultsOnly, Category = "StartUpData", meta = (TitleProperty = "InputTag"))
@@ -4,12 +4,40 @@
 
 #include "CoreMinimal.h"
 #include "Engine/DataAsset.h"
+#include "GameplayAbilitySpec.h"
+#include "GameplayEffect.h"
 #include "DataAsset_StartUpDataBase.generated.h"
 
 
 class UFightGameplayAbility;
 class UFightAbilitySystemComponent;
 class UGameplayEffect;
+class UBasicAttributeSet;
+
+
+/**
+ * @brief 某个启动数据资产在某个等级下预先构建好的授予内容
+ *
+ * 同一类敌人共享同一份数据资产，每个实例的授予只需复制模板并替换源对象/上下文
+ */
+struct FFightStartUpGrantBundle
+{
+	/**
+	 * @brief 可直接写入属性基础值的修改（来自快速路径的瞬时效果），按配置顺序保存
+	 */
+	struct FAttributeBaseValueWrite
+	{
+		FGameplayAttribute Attribute;
+		bool bOverride = true;
+		float Magnitude = 0.f;
+		// 配置顺序中排在这次写入之前的常规路径效果数量 --> 授予时在应用该序号的效果规格之前写入
+		int32 NumEffectSpecsBefore = 0;
+	};
+
+	TArray<FGameplayAbilitySpec> AbilitySpecTemplates;
+	TArray<FGameplayEffectSpec> EffectSpecTemplates;
+	TArray<FAttributeBaseValueWrite> AttributeBaseValueWrites;
+};
 
 
 /**
@@ -43,10 +71,26 @@ public:
 	 *
 	 * @details
 	 * 1. 验证能力系统组件指针的有效性
-	 * 2. 授予激活类能力和反应类能力
-	 * 3. 应用启动时的游戏效果
+	 * 2. 取出（首次时构建）该等级的授予包
+	 * 3. 复制能力规格模板并重新生成句柄后授予
+	 * 4. 在屏蔽UI通知的情况下，按配置顺序写入快速路径的属性基础值（并补上属性集的钳制），
+	 *    其余效果复制规格模板，设置新的效果上下文并重新捕获源数据后应用
+	 * 5. 解除屏蔽，统一向UI广播一次初始属性
+	 */
+	void GiveToAbilitySystemComponent(UFightAbilitySystemComponent* InASCToGive, int32 ApplyLevel = 1);
+
+	/**
+	 * @brief 切换快速初始化路径，切换后丢弃已构建的授予包
+	 *
+	 * 供自动化测试对比两条路径的结果与耗时
 	 */
-	virtual void GiveToAbilitySystemComponent(UFightAbilitySystemComponent* InASCToGive, int32 ApplyLevel = 1);
+	void SetUseFastAttributeInit(bool bInUseFastAttributeInit);
+
+	FORCEINLINE bool IsUsingFastAttributeInit() const { return bUseFastAttributeInit; }
+
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
 
 protected:
 	/**
@@ -77,20 +121,47 @@ protected:
 	TArray<TSubclassOf<UGameplayEffect>> StartUpGameplayEffects;
 
 	/**
-	 * @brief 授予能力的辅助函数
+	 * @brief 是否对简单的启动效果使用快速初始化路径
 	 *
-	 * 将指定数组中的能力授予给指定的能力系统组件
+	 * 只由ScalableFloat（含曲线表）驱动的Override/AddBase修改器组成的瞬时效果，在构建授予包时按等级求值一次，
+	 * 授予时直接写入属性基础值，不再经过效果应用与属性聚合；其余效果仍按原方式应用，两者保持配置中的先后顺序
+	 *
+	 * @note 带有提示或白名单（资产标签）之外组件的效果一律走常规路径
+	 */
+	UPROPERTY(EditDefaultsOnly, Category = "StartUpData")
+	bool bUseFastAttributeInit = true;
+
+	/**
+	 * @brief 构建指定等级的授予包，子类在调用父类后追加自己的能力
+	 *
+	 * 每个(数据资产, 等级)只会调用一次
+	 */
+	virtual void BuildGrantBundle(FFightStartUpGrantBundle& OutBundle, int32 ApplyLevel) const;
+
+	/**
+	 * @brief 把能力类数组追加为能力规格模板
 	 *
 	 * @param InAbilitiesToGive 要授予的能力类数组
-	 * @param InASCToGive 目标能力系统组件指针
-	 * @param ApplyLevel 能力应用等级，默认为1级
+	 * @param OutBundle 追加到的授予包
+	 * @param ApplyLevel 能力应用等级
+	 */
+	static void AddAbilitySpecTemplates(const TArray<TSubclassOf<UFightGameplayAbility>>& InAbilitiesToGive,
+		FFightStartUpGrantBundle& OutBundle, int32 ApplyLevel);
+
+	/**
+	 * @brief 尝试把瞬时效果在指定等级下求值为属性基础值写入
 	 *
-	 * @details
-	 * 1. 检查能力数组是否为空
-	 * 2. 遍历能力数组，为每个有效能力创建能力规范
-	 * 3. 设置能力规范的源对象和等级
-	 * 4. 将能力规范授予给能力系统组件
+	 * @return 效果满足快速路径条件并已追加时返回true
 	 */
-	void GrantAbilities(const TArray<TSubclassOf<UFightGameplayAbility>>& InAbilitiesToGive,
-		UFightAbilitySystemComponent* InASCToGive, int32 ApplyLevel = 1);
+	static bool TryAddAttributeBaseValueWrites(const UGameplayEffect* InEffect, FFightStartUpGrantBundle& OutBundle, int32 ApplyLevel);
+
+	/**
+	 * @brief 把一次快速路径的写入应用到属性基础值，并补上属性集在PostGameplayEffectExecute中做的钳制
+	 */
+	static void ApplyAttributeBaseValueWrite(UFightAbilitySystemComponent* InASC, UBasicAttributeSet* InBasicAttributeSet,
+		const FFightStartUpGrantBundle::FAttributeBaseValueWrite& InBaseValueWrite);
+
+private:
+	// 等级 --> 授予包，在首次授予时构建
+	TMap<int32, FFightStartUpGrantBundle> GrantBundleCache;
 };
@@ -140,9 +140,26 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Fight|FunctionLibrary", meta = (WorldContext = "WorldContextObject"))
 	static void ToggleInputMode(const UObject* WorldContextObject, EFightInputMode InInputMode);
 
-	UFUNCTION(BlueprintCallable, Category = "Fight|FunctionLibrary")
+	/**
+	 * @brief 保存游戏难度 --> 只修改UFightSaveGameSubsystem中缓存的存档，写盘被异步合并
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Fight|FunctionLibrary", meta = (WorldContext = "WorldContextObject"))
+	static void SaveGameDifficulty(const UObject* WorldContextObject, EFightGameDifficulty InDifficultyToSave);
+
+	/**
+	 * @brief 读取存档中的游戏难度 --> 直接读取UFightSaveGameSubsystem中缓存的存档，不触碰磁盘
+	 *
+	 * @return 存在存档且初始异步读取已完成时返回true
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Fight|FunctionLibrary", meta = (WorldContext = "WorldContextObject"))
+	static bool TryGetSavedGameDifficulty(const UObject* WorldContextObject, EFightGameDifficulty& OutSavedDifficulty);
+
+	/**
+	 * @brief 旧版接口，保留原签名以兼容已有的蓝图调用 --> 没有世界上下文，使用当前的游戏世界
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Fight|FunctionLibrary", meta = (DeprecatedFunction, DeprecationMessage = "Use SaveGameDifficulty instead."))
 	static void SaveCurrentGameDifficulty(EFightGameDifficulty InDifficultyToSave);
 
-	UFUNCTION(BlueprintCallable, Category = "Fight|FunctionLibrary")
+	UFUNCTION(BlueprintCallable, Category = "Fight|FunctionLibrary", meta = (DeprecatedFunction, DeprecationMessage = "Use TryGetSavedGameDifficulty instead."))
 	static bool TryLoadSavedGameDifficulty(EFightGameDifficulty& OutSavedDifficulty);
 };
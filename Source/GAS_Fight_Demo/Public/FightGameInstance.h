@@ -8,6 +8,9 @@
 #include "FightGameInstance.generated.h"
 
 
+struct FStreamableHandle;
+
+
 USTRUCT(BlueprintType)
 struct FFightGameLevelSet
 {
@@ -19,6 +22,10 @@ struct FFightGameLevelSet
 	UPROPERTY(EditDefaultsOnly)
 	TSoftObjectPtr<UWorld> Level;
 
+	// 预加载关卡时一并异步加载的类（如该关卡各波次的敌人类）
+	UPROPERTY(EditDefaultsOnly)
+	TArray<TSoftClassPtr<AActor>> ClassesToPreload;
+
 	bool IsValid() const;
 };
 
@@ -35,10 +42,64 @@ protected:
 	virtual void OnPreLoadMap(const FString& MapName);
 	virtual void OnDestinationWorldLoaded(UWorld* LoadedWorld);
 
+	/**
+	 * @brief 新关卡BeginPlay时调用，记录本次切换的可交互耗时
+	 */
+	void OnDestinationWorldBeginPlay();
+
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, meta = (TitleProperty = "LevelTag"))
 	TArray<FFightGameLevelSet> GameLevelSets;
 
+	// 目标关卡未预加载时加载界面的最短显示时间，已预加载完成的切换不再强制等待
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Loading")
+	float MinimumLoadingScreenDisplayTime = 0.5f;
+
+	// 最近一次关卡切换从发起到新关卡BeginPlay的耗时（秒）
+	UPROPERTY(BlueprintReadOnly, Category = "Loading")
+	float LastTransitionTimeToInteractive = 0.f;
+
 public:
 	UFUNCTION(BlueprintPure, meta = (GameplayTagFilter = "GameData.Level"))
 	TSoftObjectPtr<UWorld> GetGameLevelByTag(FGameplayTag InTag) const;
+
+	/**
+	 * @brief 在当前关卡仍可交互时（如主菜单）开始异步加载目标关卡及其需要的类
+	 *
+	 * 同一时间只保留一个预加载目标，预加载另一个关卡会释放之前的预加载
+	 */
+	UFUNCTION(BlueprintCallable, meta = (GameplayTagFilter = "GameData.Level"))
+	void PreloadGameLevelByTag(FGameplayTag InTag);
+
+	/**
+	 * @brief 切换到指定标签的关卡，已预加载的关卡会被直接复用
+	 */
+	UFUNCTION(BlueprintCallable, meta = (GameplayTagFilter = "GameData.Level"))
+	void TravelToGameLevelByTag(FGameplayTag InTag);
+
+	UFUNCTION(BlueprintPure)
+	bool IsGameLevelPreloaded(FGameplayTag InTag) const;
+
+private:
+	/**
+	 * @brief 释放预加载的关卡与类
+	 */
+	void ReleasePreloadHandles();
+
+	/**
+	 * @brief 按标签查找关卡配置，未配置时返回nullptr
+	 */
+	const FFightGameLevelSet* FindGameLevelSet(const FGameplayTag& InTag) const;
+
+	// 关卡标签 --> GameLevelSets中的下标，Init时构建一次 --> 不保存元素指针，数组被重新分配（如编辑器中修改）后仍然有效
+	TMap<FGameplayTag, int32> GameLevelMap;
+
+	FGameplayTag PreloadingLevelTag;
+
+	// 持有预加载的UWorld本身，直到切换完成 --> 只持有包无法让关卡中的对象熬过LoadMap中的GC
+	TSharedPtr<FStreamableHandle> PreloadedLevelHandle;
+
+	TSharedPtr<FStreamableHandle> PreloadedClassesHandle;
+
+	// 切换开始时间，小于0表示没有进行中的切换
+	double TransitionStartTime = -1.0;
 };
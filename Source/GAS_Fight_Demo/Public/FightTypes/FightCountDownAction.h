@@ -5,21 +5,28 @@
 #include "CoreMinimal.h"
 #include "LatentActions.h"
 #include "FightEnumTypes.h"
+#include "FightTimerWheel.h"
+
+
+class UFightTimerSubsystem;
 
 
 /**
  * @brief 倒计时延迟动作类，用于在蓝图中实现倒计时功能
+ *
+ * 计时由UFightTimerSubsystem的时间轮完成，本动作只在时间轮回调设置的标记上触发蓝图输出
+ * --> 不再逐帧累加时间，更新间隔与总时长都不会因帧时间产生漂移
  */
 class FFightCountDownAction : public FPendingLatentAction
 {
 public:
-	FFightCountDownAction(float InTotalCountDownTime, float InUpdateInterval, float& InOutRemainingTime,
-		EFightCountDownActionOutput& CountDownOutput, const FLatentActionInfo& LatentInfo);
+	FFightCountDownAction(UFightTimerSubsystem* InTimerSubsystem, float InTotalCountDownTime, float InUpdateInterval,
+		float& InOutRemainingTime, EFightCountDownActionOutput& CountDownOutput, const FLatentActionInfo& LatentInfo);
+
+	virtual ~FFightCountDownAction() override;
 
 	/**
-	 * @brief: 每帧更新倒计时状态，类似Tick()
-	 * 
-	 * 这是Latent Action系统的核心，每帧都会被LatentActionManager调用
+	 * @brief: 每帧由LatentActionManager调用，只检查时间轮回调设置的标记
 	 * 
 	 * @param: Response 用于控制Action状态和触发蓝图回调的响应对象
 	 */
@@ -28,14 +35,22 @@ public:
 	void CancelAction();
 
 private:
+	void OnUpdateTimerFired();
+	void OnCompleteTimerFired();
+
+	TWeakObjectPtr<UFightTimerSubsystem> TimerSubsystem;
+	FFightTimerHandle UpdateTimerHandle;
+	FFightTimerHandle CompleteTimerHandle;
+
 	bool bNeedToCancel;
+	bool bCompleted;
+	bool bHasPendingUpdate;
 	float TotalCountDownTime;
 	float UpdateInterval;
+	int32 NumUpdatesFired;
 	float& OutRemainingTime;
 	EFightCountDownActionOutput& CountDownOutput;
 	FName ExecutionFunction;
 	int32 OutputLink;
 	FWeakObjectPtr CallbackTarget;
-	float ElapsedInterval;
-	float ElapsedTimeSinceStart;
 };
\ No newline at end of file
@@ -0,0 +1,77 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameplayTagContainer.h"
+
+
+/**
+ * @brief 输入日志中的事件类型，与AMainCharacter的输入处理函数一一对应
+ */
+enum class EFightInputLogEventType : uint8
+{
+	Move,
+	Look,
+	SwitchTargetTriggered,
+	SwitchTargetCompleted,
+	PickUpStones,
+	AbilityPressed,
+	AbilityReleased
+};
+
+
+/**
+ * @brief 单条输入事件
+ *
+ * Frame为相对录制开始的帧序号，固定步长下帧序号即可完全确定事件发生的模拟时刻
+ */
+struct FFightInputLogEvent
+{
+	uint32 Frame = 0;
+	EFightInputLogEventType Type = EFightInputLogEventType::Move;
+
+	// 能力输入标签在标签表中的下标，仅能力事件使用
+	uint16 TagIndex = 0;
+
+	// 二维输入值，仅移动/视角/切换目标事件使用
+	FVector2f Value = FVector2f::ZeroVector;
+
+	FORCEINLINE bool HasValue() const
+	{
+		return Type == EFightInputLogEventType::Move || Type == EFightInputLogEventType::Look ||
+			Type == EFightInputLogEventType::SwitchTargetTriggered;
+	}
+
+	FORCEINLINE bool HasTag() const
+	{
+		return Type == EFightInputLogEventType::AbilityPressed || Type == EFightInputLogEventType::AbilityReleased;
+	}
+};
+
+
+/**
+ * @brief 紧凑的输入日志：确定性模式下录制玩家输入，回放时按帧重新派发
+ *
+ * @details
+ * 1. 头部记录随机种子与固定步长，回放时据此还原模拟条件
+ * 2. 输入标签只在标签表中保存一次，事件中只存下标
+ * 3. 事件按类型只序列化需要的字段
+ */
+struct GAS_FIGHT_DEMO_API FFightInputLog
+{
+	int32 RandomSeed = 0;
+	float FixedDeltaTime = 0.f;
+
+	TArray<FName> TagTable;
+	TArray<FFightInputLogEvent> Events;
+
+	void AddEvent(uint32 InFrame, EFightInputLogEventType InType, const FVector2f& InValue, const FGameplayTag& InTag);
+
+	FGameplayTag GetEventTag(const FFightInputLogEvent& InEvent) const;
+
+	bool SaveToFile(const FString& InFilePath) const;
+	bool LoadFromFile(const FString& InFilePath);
+
+	friend FArchive& operator<<(FArchive& Ar, FFightInputLog& InOutLog);
+};
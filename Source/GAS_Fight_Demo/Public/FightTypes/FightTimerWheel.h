@@ -0,0 +1,120 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+
+DECLARE_DELEGATE(FFightTimerDelegate);
+
+
+/**
+ * @brief 时间轮定时器句柄，Serial用于识别已被复用的槽位
+ */
+struct FFightTimerHandle
+{
+	int32 Index = INDEX_NONE;
+	uint32 Serial = 0;
+
+	FORCEINLINE bool IsValid() const { return Index != INDEX_NONE; }
+	FORCEINLINE void Invalidate() { Index = INDEX_NONE; Serial = 0; }
+};
+
+
+/**
+ * @brief 分层时间轮：所有定时器共享一次推进，单次推进的开销只与经过的刻度数有关，与定时器数量无关
+ *
+ * @details
+ * 1. 共4层，每层64个槽位，第0层每个槽位对应一个刻度 --> 默认刻度为1/120秒，可覆盖约38小时
+ * 2. 定时器以侵入式双向链表挂在槽位上，添加/删除均为O(1)
+ * 3. 高层槽位在低层转满一圈时下沉到低层，到期刻度才会精确落到第0层
+ * 4. 循环定时器按"上次到期时间 + 间隔"重新排期，而不是按触发时刻，因此不会累积漂移
+ */
+class GAS_FIGHT_DEMO_API FFightTimerWheel
+{
+public:
+	explicit FFightTimerWheel(double InTickSeconds = 1.0 / 120.0);
+
+	/**
+	 * @brief 添加定时器
+	 *
+	 * @param InDelay 首次触发的延迟
+	 * @param InInterval 循环间隔，小于等于0时只触发一次
+	 */
+	FFightTimerHandle AddTimer(FFightTimerDelegate&& InDelegate, double InDelay, double InInterval = 0.0);
+
+	void RemoveTimer(const FFightTimerHandle& InHandle);
+
+	bool IsTimerActive(const FFightTimerHandle& InHandle) const;
+
+	/**
+	 * @brief 距离下次触发的时间，定时器无效时返回-1
+	 */
+	double GetTimeRemaining(const FFightTimerHandle& InHandle) const;
+
+	/**
+	 * @brief 推进时间轮并触发所有到期的定时器，不允许在定时器回调中嵌套调用
+	 */
+	void Advance(double InDeltaSeconds);
+
+	void Reset();
+
+	FORCEINLINE double GetCurrentTime() const { return CurrentTime; }
+	FORCEINLINE int32 GetNumActiveTimers() const { return NumActiveTimers; }
+
+private:
+	static constexpr int32 NumLevels = 4;
+	static constexpr int32 SlotBits = 6;
+	static constexpr int32 NumSlots = 1 << SlotBits;
+	static constexpr uint64 SlotMask = NumSlots - 1;
+
+	struct FTimerEntry
+	{
+		FFightTimerDelegate Delegate;
+		double ExpireTime = 0.0;
+		double Interval = 0.0;
+		uint64 ExpireTick = 0;
+
+		// 所在槽位的链表，SlotIndex为INDEX_NONE表示不在任何槽位上（空闲或正在触发）
+		int32 Prev = INDEX_NONE;
+		int32 Next = INDEX_NONE;
+		int32 SlotIndex = INDEX_NONE;
+
+		uint32 Serial = 0;
+		bool bActive = false;
+	};
+
+	const FTimerEntry* FindEntry(const FFightTimerHandle& InHandle) const;
+
+	/**
+	 * @brief 按到期刻度把定时器挂到对应层级的槽位上
+	 */
+	void LinkEntry(int32 InEntryIndex);
+	void UnlinkEntry(int32 InEntryIndex);
+	void FreeEntry(int32 InEntryIndex);
+
+	/**
+	 * @brief 把某个槽位上的定时器重新分配到更低的层级
+	 */
+	void CascadeSlot(int32 InLevel, int32 InSlot);
+
+	/**
+	 * @brief 前进一个刻度：先下沉高层槽位，再触发第0层当前槽位上的全部定时器
+	 */
+	void ProcessNextTick();
+
+	double TickSeconds;
+	double CurrentTime = 0.0;
+	uint64 CurrentTick = 0;
+
+	TArray<FTimerEntry> Entries;
+	TArray<int32> FreeEntryIndices;
+	int32 SlotHeads[NumLevels * NumSlots];
+
+	// 触发时复用的临时数组，保存(下标, Serial) --> 回调中删除或复用其他定时器时据此跳过
+	TArray<TPair<int32, uint32>> FiringEntries;
+
+	uint32 NextSerial = 1;
+	int32 NumActiveTimers = 0;
+	bool bIsAdvancing = false;
+};
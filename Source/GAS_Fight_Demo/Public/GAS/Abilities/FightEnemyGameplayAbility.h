@@ -55,7 +55,37 @@ public:
 	FGameplayEffectSpecHandle MakeEnemyDamageEffectSpecHandle(TSubclassOf<UGameplayEffect> EffectClass,
 		const FScalableFloat& InDamageScalableFloat);
 
+protected:
+	// ~Begin UGameplayAbility Interface
+	/**
+	 * @brief 需要攻击令牌的能力，在目标的令牌已满时直接拒绝激活
+	 */
+	virtual bool CanActivateAbility(const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo,
+		const FGameplayTagContainer* SourceTags = nullptr, const FGameplayTagContainer* TargetTags = nullptr,
+		FGameplayTagContainer* OptionalRelevantTags = nullptr) const override;
+
+	virtual void ActivateAbility(const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo,
+		const FGameplayAbilityActivationInfo ActivationInfo, const FGameplayEventData* TriggerEventData) override;
+
+	virtual void EndAbility(const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo,
+		const FGameplayAbilityActivationInfo ActivationInfo, bool bReplicateEndAbility, bool bWasCancelled) override;
+	// ~End UGameplayAbility Interface
+
+	/**
+	 * @brief 是否需要向游戏模式申请攻击令牌才能激活 --> 用于近战攻击，限制同时围攻玩家的敌人数量
+	 */
+	UPROPERTY(EditDefaultsOnly, Category = "Fight|Ability")
+	bool bRequiresAttackToken = false;
+
 private:
+	/**
+	 * @brief 从AI控制器的黑板中获取当前攻击目标
+	 */
+	static AActor* GetAttackTargetFromActorInfo(const FGameplayAbilityActorInfo* ActorInfo);
+
+	// 本次激活是否持有攻击令牌
+	bool bHoldsAttackToken = false;
+
 	/**
 	 * @brief 缓存的敌人角色引用
 	 *
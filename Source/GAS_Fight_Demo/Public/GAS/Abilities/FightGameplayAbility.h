@@ -79,6 +79,15 @@ protected:
 	 */
 	virtual void OnGiveAbility(const FGameplayAbilityActorInfo* ActorInfo, const FGameplayAbilitySpec& Spec) override;
 
+	/**
+	 * @brief 在父类检查之前，拒绝激活已随武器卸下而被禁用的能力规格
+	 *
+	 * @see UFightAbilitySystemComponent::IsAbilitySpecDisabled
+	 */
+	virtual bool CanActivateAbility(const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo,
+		const FGameplayTagContainer* SourceTags = nullptr, const FGameplayTagContainer* TargetTags = nullptr,
+		FGameplayTagContainer* OptionalRelevantTags = nullptr) const override;
+
 	/**
 	 * @brief 在能力结束时调用
 	 * @param Handle 能力句柄，用于标识特定的能力实例
@@ -110,6 +119,16 @@ protected:
 	UPROPERTY(EditDefaultsOnly, Category = "Fight|Ability")
 	EFightAbilityActivationPolicy AbilityActivationPolicy = EFightAbilityActivationPolicy::OnTriggered;
 
+	/**
+	 * @brief 按标签激活时的选择权重
+	 *
+	 * 多个能力匹配同一标签时（如敌人的多个近战攻击），按权重比例选择其中一个，为0时永远不会被按标签选中
+	 *
+	 * @see UFightAbilitySystemComponent::TryActivateAbilityByTag
+	 */
+	UPROPERTY(EditDefaultsOnly, Category = "Fight|Ability", meta = (ClampMin = "0.0"))
+	float ActivationSelectionWeight = 1.f;
+
 	/**
 	 * @brief 获取Pawn战斗组件的便捷方法
 	 * @return UPawnCombatComponent指针，如果不存在则返回nullptr
@@ -181,4 +200,7 @@ protected:
 	UFUNCTION(BlueprintCallable, Category = "Fight|Ability")
 	void ApplyGameplayEffectSpecHandleToHitResults(
 		const FGameplayEffectSpecHandle& InSpecHandle, const TArray<FHitResult>& InHitResults);
+
+public:
+	FORCEINLINE float GetActivationSelectionWeight() const { return ActivationSelectionWeight; }
 };
@@ -18,6 +18,9 @@ class GAS_FIGHT_DEMO_API UPlayerGA_PickUpStones : public UFightPlayerGameplayAbi
 {
 	GENERATED_BODY()
 
+public:
+	UPlayerGA_PickUpStones();
+
 protected:
 	// ~Begin UGameplayAbility Interface
 	virtual void ActivateAbility(const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo, 
@@ -26,29 +29,19 @@ protected:
 		const FGameplayAbilityActivationInfo ActivationInfo, bool bReplicateEndAbility, bool bWasCancelled) override;
 	// ~End UGameplayAbility Interface
 
+	/**
+	 * @brief 从玩家的重叠石头集合中收集石头，集合为空时取消能力
+	 */
 	UFUNCTION(BlueprintCallable)
 	void CollectStones();
 
+	/**
+	 * @brief 重新读取重叠集合并批量消耗其中的石头
+	 */
 	UFUNCTION(BlueprintCallable)
 	void ConsumeStones();
 
 private:
-	// 盒体追踪距离
-	UPROPERTY(EditDefaultsOnly)
-	float BoxTraceDistance = 50.f;
-
-	// 盒体追踪大小
-	UPROPERTY(EditDefaultsOnly)
-	FVector TraceBoxSize = FVector(100.f);
-
-	// 石头追踪通道：指定要检测哪些类型的对象
-	UPROPERTY(EditDefaultsOnly)
-	TArray<TEnumAsByte<EObjectTypeQuery>> StoneTraceChannel;
-
-	// 是否绘制调试形状（开发时可视化追踪范围）
-	UPROPERTY(EditDefaultsOnly)
-	bool bDrawDebugShape = false;
-
 	// 已收集的石头数组
 	UPROPERTY()
 	TArray<AFightStoneBase*> CollectedStones;
@@ -52,27 +52,48 @@ public:
 	 */
 	virtual void PostGameplayEffectExecute(const struct FGameplayEffectModCallbackData& Data) override;
 
-	UPROPERTY(BlueprintReadOnly, Category = "Health")
+	/**
+	 * @brief 屏蔽/恢复属性变化的UI通知，用于启动时批量初始化属性
+	 */
+	FORCEINLINE void SetSuppressUINotifications(bool bInSuppress) { bSuppressUINotifications = bInSuppress; }
+
+	/**
+	 * @brief 把当前生命值/怒气值一次性推送给UI，并刷新怒气状态标签
+	 */
+	void BroadcastAttributesToUI(AActor* InAvatarActor);
+
+	/**
+	 * @brief 把被修改的当前生命值/怒气值钳制到0与对应最大值之间
+	 *
+	 * PostGameplayEffectExecute与启动数据的快速初始化（直接写入基础值）共用
+	 */
+	void ClampAttributeAfterBaseValueWrite(const FGameplayAttribute& InAttribute);
+
+	// ~Begin UObject Interface
+	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+	// ~End UObject Interface
+
+	UPROPERTY(BlueprintReadOnly, Category = "Health", ReplicatedUsing = OnRep_CurrentHealth)
 	FGameplayAttributeData CurrentHealth;
 	ATTRIBUTE_ACCESSORS(UBasicAttributeSet, CurrentHealth);
 
-	UPROPERTY(BlueprintReadOnly, Category = "Health")
+	UPROPERTY(BlueprintReadOnly, Category = "Health", ReplicatedUsing = OnRep_MaxHealth)
 	FGameplayAttributeData MaxHealth;
 	ATTRIBUTE_ACCESSORS(UBasicAttributeSet, MaxHealth)
 
-	UPROPERTY(BlueprintReadOnly, Category = "Rage")
+	UPROPERTY(BlueprintReadOnly, Category = "Rage", ReplicatedUsing = OnRep_CurrentRage)
 	FGameplayAttributeData CurrentRage;
 	ATTRIBUTE_ACCESSORS(UBasicAttributeSet, CurrentRage);
 
-	UPROPERTY(BlueprintReadOnly, Category = "Rage")
+	UPROPERTY(BlueprintReadOnly, Category = "Rage", ReplicatedUsing = OnRep_MaxRage)
 	FGameplayAttributeData MaxRage;
 	ATTRIBUTE_ACCESSORS(UBasicAttributeSet, MaxRage);
 
-	UPROPERTY(BlueprintReadOnly, Category = "Damage")
+	UPROPERTY(BlueprintReadOnly, Category = "Damage", ReplicatedUsing = OnRep_AttackPower)
 	FGameplayAttributeData AttackPower;
 	ATTRIBUTE_ACCESSORS(UBasicAttributeSet, AttackPower);
 
-	UPROPERTY(BlueprintReadOnly, Category = "Damage")
+	UPROPERTY(BlueprintReadOnly, Category = "Damage", ReplicatedUsing = OnRep_DefensePower)
 	FGameplayAttributeData DefensePower;
 	ATTRIBUTE_ACCESSORS(UBasicAttributeSet, DefensePower);
 
@@ -80,6 +101,33 @@ public:
 	FGameplayAttributeData DamageTaken;
 	ATTRIBUTE_ACCESSORS(UBasicAttributeSet, DamageTaken);
 
+protected:
+	// 客户端收到属性复制时调用 --> 生命值/怒气值的变化同时推送给UI，DamageTaken为元属性不复制
+	UFUNCTION()
+	void OnRep_CurrentHealth(const FGameplayAttributeData& OldCurrentHealth);
+
+	UFUNCTION()
+	void OnRep_MaxHealth(const FGameplayAttributeData& OldMaxHealth);
+
+	UFUNCTION()
+	void OnRep_CurrentRage(const FGameplayAttributeData& OldCurrentRage);
+
+	UFUNCTION()
+	void OnRep_MaxRage(const FGameplayAttributeData& OldMaxRage);
+
+	UFUNCTION()
+	void OnRep_AttackPower(const FGameplayAttributeData& OldAttackPower);
+
+	UFUNCTION()
+	void OnRep_DefensePower(const FGameplayAttributeData& OldDefensePower);
+
 private:
+	/**
+	 * @brief 按当前怒气值刷新怒气已满/为空的状态标签
+	 */
+	void UpdateRageStatusTags(AActor* InAvatarActor) const;
+
 	TWeakInterfacePtr<IPawnUIInterface> CachedPawnUIInterface;
+
+	bool bSuppressUINotifications = false;
 };
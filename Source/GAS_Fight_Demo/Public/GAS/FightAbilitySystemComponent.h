@@ -8,6 +8,32 @@
 #include "FightAbilitySystemComponent.generated.h"
 
 
+/**
+ * @brief 缓存的能力规格引用
+ *
+ * 除句柄外还记录规格在ActivatableAbilities中的下标与选择权重，
+ * 激活时优先按下标直接访问，避免FindAbilitySpecFromHandle的线性查找
+ */
+struct FFightCachedAbilitySpecRef
+{
+	FGameplayAbilitySpecHandle Handle;
+	int32 SpecIndex = INDEX_NONE;
+	float SelectionWeight = 1.f;
+};
+
+
+/**
+ * @brief 冷却登记项：冷却效果被添加时记录一次，之后查询剩余时间无需再扫描活跃效果
+ */
+struct FFightCooldownEntry
+{
+	FActiveGameplayEffectHandle EffectHandle;
+	// 取自活跃效果的StartWorldTime --> 客户端上已按服务器时间校正
+	float StartTime = 0.f;
+	float Duration = 0.f;
+};
+
+
 /**
  * UFightAbilitySystemComponent类
  *
@@ -75,6 +101,7 @@ public:
 	 * 6. 授予能力并保存能力句柄
 	 *
 	 * @note 使用GetDynamicSpecSourceTags()替代已弃用的DynamicAbilityTags()方法
+	 * @note bKeepWeaponAbilitiesGranted为true时，同一能力类+输入标签只会授予一次，之后再装备只是重新启用已有的规格
 	 */
 	UFUNCTION(BlueprintCallable, Category = "Fight|Ability", meta = (ApplyLevel = "1"))
 	void GrantPlayerWeaponAbilities(const TArray<FFightPlayerAbilitySet>& InDefaultWeaponAbilities,
@@ -97,10 +124,148 @@ public:
 	 * 5. 清空句柄数组
 	 *
 	 * @note 函数执行完成后会清空传入的句柄数组
+	 * @note bKeepWeaponAbilitiesGranted为true时不会清除能力，只是取消并禁用 --> 武器切换不再产生能力实例的创建与回收
 	 */
 	UFUNCTION(BlueprintCallable, Category = "Fight|Ability")
 	void RemovedGrantedHeroWeaponAbilities(UPARAM(Ref) TArray<FGameplayAbilitySpecHandle>& InSpecHandlesToRemove);
 
+	/**
+	 * @brief 按能力标签加权选择并激活一个匹配的能力
+	 *
+	 * 标签到能力规格的映射按需构建并缓存，能力被授予/移除时整体失效，
+	 * 避免每次调用都遍历所有能力规格并做标签容器匹配
+	 *
+	 * @details
+	 * 1. 从缓存中取出资产标签包含该标签的能力规格
+	 * 2. 第一次遍历：累加满足标签需求的能力的选择权重
+	 * 3. 使用可设置种子的随机流在总权重内取值，第二次遍历定位被选中的能力
+	 * 4. 稳定状态下（缓存已建立）整个过程不产生任何内存分配
+	 *
+	 * @see UFightGameplayAbility::ActivationSelectionWeight
+	 */
 	UFUNCTION(BlueprintCallable, Category = "Fight|Ability")
 	bool TryActivateAbilityByTag(FGameplayTag AbilityTagToActivate);
+
+	/**
+	 * @brief 同TryActivateAbilityByTag，并返回被激活能力的规格句柄，供行为树任务等待能力结束
+	 */
+	bool NativeTryActivateAbilityByTag(const FGameplayTag& AbilityTagToActivate, FGameplayAbilitySpecHandle& OutActivatedSpecHandle);
+
+	/**
+	 * @brief 是否存在可按标签选择、未在激活中且不在冷却中的能力 --> 行为树按冷却筛选分支时使用
+	 */
+	bool HasActivatableAbilityByTag(const FGameplayTag& InAbilityTag);
+
+	/**
+	 * @brief 设置按标签选择能力所用随机流的种子 --> 相同种子下选择序列可复现
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Fight|Ability")
+	void SetAbilitySelectionSeed(int32 InSeed);
+
+	/**
+	 * @brief 按冷却标签查询冷却时间
+	 *
+	 * 冷却登记表由冷却效果的添加/移除事件维护，查询只遍历登记表，而不是扫描所有活跃效果；
+	 * 与MatchAnyOwningTags一致按层级匹配 --> 查询父标签时子标签的冷却同样命中，多项命中时取剩余时间最长的一项
+	 *
+	 * @return 冷却仍在进行中时返回true
+	 */
+	bool GetCooldownRemainingByTag(const FGameplayTag& InCooldownTag, float& OutTotalCooldown, float& OutRemainingCooldown) const;
+
+	/**
+	 * @brief 能力规格是否因武器被卸下而处于禁用状态
+	 *
+	 * 禁用集合复制给拥有者客户端，客户端预测激活时同样会拒绝被禁用的能力
+	 */
+	FORCEINLINE bool IsAbilitySpecDisabled(const FGameplayAbilitySpecHandle& InSpecHandle) const
+	{
+		return !DisabledAbilitySpecHandles.IsEmpty() && DisabledAbilitySpecHandles.Contains(InSpecHandle);
+	}
+
+protected:
+	// 卸下武器时是否保留已授予的武器能力（只禁用），关闭后恢复为每次装备重新授予、卸下时清除
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Fight|Ability")
+	bool bKeepWeaponAbilitiesGranted = true;
+
+protected:
+	// ~Begin UObject Interface
+	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+	// ~End UObject Interface
+
+	// ~Begin UActorComponent Interface
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+	// ~End UActorComponent Interface
+
+	// ~Begin UAbilitySystemComponent Interface
+	virtual void OnGiveAbility(FGameplayAbilitySpec& AbilitySpec) override;
+	virtual void OnRemoveAbility(FGameplayAbilitySpec& AbilitySpec) override;
+	// ~End UAbilitySystemComponent Interface
+
+private:
+	/**
+	 * @brief 获取（必要时构建）资产标签包含指定标签的能力规格列表
+	 */
+	const TArray<FFightCachedAbilitySpecRef>& GetCachedAbilitySpecsByTag(const FGameplayTag& InAbilityTag);
+
+	/**
+	 * @brief 由缓存引用解析能力规格，下标失配时退回按句柄查找
+	 */
+	FGameplayAbilitySpec* ResolveCachedAbilitySpec(const FFightCachedAbilitySpecRef& InSpecRef);
+
+	/**
+	 * @brief 能力是否参与按标签选择：满足标签需求且权重大于0
+	 */
+	bool IsSpecSelectableByTag(const FGameplayAbilitySpec* InAbilitySpec, const FFightCachedAbilitySpecRef& InSpecRef) const;
+
+	/**
+	 * @brief 效果被添加到自身时调用，登记其授予的Player.Cooldown.*标签
+	 *
+	 * 只有玩家UI组件开启了bBroadcastCooldownBeginNatively时才向UI推送冷却开始，默认关闭 --> 现有蓝图能力仍自行广播
+	 */
+	void OnActiveEffectAddedToSelf(UAbilitySystemComponent* InTargetASC, const FGameplayEffectSpec& InSpec,
+		FActiveGameplayEffectHandle InActiveHandle);
+
+	/**
+	 * @brief 效果被移除时调用，注销对应的冷却登记
+	 */
+	void OnActiveEffectRemoved(const FActiveGameplayEffect& InRemovedEffect);
+
+	// 冷却标签 --> 冷却登记项
+	TMap<FGameplayTag, FFightCooldownEntry> ActiveCooldowns;
+
+	// 冷却标签 --> 对应特殊能力的输入标签，授予武器特殊能力时记录，用于UI推送
+	TMap<FGameplayTag, FGameplayTag> CooldownTagToInputTag;
+
+	/**
+	 * @brief 授予武器能力，或重新启用之前授予过的同类能力
+	 */
+	FGameplayAbilitySpecHandle GrantOrEnableWeaponAbility(const FFightPlayerAbilitySet& InAbilitySet, int32 ApplyLevel);
+
+	// (能力类, 输入标签) --> 已授予的武器能力规格，保留授予模式下装备武器时复用
+	TMap<TPair<UClass*, FGameplayTag>, FGameplayAbilitySpecHandle> GrantedWeaponAbilitySpecs;
+
+	/**
+	 * @brief 启用/禁用能力规格，服务器上同时更新复制数组
+	 */
+	void SetAbilitySpecDisabled(const FGameplayAbilitySpecHandle& InSpecHandle, bool bDisabled);
+
+	UFUNCTION()
+	void OnRep_DisabledAbilitySpecHandles();
+
+	// 武器卸下后被禁用的能力规格 --> 查询用的集合，客户端由复制数组重建
+	TSet<FGameplayAbilitySpecHandle> DisabledAbilitySpecHandles;
+
+	// 禁用能力规格的复制副本（TSet无法复制），只在装备/卸下武器时变化
+	UPROPERTY(ReplicatedUsing = OnRep_DisabledAbilitySpecHandles)
+	TArray<FGameplayAbilitySpecHandle> ReplicatedDisabledAbilitySpecHandles;
+
+	FDelegateHandle OnActiveEffectAddedDelegateHandle;
+	FDelegateHandle OnActiveEffectRemovedDelegateHandle;
+
+	// 能力标签 --> 能力规格列表的缓存，授予/移除能力时清空
+	TMap<FGameplayTag, TArray<FFightCachedAbilitySpecRef>> AbilityTagToSpecsCache;
+
+	// 按标签选择能力所用的随机流 --> 默认随机种子，需要可复现时通过SetAbilitySelectionSeed指定
+	FRandomStream AbilitySelectionRandomStream = FRandomStream(FMath::Rand());
 };
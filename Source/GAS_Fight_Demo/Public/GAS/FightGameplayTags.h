@@ -83,10 +83,12 @@ namespace FightGameplayTags
 	GAS_FIGHT_DEMO_API UE_DECLARE_GAMEPLAY_TAG_EXTERN(Player_Ability_Attack_Heavy_Spear);
 	GAS_FIGHT_DEMO_API UE_DECLARE_GAMEPLAY_TAG_EXTERN(Player_Ability_Attack_Light_Spear);
 
+	GAS_FIGHT_DEMO_API UE_DECLARE_GAMEPLAY_TAG_EXTERN(Player_Cooldown);
 	GAS_FIGHT_DEMO_API UE_DECLARE_GAMEPLAY_TAG_EXTERN(Player_Cooldown_SpecialWeaponAbility_Light);
 	GAS_FIGHT_DEMO_API UE_DECLARE_GAMEPLAY_TAG_EXTERN(Player_Cooldown_SpecialWeaponAbility_Heavy);
 
 	// 玩家武器标签，用于标识当前装备的武器类型
+	GAS_FIGHT_DEMO_API UE_DECLARE_GAMEPLAY_TAG_EXTERN(Player_Weapon);
 	GAS_FIGHT_DEMO_API UE_DECLARE_GAMEPLAY_TAG_EXTERN(Player_Weapon_Axe);
 	GAS_FIGHT_DEMO_API UE_DECLARE_GAMEPLAY_TAG_EXTERN(Player_Weapon_Spear);
 
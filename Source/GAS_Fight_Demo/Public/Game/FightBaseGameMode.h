@@ -5,9 +5,27 @@
 #include "CoreMinimal.h"
 #include "GameFramework/GameModeBase.h"
 #include "FightTypes/FightEnumTypes.h"
+#include "DataAsset/Difficulty/DataAsset_DifficultyPolicy.h"
+#include "FightTypes/FightInputLog.h"
 #include "FightBaseGameMode.generated.h"
 
 
+/**
+ * @brief 攻击令牌：记录某个攻击者正在对某个目标发起近战攻击
+ */
+USTRUCT()
+struct FFightAttackToken
+{
+	GENERATED_BODY()
+
+	TWeakObjectPtr<AActor> Attacker;
+	TWeakObjectPtr<AActor> Target;
+
+	// 获取令牌时的世界时间，用于超时回收
+	float AcquiredTime = 0.f;
+};
+
+
 UCLASS()
 class GAS_FIGHT_DEMO_API AFightBaseGameMode : public AGameModeBase
 {
@@ -16,13 +34,164 @@ class GAS_FIGHT_DEMO_API AFightBaseGameMode : public AGameModeBase
 public:
 	AFightBaseGameMode();
 
+	/**
+	 * @brief 查询攻击者当前能否对目标获取攻击令牌（不会修改令牌状态）
+	 *
+	 * @return 攻击者已持有令牌，或目标的令牌数量未达上限时返回true
+	 */
+	bool CanAcquireAttackToken(const AActor* InAttacker, const AActor* InTarget) const;
+
+	/**
+	 * @brief 尝试为攻击者获取针对目标的攻击令牌
+	 *
+	 * 同一目标同时只允许MaxAttackTokensPerTarget个攻击者进行近战攻击，
+	 * 其余敌人的攻击激活会在能力层被直接拒绝，避免无效的蒙太奇播放与命中检测
+	 *
+	 * @return 是否获取成功（已持有令牌也视为成功）
+	 */
+	bool TryAcquireAttackToken(AActor* InAttacker, AActor* InTarget);
+
+	/**
+	 * @brief 释放攻击者持有的攻击令牌
+	 */
+	void ReleaseAttackToken(const AActor* InAttacker);
+
+	/**
+	 * @brief 设置当前难度，并重新解析缓存的难度配置
+	 */
+	void SetCurrentGameDifficulty(EFightGameDifficulty InDifficulty);
+
+	/**
+	 * @brief 为需要独立随机流的对象（如能力选择）生成种子
+	 *
+	 * 确定性模式下由主种子派生，只要调用顺序相同，得到的种子序列就相同
+	 */
+	int32 GenerateGameplaySeed();
+
+	/**
+	 * @brief 游戏模式拥有的玩法随机流，波次生成等随机都应从这里取值
+	 */
+	FORCEINLINE FRandomStream& GetGameplayRandomStream() { return GameplayRandomStream; }
+
+	/**
+	 * @brief 在生成点附近取一个导航可达的随机位置 --> 确定性模式下只使用游戏模式的随机流
+	 *
+	 * 波次生成与能力召唤的敌人都从这里取位置，导航系统的随机查询使用全局随机数，会破坏回放的一致性
+	 */
+	FVector GetRandomSpawnLocation(const FVector& InOrigin, float InRadius);
+
+	FORCEINLINE bool IsDeterministicMode() const { return bDeterministicMode; }
+	FORCEINLINE int32 GetDeterministicSeed() const { return DeterministicSeed; }
+	FORCEINLINE float GetFixedSimulationDeltaTime() const { return 1.f / FixedSimulationHz; }
+
+	/**
+	 * @brief 本局需要录制输入时的文件路径，为空表示不录制
+	 */
+	FORCEINLINE const FString& GetInputRecordFilePath() const { return InputRecordFilePath; }
+
+	/**
+	 * @brief 本局需要回放的输入日志，无回放时为空
+	 */
+	FORCEINLINE TSharedPtr<const FFightInputLog> GetReplayInputLog() const { return ReplayInputLog; }
+
+	/**
+	 * @brief 回放结束时调用，按选项决定是否退出进程（用于无界面的批量回放）
+	 */
+	void NotifyInputReplayFinished();
+
 protected:
+	// ~Begin AGameModeBase Interface
+	virtual void InitGame(const FString& MapName, const FString& Options, FString& ErrorMessage) override;
+	// ~End AGameModeBase Interface
+
+	// ~Begin AActor Interface
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+	// ~End AActor Interface
+
+	// 确定性模式下的固定模拟频率
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Game Settings|Deterministic", meta = (ClampMin = "1"))
+	float FixedSimulationHz = 60.f;
+
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Game Settings")
 	EFightGameDifficulty CurrentGameDifficulty;
 
+	// 难度策略 --> 为空时使用与原先硬编码等级表一致的默认配置
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Game Settings")
+	UDataAsset_DifficultyPolicy* DifficultyPolicy;
+
+	// 每个目标同时允许的近战攻击者数量
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Game Settings|Attack Token", meta = (ClampMin = "1"))
+	int32 MaxAttackTokensPerTarget = 2;
+
+	// 令牌最长持有时间，超时后自动回收 --> 防止能力异常未结束导致令牌永久占用
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Game Settings|Attack Token")
+	float AttackTokenTimeout = 5.f;
+
+private:
+	/**
+	 * @brief 回收失效（攻击者/目标已销毁）或超时的令牌
+	 */
+	void PruneAttackTokens();
+
+	int32 CountAttackTokensOnTarget(const AActor* InTarget) const;
+
+	int32 FindAttackTokenIndex(const AActor* InAttacker) const;
+
+	UPROPERTY()
+	TArray<FFightAttackToken> ActiveAttackTokens;
+
+	/**
+	 * @brief 按当前难度解析一次难度配置，之后角色占有、伤害计算与波次生成都只读取缓存
+	 */
+	void ResolveDifficultyPolicy();
+
+	UPROPERTY()
+	FFightDifficultyPolicyEntry CachedDifficultyPolicyEntry;
+
+	/**
+	 * @brief 解析确定性模式相关的URL选项
+	 *
+	 * ?Deterministic 启用固定步长与固定种子，?Seed=N 指定种子，
+	 * ?RecordInput=Name 录制输入，?ReplayInput=Name 回放输入（隐含确定性模式，种子与步长取自日志），
+	 * ?ExitOnReplayEnd 回放结束后退出
+	 */
+	void InitDeterministicMode(const FString& InOptions);
+
+	static FString GetInputLogFilePath(const FString& InLogName);
+
+	bool bDeterministicMode = false;
+	bool bExitOnReplayEnd = false;
+	bool bRestoreFixedTimeStep = false;
+	bool bRestoreFixedDeltaTime = false;
+	int32 DeterministicSeed = 0;
+
+	// 进入确定性模式前的固定步长，EndPlay时还原
+	double PreviousFixedDeltaTime = 0.0;
+
+	FRandomStream GameplayRandomStream;
+	FRandomStream SeedRandomStream;
+
+	FString InputRecordFilePath;
+	TSharedPtr<const FFightInputLog> ReplayInputLog;
+
 public:
 	FORCEINLINE EFightGameDifficulty GetCurrentGameDifficulty() const
 	{
 		return CurrentGameDifficulty;
 	}
+
+	FORCEINLINE const FFightDifficultyPolicyEntry& GetCurrentDifficultyPolicyEntry() const
+	{
+		return CachedDifficultyPolicyEntry;
+	}
+
+	FORCEINLINE int32 GetPlayerAbilityApplyLevel() const
+	{
+		return CachedDifficultyPolicyEntry.PlayerAbilityApplyLevel;
+	}
+
+	FORCEINLINE int32 GetEnemyAbilityApplyLevel() const
+	{
+		return CachedDifficultyPolicyEntry.EnemyAbilityApplyLevel;
+	}
 };
@@ -0,0 +1,154 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "FightEnemyCrowdManager.generated.h"
+
+
+class AEnemyCharacter;
+class UInstancedStaticMeshComponent;
+class UStaticMesh;
+
+
+/**
+ * @brief 轻量敌人的"原型"：同一敌人类 + 同一代理网格共享一个实例化网格组件
+ */
+USTRUCT()
+struct FFightCrowdArchetype
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TSubclassOf<AEnemyCharacter> EnemyClass;
+
+	UPROPERTY()
+	TObjectPtr<UStaticMesh> ProxyMesh;
+
+	UPROPERTY()
+	TObjectPtr<UInstancedStaticMeshComponent> InstancedMeshComponent;
+
+	// 每个实例的变换，空闲实例缩放为0 --> 每帧整体提交一次BatchUpdateInstancesTransforms
+	TArray<FTransform> InstanceTransforms;
+
+	// 已被回收、可以复用的实例下标
+	TArray<int32> FreeInstanceIndices;
+};
+
+
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnLightweightEnemyPromotedDelegate, AEnemyCharacter*);
+DECLARE_MULTICAST_DELEGATE(FOnLightweightEnemyDespawnedDelegate);
+DECLARE_DELEGATE_RetVal(bool, FCanPromoteLightweightEnemyDelegate);
+
+
+/**
+ * @brief 轻量敌人群体管理器
+ *
+ * 远处/背景敌人不生成完整的AEnemyCharacter（ASC、属性集、动作扭曲、碰撞盒、血条组件），
+ * 而是作为连续数组中的一条"实体"存在，并由实例化网格统一渲染
+ *
+ * @details
+ * 1. 实体数据以SoA方式存放：位置、朝向、原型下标、实例下标
+ * 2. 每帧在一个循环中推进所有实体朝各自的导航路径点移动，并按原型批量提交实例变换
+ * 3. 路径点通过导航网格寻路得到，每帧只为少量实体寻路（分摊开销）；没有导航数据时才直接朝玩家直线移动
+ * 4. 进入交战范围的实体在CanPromoteLightweightEnemy允许时被提升为完整的AEnemyCharacter，否则原地等待
+ * 5. 每个实例带一个自定义数据（动画相位），供顶点动画材质使用，相位取自可播种的随机流
+ * 6. 持续寻路失败（或只能得到部分路径）超过StuckDespawnTimeout的实体被移除，由游戏模式在别处补生成，避免波次卡住
+ */
+UCLASS(NotBlueprintable)
+class GAS_FIGHT_DEMO_API AFightEnemyCrowdManager : public AActor
+{
+	GENERATED_BODY()
+
+public:
+	AFightEnemyCrowdManager();
+
+	virtual void Tick(float DeltaTime) override;
+
+	/**
+	 * @brief 添加一个轻量敌人实体
+	 *
+	 * @param InEnemyClass 提升时要生成的完整敌人类
+	 * @param InProxyMesh 轻量状态下使用的代理网格
+	 * @param InLocation 实体所在位置（通常是导航网格上的点）
+	 * @param InYaw 初始朝向
+	 * @return 是否添加成功
+	 */
+	bool AddLightweightEnemy(TSubclassOf<AEnemyCharacter> InEnemyClass, UStaticMesh* InProxyMesh,
+		const FVector& InLocation, float InYaw);
+
+	FORCEINLINE int32 GetNumLightweightEnemies() const { return EntityLocations.Num(); }
+
+	/**
+	 * @brief 设置动画相位等随机值使用的种子 --> 确定性模式下由游戏模式派生
+	 */
+	FORCEINLINE void InitializeRandomStream(int32 InSeed) { RandomStream.Initialize(InSeed); }
+
+	// 实体被提升为完整敌人时广播
+	FOnLightweightEnemyPromotedDelegate OnLightweightEnemyPromoted;
+
+	// 每次提升前询问是否还能生成完整敌人（如完整敌人数量上限），未绑定时总是允许
+	FCanPromoteLightweightEnemyDelegate CanPromoteLightweightEnemy;
+
+	// 卡住的实体被移除时广播，每个实体一次 --> 该实体既没有被提升也没有被击杀
+	FOnLightweightEnemyDespawnedDelegate OnLightweightEnemyDespawned;
+
+	// 进入该半径（到玩家的水平距离）的实体会被提升为完整敌人
+	float PromotionRadius = 2000.f;
+
+	// 轻量实体朝玩家移动的速度
+	float MoveSpeed = 250.f;
+
+	// 每个实体重新寻路的间隔
+	float PathRefreshInterval = 1.f;
+
+	// 每帧最多执行的寻路次数
+	int32 MaxPathQueriesPerFrame = 8;
+
+	// 实体持续无法寻路到玩家超过该时间后被移除
+	float StuckDespawnTimeout = 5.f;
+
+private:
+	int32 FindOrAddArchetype(TSubclassOf<AEnemyCharacter> InEnemyClass, UStaticMesh* InProxyMesh);
+
+	/**
+	 * @brief 尝试把实体提升为完整敌人，成功后回收该实体
+	 */
+	bool TryPromoteEntity(int32 InEntityIndex);
+
+	void RemoveEntityAtSwap(int32 InEntityIndex);
+
+	/**
+	 * @brief 移除持续寻路失败超过StuckDespawnTimeout的实体
+	 */
+	void DespawnStuckEntities(float InCurrentTime);
+
+	/**
+	 * @brief 为实体寻路到玩家，并把路径上的下一个点作为新的路径点
+	 *
+	 * 寻路失败时路径点保持为当前位置，实体原地等待下一次寻路 --> 不会穿墙直线移动；
+	 * 失败与部分路径都会记录开始卡住的时间，完整路径清除该记录
+	 */
+	void RefreshEntityWaypoint(int32 InEntityIndex, const FVector& InPlayerLocation, float InCurrentTime);
+
+	UPROPERTY()
+	TArray<FFightCrowdArchetype> Archetypes;
+
+	// 实体数据（SoA），同一下标对应同一个实体
+	TArray<FVector> EntityLocations;
+	TArray<float> EntityYaws;
+	TArray<int32> EntityArchetypeIndices;
+	TArray<int32> EntityInstanceIndices;
+	TArray<FVector> EntityWaypoints;
+	TArray<float> EntityNextPathTimes;
+
+	// 开始无法寻路到玩家的时间，小于0表示最近一次寻路成功
+	TArray<float> EntityStuckStartTimes;
+
+	// 每帧复用的待提升/待寻路实体列表
+	TArray<int32> PendingPromotionIndices;
+	TArray<int32> PendingPathIndices;
+
+	FRandomStream RandomStream;
+};
@@ -0,0 +1,155 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "GameplayTagContainer.h"
+#include "Abilities/GameplayAbilityTypes.h"
+#include "FightEventBusSubsystem.generated.h"
+
+
+class UAbilitySystemComponent;
+
+
+/**
+ * @brief 游戏事件的派发时机
+ */
+enum class EFightEventDispatch : uint8
+{
+	// 立即派发，用于伤害、格挡等影响判定结果的事件
+	Immediate,
+
+	// 延迟到帧末批量派发，用于顿帧、UI、特效等不影响判定结果的事件
+	Deferred
+};
+
+
+/**
+ * @brief 单个事件标签的吞吐计数
+ */
+struct FFightEventCounter
+{
+	int64 ImmediateCount = 0;
+	int64 DeferredCount = 0;
+
+	// 同一帧内重复的延迟事件被合并的次数
+	int64 CoalescedCount = 0;
+
+	// 接收者没有ASC而被丢弃的次数
+	int64 DroppedCount = 0;
+
+	// 事件触发的能力总数
+	int64 TriggeredAbilityCount = 0;
+};
+
+
+/**
+ * @brief 战斗游戏事件总线
+ *
+ * 替代逐次构造FGameplayEventData并调用UAbilitySystemBlueprintLibrary::SendGameplayEventToActor的写法，
+ * 直接把事件交给接收者的ASC处理
+ *
+ * @details
+ * 1. 负载从对象池中取用并在派发后复位，不再每次命中都构造新的FGameplayEventData；
+ *    事件处理中同步触发的嵌套事件使用池中的下一个负载，互不覆盖
+ * 2. 延迟事件进入帧末队列，在本子系统Tick（所有Actor Tick之后）中按入队顺序派发，
+ *    同一帧内接收者、标签、发起者、目标都相同的延迟事件只派发一次
+ * 3. 按标签统计吞吐，控制台命令 Fight.EventBus.Dump 输出，Fight.EventBus.Reset 清零
+ */
+UCLASS()
+class GAS_FIGHT_DEMO_API UFightEventBusSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	// ~Begin USubsystem Interface
+	virtual void Deinitialize() override;
+	// ~End USubsystem Interface
+
+	// ~Begin FTickableGameObject Interface
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+	// ~End FTickableGameObject Interface
+
+	/**
+	 * @brief 向接收者发送游戏事件
+	 *
+	 * 接收者所在世界没有事件总线时（如编辑器预览世界）退化为立即派发
+	 *
+	 * @param InReceiver 事件接收者，由其ASC处理事件
+	 * @param InEventTag 事件标签
+	 * @param InInstigator 负载中的发起者
+	 * @param InEventTarget 负载中的目标
+	 * @param InDispatch 派发时机
+	 */
+	static void SendFightEvent(AActor* InReceiver, const FGameplayTag& InEventTag, AActor* InInstigator = nullptr,
+		AActor* InEventTarget = nullptr, EFightEventDispatch InDispatch = EFightEventDispatch::Immediate);
+
+	void SendEvent(AActor* InReceiver, const FGameplayTag& InEventTag, AActor* InInstigator, AActor* InEventTarget,
+		EFightEventDispatch InDispatch);
+
+	/**
+	 * @brief 立即派发帧末队列中的全部事件
+	 */
+	void FlushDeferredEvents();
+
+	void DumpEventCounters(FOutputDevice& Ar) const;
+	void ResetEventCounters();
+
+	/**
+	 * @brief 查询单个事件标签的吞吐计数
+	 *
+	 * @return 该标签还没有发送过事件时返回nullptr
+	 */
+	FORCEINLINE const FFightEventCounter* FindEventCounter(const FGameplayTag& InEventTag) const { return EventCounters.Find(InEventTag); }
+
+protected:
+	// ~Begin UWorldSubsystem Interface
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	// ~End UWorldSubsystem Interface
+
+private:
+	/**
+	 * @brief 等待帧末派发的事件
+	 */
+	struct FFightDeferredEvent
+	{
+		TWeakObjectPtr<AActor> Receiver;
+		FGameplayTag EventTag;
+		TWeakObjectPtr<AActor> Instigator;
+		TWeakObjectPtr<AActor> EventTarget;
+
+		bool operator==(const FFightDeferredEvent& Other) const
+		{
+			return Receiver == Other.Receiver && EventTag == Other.EventTag &&
+				Instigator == Other.Instigator && EventTarget == Other.EventTarget;
+		}
+	};
+
+	/**
+	 * @brief 把事件交给接收者的ASC处理
+	 *
+	 * @return 事件触发的能力数量，接收者没有ASC时返回INDEX_NONE
+	 */
+	static int32 DispatchToAbilitySystem(AActor* InReceiver, const FGameplayTag& InEventTag, FGameplayEventData& InOutPayload);
+
+	static UAbilitySystemComponent* ResolveAbilitySystemComponent(AActor* InReceiver);
+
+	static void ResetPayload(FGameplayEventData& InOutPayload);
+
+	int32 DispatchPooled(AActor* InReceiver, const FGameplayTag& InEventTag, AActor* InInstigator, AActor* InEventTarget);
+
+	void RecordDispatchResult(FFightEventCounter& InOutCounter, int32 InTriggeredCount);
+
+	// 负载池，下标即嵌套派发的深度 --> 元素单独分配，扩容时已借出的负载地址不变
+	TArray<TUniquePtr<FGameplayEventData>> PayloadPool;
+	int32 PayloadPoolDepth = 0;
+
+	TArray<FFightDeferredEvent> DeferredEvents;
+
+	// 派发中的队列，与DeferredEvents交换使用 --> 派发过程中新入队的事件留到下一帧
+	TArray<FFightDeferredEvent> FlushingEvents;
+
+	TMap<FGameplayTag, FFightEventCounter> EventCounters;
+};
@@ -0,0 +1,109 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "FightHitValidationSubsystem.generated.h"
+
+
+class ACharacter;
+
+
+/**
+ * @brief 某一时刻胶囊体的位置快照
+ */
+struct FFightHitValidationSnapshot
+{
+	double Time = 0.0;
+	FVector CapsuleLocation = FVector::ZeroVector;
+};
+
+
+/**
+ * @brief 单个角色（目标或攻击者）的快照环形缓冲区
+ */
+struct FFightHitValidationHistory
+{
+	TWeakObjectPtr<ACharacter> Character;
+
+	float CapsuleRadius = 0.f;
+	float CapsuleHalfHeight = 0.f;
+
+	// 固定长度的环形缓冲区，HeadIndex指向最新的快照
+	TArray<FFightHitValidationSnapshot> Snapshots;
+	int32 HeadIndex = INDEX_NONE;
+	int32 NumSnapshots = 0;
+};
+
+
+/**
+ * @brief 近战命中验证子系统（仅服务器）
+ *
+ * 按固定间隔记录已注册角色（敌人与玩家）的胶囊体位置，客户端上报的命中（目标、挥砍ID、时间戳）
+ * 在服务器上把攻击者与目标都回溯到上报时刻进行距离校验，通过后再走原有的Shared.Event.MeleeHit伤害流程
+ *
+ * @details
+ * 1. 每个角色保存最近MaxRewindTime秒的快照，回溯时在相邻两个快照之间插值
+ * 2. 上报时间早于可回溯范围或晚于服务器当前时间的命中直接拒绝
+ * 3. 未注册的目标使用其当前位置校验
+ * 4. 未注册的攻击者使用其当前位置，容差按其速度乘以回溯时长放宽 --> 上报时刻之后的移动不会导致误拒
+ */
+UCLASS()
+class GAS_FIGHT_DEMO_API UFightHitValidationSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	// ~Begin USubsystem Interface
+	virtual void Deinitialize() override;
+	// ~End USubsystem Interface
+
+	// ~Begin FTickableGameObject Interface
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+	// ~End FTickableGameObject Interface
+
+	/**
+	 * @brief 注册/注销需要记录位置历史的角色（命中目标或攻击者）
+	 */
+	void RegisterHitTarget(ACharacter* InCharacter);
+	void UnregisterHitTarget(ACharacter* InCharacter);
+
+	/**
+	 * @brief 回溯到上报时刻，校验攻击者能否命中目标
+	 *
+	 * @param InAttacker 攻击者，已注册时同样回溯到上报时刻
+	 * @param InTarget 上报命中的目标
+	 * @param InClaimServerTime 客户端估算的服务器时间
+	 *
+	 * @return 时间戳在可回溯范围内，且回溯后的目标胶囊体在攻击距离之内时返回true
+	 */
+	bool ValidateMeleeHit(const AActor* InAttacker, const AActor* InTarget, double InClaimServerTime) const;
+
+protected:
+	// ~Begin UWorldSubsystem Interface
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	// ~End UWorldSubsystem Interface
+
+private:
+	/**
+	 * @brief 求目标在指定时刻的胶囊体位置
+	 *
+	 * @return 历史中存在覆盖该时刻的快照时返回true
+	 */
+	bool RewindCapsuleLocation(const FFightHitValidationHistory& InHistory, double InTime, FVector& OutCapsuleLocation) const;
+
+	/**
+	 * @brief 攻击者位置到目标胶囊体表面的距离是否在攻击距离（加上额外容差）之内
+	 */
+	static bool IsWithinMeleeReach(const FVector& InAttackerLocation, const FVector& InCapsuleLocation,
+		float InCapsuleRadius, float InCapsuleHalfHeight, float InExtraTolerance);
+
+	void RecordSnapshot(FFightHitValidationHistory& InOutHistory, double InTime) const;
+
+	TMap<FObjectKey, FFightHitValidationHistory> TargetHistories;
+
+	double LastRecordTime = -1.0;
+};
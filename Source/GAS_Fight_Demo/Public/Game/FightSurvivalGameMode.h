@@ -4,10 +4,13 @@
 
 #include "CoreMinimal.h"
 #include "Game/FightBaseGameMode.h"
+#include "FightTypes/FightTimerWheel.h"
 #include "FightSurvivalGameMode.generated.h"
 
 
 class AEnemyCharacter;
+class AFightEnemyCrowdManager;
+class UStaticMesh;
 
 
 UENUM(BlueprintType)
@@ -35,6 +38,10 @@ struct FFightEnemyWaveSpawnerInfo
 
 	UPROPERTY(EditAnywhere)
 	int32 MaxPerSpawnCount = 3;
+
+	// 轻量状态下使用的代理网格，为空时该敌人总是以完整角色生成
+	UPROPERTY(EditAnywhere)
+	TSoftObjectPtr<UStaticMesh> SoftLightweightProxyMesh;
 };
 
 
@@ -49,6 +56,10 @@ public:
 
 	UPROPERTY(EditAnywhere)
 	int32 TotalEnemyToSpawnThisWave = 1;
+
+	// 是否按当前难度的生成倍率缩放本波次的敌人数量
+	UPROPERTY(EditAnywhere)
+	bool bScaleWithDifficulty = true;
 };
 
 
@@ -60,22 +71,69 @@ class GAS_FIGHT_DEMO_API AFightSurvivalGameMode : public AFightBaseGameMode
 {
 	GENERATED_BODY()
 	
+public:
+	AFightSurvivalGameMode();
+
 protected:
 	virtual void InitGame(const FString& MapName, const FString& Options, FString& ErrorMessage) override;
 	virtual void BeginPlay() override;
-	virtual void Tick(float DeltaTime) override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 private:
+	/**
+	 * @brief 存档读取完成后应用存档中的游戏难度
+	 */
+	void ApplySavedGameDifficulty();
+
 	void SetCurrentSurvivalGameModeState(EFightSurvivalGameModeState InState);
+
+	/**
+	 * @brief 波次状态计时结束时由时间轮调用，推进到下一个状态
+	 */
+	void OnWaveStateTimerFired();
 	bool HasFinishedAllWaves() const;
 	void PreloadNextWaveEnemies();
 	FFightEnemyWaveSpawnerTableRow* GetCurrentWaveSpawnerTableRow() const;
 	int32 TrySpawnWaveEnemies();
 	bool ShouldKeepSpawnEnemies() const;
 
+	/**
+	 * @brief 按难度生成倍率缩放当前波次的敌人数量
+	 * @note 不做保底，结果可能为0 --> 波次总数的保底在ShouldKeepSpawnEnemies中处理
+	 */
+	int32 ScaleWaveEnemyCount(int32 InBaseCount) const;
+
+	/**
+	 * @brief 把波次计数写入复制的游戏状态，供客户端UI读取
+	 */
+	void SyncWaveCountersToGameState() const;
+
 	UFUNCTION()
 	void OnEnemyDestroyed(AActor* DestroyedActor);
 
+	/**
+	 * @brief 完整敌人数量达到上限时，尝试以轻量实体的形式生成
+	 *
+	 * @return 是否已作为轻量实体生成
+	 */
+	bool TrySpawnLightweightEnemy(const FFightEnemyWaveSpawnerInfo& InSpawnerInfo, UClass* InEnemyClass,
+		const FVector& InLocation, const FRotator& InRotation);
+
+	/**
+	 * @brief 轻量实体进入交战范围被提升为完整敌人时调用 --> 该敌人已计入CurrentSpawnedEnemiesCounter，这里只绑定销毁回调
+	 */
+	void OnLightweightEnemyPromoted(AEnemyCharacter* InPromotedEnemy);
+
+	/**
+	 * @brief 卡住的轻量实体被移除时调用 --> 归还其在本波中的名额，并在别处补生成一个敌人
+	 */
+	void OnLightweightEnemyDespawned();
+
+	/**
+	 * @brief 完整敌人未达到MaxFullEnemiesAlive时才允许提升轻量实体
+	 */
+	bool CanPromoteLightweightEnemy() const;
+
 	UPROPERTY()
 	EFightSurvivalGameModeState CurrentSurvivalGameModeState;
 
@@ -100,8 +158,8 @@ private:
 	UPROPERTY()
 	TArray<AActor*> TargetPointArray;
 
-	UPROPERTY()
-	float TimePassedSinceStart = 0.f;
+	// 当前波次状态的计时器，状态切换时重新设置
+	FFightTimerHandle WaveStateTimerHandle;
 
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "WaveDefinition", meta = (AllowPrivateAccess = "true"))
 	float SpawnNewWaveWaitTime = 5.f;
@@ -115,6 +173,35 @@ private:
 	UPROPERTY()
 	TMap<TSoftClassPtr<AEnemyCharacter>, UClass*> PreLoadedEnemyClassMap;
 
+	// 是否启用轻量敌人层级 --> 启用后超出MaxFullEnemiesAlive的敌人以轻量实体生成，进入交战范围后再提升
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "WaveDefinition|Lightweight", meta = (AllowPrivateAccess = "true"))
+	bool bEnableLightweightEnemyTier = false;
+
+	// 同时存在的完整敌人数量上限
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "WaveDefinition|Lightweight", meta = (AllowPrivateAccess = "true", EditCondition = "bEnableLightweightEnemyTier"))
+	int32 MaxFullEnemiesAlive = 12;
+
+	// 轻量实体到玩家的水平距离小于该值时被提升为完整敌人
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "WaveDefinition|Lightweight", meta = (AllowPrivateAccess = "true", EditCondition = "bEnableLightweightEnemyTier"))
+	float LightweightPromotionRadius = 2000.f;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "WaveDefinition|Lightweight", meta = (AllowPrivateAccess = "true", EditCondition = "bEnableLightweightEnemyTier"))
+	float LightweightMoveSpeed = 250.f;
+
+	UPROPERTY()
+	AFightEnemyCrowdManager* EnemyCrowdManager;
+
+	// 当前存活的完整敌人数量（CurrentSpawnedEnemiesCounter同时包含轻量实体）
+	UPROPERTY()
+	int32 CurrentFullEnemiesCounter = 0;
+
+	// 本局已击败的敌人数量与开局时间，用于波次完成时的进度检查点
+	UPROPERTY()
+	int32 EnemiesDefeatedThisRun = 0;
+
+	UPROPERTY()
+	float RunStartTime = 0.f;
+
 public:
 	UFUNCTION(BlueprintCallable)
 	void RegisterSpawnedEnemies(const TArray<AEnemyCharacter*>& InEnemyToRegister);
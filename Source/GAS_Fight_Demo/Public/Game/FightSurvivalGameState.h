@@ -0,0 +1,62 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/GameStateBase.h"
+#include "Game/FightSurvivalGameMode.h"
+#include "FightSurvivalGameState.generated.h"
+
+
+/**
+ * @brief 生存模式的游戏状态
+ *
+ * 游戏模式只存在于服务器，客户端的波次UI改为从这里读取状态与计数，
+ * 状态变化在服务器上直接广播，在客户端由OnRep广播
+ */
+UCLASS()
+class GAS_FIGHT_DEMO_API AFightSurvivalGameState : public AGameStateBase
+{
+	GENERATED_BODY()
+
+public:
+	// ~Begin UObject Interface
+	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+	// ~End UObject Interface
+
+	/**
+	 * @brief 由服务器上的游戏模式调用，写入新的波次状态并广播
+	 */
+	void SetSurvivalGameModeState(EFightSurvivalGameModeState InState);
+
+	/**
+	 * @brief 由服务器上的游戏模式调用，同步波次计数
+	 */
+	void SetWaveCounters(int32 InCurrentWaveCount, int32 InTotalWavesToSpawn, int32 InAliveEnemiesCount);
+
+	UPROPERTY(BlueprintAssignable, Category = "Fight|Survival")
+	FOnSurvivalGameModeStateChangedDelegate OnSurvivalGameModeStateChanged;
+
+protected:
+	UFUNCTION()
+	void OnRep_SurvivalGameModeState();
+
+	UPROPERTY(ReplicatedUsing = OnRep_SurvivalGameModeState, BlueprintReadOnly, Category = "Fight|Survival")
+	EFightSurvivalGameModeState SurvivalGameModeState = EFightSurvivalGameModeState::WaitSpawnNewWave;
+
+	UPROPERTY(Replicated, BlueprintReadOnly, Category = "Fight|Survival")
+	int32 CurrentWaveCount = 1;
+
+	UPROPERTY(Replicated, BlueprintReadOnly, Category = "Fight|Survival")
+	int32 TotalWavesToSpawn = 0;
+
+	// 当前存活的敌人数量（包含轻量实体）
+	UPROPERTY(Replicated, BlueprintReadOnly, Category = "Fight|Survival")
+	int32 AliveEnemiesCount = 0;
+
+public:
+	FORCEINLINE EFightSurvivalGameModeState GetSurvivalGameModeState() const { return SurvivalGameModeState; }
+	FORCEINLINE int32 GetCurrentWaveCount() const { return CurrentWaveCount; }
+	FORCEINLINE int32 GetTotalWavesToSpawn() const { return TotalWavesToSpawn; }
+	FORCEINLINE int32 GetAliveEnemiesCount() const { return AliveEnemiesCount; }
+};
@@ -0,0 +1,58 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "FightTypes/FightTimerWheel.h"
+#include "FightTimerSubsystem.generated.h"
+
+
+/**
+ * @brief 战斗定时器子系统：世界内所有倒计时、冷却UI刷新与波次计时共用的时间轮
+ *
+ * 每帧只推进一次时间轮，暂停时不推进，时间受全局时间膨胀影响（与延迟节点一致）
+ */
+UCLASS()
+class GAS_FIGHT_DEMO_API UFightTimerSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	// ~Begin USubsystem Interface
+	virtual void Deinitialize() override;
+	// ~End USubsystem Interface
+
+	// ~Begin FTickableGameObject Interface
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+	// ~End FTickableGameObject Interface
+
+	/**
+	 * @brief 设置定时器
+	 *
+	 * @param InDelay 首次触发的延迟
+	 * @param InInterval 循环间隔，小于等于0时只触发一次
+	 */
+	FFightTimerHandle SetTimer(FFightTimerDelegate&& InDelegate, float InDelay, float InInterval = 0.f);
+
+	/**
+	 * @brief 清除定时器并使句柄失效
+	 */
+	void ClearTimer(FFightTimerHandle& InOutHandle);
+
+	bool IsTimerActive(const FFightTimerHandle& InHandle) const;
+
+	/**
+	 * @brief 距离下次触发的时间，定时器无效时返回-1
+	 */
+	float GetTimerRemaining(const FFightTimerHandle& InHandle) const;
+
+protected:
+	// ~Begin UWorldSubsystem Interface
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	// ~End UWorldSubsystem Interface
+
+private:
+	FFightTimerWheel TimerWheel;
+};
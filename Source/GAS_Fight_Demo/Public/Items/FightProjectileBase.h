@@ -11,7 +11,6 @@
 class UBoxComponent;
 class UNiagaraComponent;
 class UProjectileMovementComponent;
-struct FGameplayEventData;
 
 /**
  * @brief 定义投射物伤害应用策略
@@ -76,8 +75,8 @@ protected:
 	void BP_OnSpawnProjectileHitFX(const FVector& HitLocation);
 
 private:
-	// 处理投射物伤害应用
-	void HandleApplyProjectileDamage(APawn* InHitPawn, const FGameplayEventData& InPayLoad);
+	// 处理投射物伤害应用 --> InEventInstigator为受击反应事件的发起者
+	void HandleApplyProjectileDamage(APawn* InHitPawn, AActor* InEventInstigator);
 
 	// 已重叠的角色列表，防止重复伤害
 	TArray<AActor*> OverlappedActors;
@@ -18,6 +18,19 @@ class GAS_FIGHT_DEMO_API AFightPickUpBase : public AActor
 public:	
 	AFightPickUpBase();
 
+	// ~Begin AActor Interface
+	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+	// ~End AActor Interface
+
+	/**
+	 * @brief 激活/回收拾取物（仅服务器）
+	 *
+	 * 回收后隐藏并关闭碰撞，留在世界中等待对象池复用，而不是销毁
+	 */
+	void SetPickUpActive(bool bInActive);
+
+	FORCEINLINE bool IsPickUpActive() const { return bIsPickUpActive; }
+
 protected:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Pick Up Interaction")
 	USphereComponent* PickUpCollisionSphere;
@@ -25,4 +38,24 @@ protected:
 	UFUNCTION()
 	virtual void OnPickUpCollisionSphereBeginOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor,
 		UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult);
+
+	UFUNCTION()
+	virtual void OnPickUpCollisionSphereEndOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor,
+		UPrimitiveComponent* OtherComp, int32 OtherBodyIndex);
+
+	/**
+	 * @brief 拾取物被回收时调用，服务器与客户端都会执行
+	 *
+	 * 客户端上由复制的激活状态驱动；拾取物刚进入相关范围时的初始复制不算作回收
+	 */
+	virtual void OnPickUpDeactivated() {}
+
+private:
+	UFUNCTION()
+	void OnRep_IsPickUpActive();
+
+	void ApplyPickUpActiveState();
+
+	UPROPERTY(ReplicatedUsing = OnRep_IsPickUpActive)
+	bool bIsPickUpActive = true;
 };
@@ -0,0 +1,78 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "FightPickUpPoolSubsystem.generated.h"
+
+
+class AFightStoneBase;
+class UGameplayEffect;
+
+
+/**
+ * @brief 拾取物对象池子系统（石头的生成、合并与回收由服务器进行）
+ *
+ * 替代敌人掉落石头时每次生成新的拾取物、消耗后销毁的做法
+ *
+ * @details
+ * 1. 同类效果的石头落在已有石头附近时，叠加到已有石头上，不再生成新的Actor
+ * 2. 存活的石头数量有上限：达到上限时优先叠加到最近的同类石头上，没有同类时回收最早生成的石头
+ * 3. 消耗后的石头隐藏并关闭碰撞，按类保存在空闲列表中等待下次掉落复用
+ *
+ * @note 敌人的Enemy.Ability.SpawnStone蓝图能力目前仍直接生成石头，尚未改为调用SpawnStone，
+ *       在能力切换之前对象池不会生效，掉落的石头沿用蓝图中的销毁逻辑
+ */
+UCLASS()
+class GAS_FIGHT_DEMO_API UFightPickUpPoolSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	// ~Begin USubsystem Interface
+	virtual void Deinitialize() override;
+	// ~End USubsystem Interface
+
+	/**
+	 * @brief 在指定位置掉落石头（仅服务器），供敌人的Enemy.Ability.SpawnStone能力调用（尚未接入）
+	 *
+	 * @param InStoneClass 石头类
+	 * @param InLocation 掉落位置
+	 * @param InStackCount 掉落的层数
+	 *
+	 * @return 承载这次掉落的石头，可能是叠加后的已有石头；客户端上返回nullptr
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Fight|PickUp", meta = (DisplayName = "Spawn Pooled Stone"))
+	AFightStoneBase* SpawnStone(TSubclassOf<AFightStoneBase> InStoneClass, const FVector& InLocation, int32 InStackCount = 1);
+
+	/**
+	 * @brief 回收石头到空闲列表
+	 */
+	void ReleaseStone(AFightStoneBase* InStone);
+
+protected:
+	// ~Begin UWorldSubsystem Interface
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	// ~End UWorldSubsystem Interface
+
+private:
+	/**
+	 * @brief 找到距离掉落位置最近、效果相同的存活石头
+	 *
+	 * @param InMaxDistance 查找半径
+	 */
+	AFightStoneBase* FindMergeTarget(TSubclassOf<UGameplayEffect> InEffectClass, const FVector& InLocation, float InMaxDistance) const;
+
+	/**
+	 * @brief 从空闲列表取出石头，没有空闲的石头时生成新的
+	 */
+	AFightStoneBase* AcquireStone(TSubclassOf<AFightStoneBase> InStoneClass, const FVector& InLocation);
+
+	// 存活的石头，按生成先后排列
+	TArray<TWeakObjectPtr<AFightStoneBase>> AliveStones;
+
+	// 按石头类保存的空闲石头
+	TMap<FObjectKey, TArray<TWeakObjectPtr<AFightStoneBase>>> FreeStones;
+};
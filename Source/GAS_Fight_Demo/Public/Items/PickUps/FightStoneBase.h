@@ -9,6 +9,7 @@
 
 class UFightAbilitySystemComponent;
 class UGameplayEffect;
+class UFightPickUpPoolSubsystem;
 
 
 UCLASS()
@@ -17,15 +18,80 @@ class GAS_FIGHT_DEMO_API AFightStoneBase : public AFightPickUpBase
 	GENERATED_BODY()
 	
 public:
+	// ~Begin AActor Interface
+	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+	// ~End AActor Interface
+
 	void Consume(UFightAbilitySystemComponent* AbilitySystemComponent, int32 ApplyLevel);
 
+	/**
+	 * @brief 批量消耗石头
+	 *
+	 * 按效果类分组，每组只创建一份规格：可堆叠的持续效果以堆叠层数一次应用，瞬时效果复用这份规格逐层执行。
+	 * 由对象池生成的石头消耗后由服务器回收到池中，不再调用会销毁石头的OnStoneConsumed
+	 */
+	static void ConsumeStones(TConstArrayView<AFightStoneBase*> InStones, UFightAbilitySystemComponent* AbilitySystemComponent,
+		int32 ApplyLevel);
+
+	/**
+	 * @brief 设置/叠加石头代表的层数（仅服务器），附近掉落的同类石头合并为一块
+	 */
+	void SetStackCount(int32 InStackCount);
+	void AddStacks(int32 InStacksToAdd);
+
+	FORCEINLINE int32 GetStackCount() const { return StackCount; }
+	FORCEINLINE TSubclassOf<UGameplayEffect> GetStoneGameplayEffectClass() const { return StoneGameplayEffectClass; }
+
+#if WITH_DEV_AUTOMATION_TESTS
+	/**
+	 * @brief 仅供自动化测试使用 --> 测试中不加载石头蓝图，直接指定石头应用的效果类
+	 */
+	FORCEINLINE void SetStoneGameplayEffectClassForTesting(TSubclassOf<UGameplayEffect> InEffectClass) { StoneGameplayEffectClass = InEffectClass; }
+#endif
+
 protected:
+	// ~Begin AFightPickUpBase Interface
+	virtual void OnPickUpDeactivated() override;
+	// ~End AFightPickUpBase Interface
+
 	virtual void OnPickUpCollisionSphereBeginOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor,
 		UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult) override;
+	virtual void OnPickUpCollisionSphereEndOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor,
+		UPrimitiveComponent* OtherComp, int32 OtherBodyIndex) override;
 
 	UFUNCTION(BlueprintImplementableEvent, meta = (DisplayName = "OnStoneConsumed"))
 	void BP_OnStoneConsumed();
 
+	/**
+	 * @brief 对象池中的石头被消耗时调用，只用于播放特效/音效，不能销毁石头 --> 石头已回收到池中
+	 *
+	 * 由复制的回收状态驱动，服务器与所有看得到这块石头的客户端都会调用
+	 */
+	UFUNCTION(BlueprintImplementableEvent, meta = (DisplayName = "OnPooledStoneConsumed"))
+	void BP_OnPooledStoneConsumed();
+
 	UPROPERTY(EditDefaultsOnly)
 	TSubclassOf<UGameplayEffect> StoneGameplayEffectClass;
+
+private:
+	friend class UFightPickUpPoolSubsystem;
+
+	void MarkAsPooled();
+
+	/**
+	 * @brief 记录本次回收是否由消耗引起 --> 与激活状态一同复制，预算不足时的回收不播放消耗特效
+	 */
+	void SetConsumed(bool bInConsumed);
+
+	// 合并后这块石头代表的层数
+	UPROPERTY(Replicated, BlueprintReadOnly, Category = "Stone", meta = (AllowPrivateAccess = "true"))
+	int32 StackCount = 1;
+
+	// 是否由对象池生成 --> 只有池中的石头消耗后回收，其余沿用蓝图中的销毁逻辑；
+	// 客户端也会执行消耗，需要复制才能走同样的分支
+	UPROPERTY(Replicated)
+	bool bIsPooled = false;
+
+	UPROPERTY(Replicated)
+	bool bConsumed = false;
 };
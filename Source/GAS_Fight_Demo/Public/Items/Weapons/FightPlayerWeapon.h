@@ -73,7 +73,18 @@ public:
 	UFUNCTION(BlueprintPure)
 	TArray<FGameplayAbilitySpecHandle> GetGrantedAbilitySpecHandles() const;
 
+protected:
+	// ~Begin AActor Interface
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+	// ~End AActor Interface
+
 private:
+	/**
+	 * @brief 武器被持有期间引用的UI资源（武器图标与特殊能力图标材质），生成时开始异步加载
+	 */
+	TArray<FSoftObjectPath> AcquiredUIAssetPaths;
+
 	/**
 	 * @brief 授予的能力规范句柄数组
 	 *
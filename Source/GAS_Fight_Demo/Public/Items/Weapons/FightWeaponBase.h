@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
+#include "FightTypes/FightTimerWheel.h"
 #include "FightWeaponBase.generated.h"
 
 
@@ -65,7 +66,23 @@ public:
 	 */
 	FOnTargetInteractedDelegate OnWeaponPulledFromTarget;
 
+	/**
+	 * @brief 切换武器的网络休眠状态（仅服务器）
+	 *
+	 * 卸下的武器挂在角色身上不再变化，休眠后不再参与每次网络更新的属性比较；
+	 * 进入休眠前保留一段延迟，让收回武器时的挂点变化先复制出去
+	 */
+	void SetWeaponNetDormant(bool bShouldBeDormant);
+
 protected:
+	// ~Begin AActor Interface
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+	// ~End AActor Interface
+
+	// 卸下后延迟多久进入网络休眠
+	UPROPERTY(EditDefaultsOnly, Category = "Weapons|Network")
+	float NetDormancyDelay = 1.f;
+
 	/**
 	 * @brief 武器网格体组件
 	 *
@@ -128,6 +145,11 @@ protected:
 	virtual void OnCollisionBoxEndOverlap(UPrimitiveComponent* OverlappedComponent, 
 		AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex);
 
+private:
+	void OnNetDormancyTimerFired();
+
+	FFightTimerHandle NetDormancyTimerHandle;
+
 public:
 	FORCEINLINE UBoxComponent* GetWeaponCollisionBox() const
 	{
@@ -0,0 +1,163 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Tasks/Pipe.h"
+
+
+/**
+ * @brief 单局生存模式的统计数据
+ */
+struct FFightRunStats
+{
+	int32 WaveReached = 0;
+	int32 EnemiesDefeated = 0;
+	float RunDurationSeconds = 0.f;
+
+	friend FArchive& operator<<(FArchive& Ar, FFightRunStats& RunStats)
+	{
+		Ar << RunStats.WaveReached;
+		Ar << RunStats.EnemiesDefeated;
+		Ar << RunStats.RunDurationSeconds;
+		return Ar;
+	}
+};
+
+
+/**
+ * @brief 由存档记录回放得到的生存模式进度
+ */
+struct FFightProgressData
+{
+	int32 HighestWaveReached = 0;
+	int32 TotalRunsStarted = 0;
+	FFightRunStats CurrentRun;
+	FFightRunStats BestRun;
+	TArray<FName> UnlockedWeaponTags;
+
+	friend FArchive& operator<<(FArchive& Ar, FFightProgressData& ProgressData)
+	{
+		Ar << ProgressData.HighestWaveReached;
+		Ar << ProgressData.TotalRunsStarted;
+		Ar << ProgressData.CurrentRun;
+		Ar << ProgressData.BestRun;
+		Ar << ProgressData.UnlockedWeaponTags;
+		return Ar;
+	}
+};
+
+
+/**
+ * @brief 存档记录类型，只允许在末尾追加新类型
+ */
+enum class EFightProgressRecordType : uint8
+{
+	// 完整进度快照，压缩存档时写入
+	Snapshot,
+	RunStarted,
+	WaveCheckpoint,
+	WeaponUnlocked
+};
+
+
+/**
+ * @brief 生存模式进度存档文件：带版本号的紧凑二进制格式，只追加写入
+ *
+ * 文件布局：
+ * [Magic:uint32][Version:uint16] 之后是若干条记录 [Type:uint8][PayloadSize:uint32][Crc:uint32][Payload]
+ *
+ * @details
+ * 1. 每次波次完成只需追加一条十几个字节的记录，而不是重新序列化整个存档
+ * 2. 读取时依次回放所有记录，遇到CRC不匹配或被截断的记录即停止 --> 写入过程中崩溃最多丢失最后一条记录
+ * 3. 记录数量超过阈值时，读取后会重写为"文件头 + 一条快照记录"
+ * 4. 所有磁盘读写都在同一个任务管道中按顺序异步执行
+ * 5. 异步读取期间追加的记录先缓存在内存中，回放完文件后再依次追加
+ */
+class GAS_FIGHT_DEMO_API FFightProgressSaveFile
+{
+public:
+	explicit FFightProgressSaveFile(const FString& InFilePath);
+	~FFightProgressSaveFile();
+
+	/**
+	 * @brief 同步读取并回放存档文件
+	 *
+	 * @return 文件不存在或读取成功时返回true，版本过新或文件头损坏时返回false（此时不再写入，避免覆盖）
+	 */
+	bool Load();
+
+	/**
+	 * @brief 在写入管道中异步读取存档文件，读取完成后在游戏线程回放
+	 *
+	 * 回放完成前GetProgressData返回空的进度
+	 */
+	void LoadAsync();
+
+	FORCEINLINE bool IsLoading() const { return bIsLoading; }
+
+	void AppendRunStarted();
+	void AppendWaveCheckpoint(const FFightRunStats& InRunStats);
+	void AppendWeaponUnlocked(FName InWeaponTagName);
+
+	/**
+	 * @brief 等待所有排队中的写入完成，异步读取尚未回放时同步完成读取，缓存的记录不会丢失
+	 */
+	void WaitForPendingWrites();
+
+	FORCEINLINE const FFightProgressData& GetProgressData() const { return ProgressData; }
+
+private:
+	/**
+	 * @brief 回放读到的文件内容，再追加读取期间缓存的记录
+	 *
+	 * @param InFileData 文件内容，文件不存在时为nullptr
+	 */
+	bool CompleteLoad(const TArray<uint8>* InFileData);
+
+	/**
+	 * @brief 回放文件中的所有记录，返回值同Load
+	 */
+	bool ReplayFileData(const TArray<uint8>* InFileData);
+
+	/**
+	 * @brief 把记录应用到内存中的进度数据
+	 */
+	void ApplyRecord(EFightProgressRecordType InRecordType, FArchive& PayloadReader);
+
+	/**
+	 * @brief 应用记录并将其异步追加到文件末尾
+	 */
+	void AppendRecord(EFightProgressRecordType InRecordType, TArray<uint8>& InPayload);
+
+	/**
+	 * @brief 重写文件为"文件头 + 一条快照记录"
+	 */
+	void CompactFile();
+
+	static void WriteHeader(FArchive& Ar);
+	static void WriteRecord(FArchive& Ar, EFightProgressRecordType InRecordType, TArray<uint8>& InPayload);
+
+	FString FilePath;
+	FFightProgressData ProgressData;
+
+	// 当前文件中的记录数量，用于决定是否需要压缩
+	int32 NumRecordsInFile = 0;
+
+	// 文件不存在或已写入文件头
+	bool bHasValidHeader = false;
+
+	// 文件版本比当前代码新或已损坏时为true，禁止一切写入
+	bool bIsReadOnly = false;
+
+	// 异步读取已发起但尚未回放
+	bool bIsLoading = false;
+
+	// 异步读取期间追加的记录
+	TArray<TPair<EFightProgressRecordType, TArray<uint8>>> PendingRecords;
+
+	UE::Tasks::FPipe WritePipe;
+
+	// 游戏线程上的读取回调通过它判断文件对象是否仍然存在
+	TSharedPtr<bool, ESPMode::ThreadSafe> LifetimeToken = MakeShared<bool, ESPMode::ThreadSafe>(true);
+};
@@ -0,0 +1,120 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "FightTypes/FightEnumTypes.h"
+#include "GameplayTagContainer.h"
+#include "SaveGame/FightProgressSaveFile.h"
+#include "FightSaveGameSubsystem.generated.h"
+
+
+class UFightSaveGame;
+class USaveGame;
+
+DECLARE_MULTICAST_DELEGATE(FOnFightSaveGameLoadedDelegate);
+
+
+/**
+ * @brief 存档子系统：负责存档的异步读写与内存缓存
+ *
+ * @details
+ * 1. GameInstance初始化时通过AsyncLoadGameFromSlot读取一次存档并缓存，读取完成前不会同步等待磁盘
+ * 2. 之后所有读取都直接访问内存中的存档对象，不再触碰磁盘；需要在启动时读取存档的系统通过CallOrRegister_OnSaveGameLoaded等待读取完成
+ * 3. 写入只修改内存并标记为脏，由定时器合并后通过AsyncSaveGameToSlot异步落盘
+ * 4. 子系统销毁（游戏退出）时若仍有未落盘的修改，同步写入一次
+ * 5. 存档槽名称只在初始化时由GameData_SaveGame_Slot_1标签生成一次
+ * 6. 生存模式进度（波次、单局统计、解锁武器）写入独立的FFightProgressSaveFile，以追加记录的方式增量保存，同样在初始化时异步读取
+ */
+UCLASS()
+class GAS_FIGHT_DEMO_API UFightSaveGameSubsystem : public UGameInstanceSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	// ~Begin USubsystem Interface
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	// ~End USubsystem Interface
+
+	/**
+	 * @brief 读取存档中的游戏难度
+	 *
+	 * @return 存在存档且初始异步读取已完成时返回true
+	 */
+	bool TryGetSavedGameDifficulty(EFightGameDifficulty& OutSavedDifficulty);
+
+	/**
+	 * @brief 修改存档中的游戏难度，实际写盘被延迟合并
+	 *
+	 * 初始读取完成前的修改会覆盖随后读到的存档
+	 */
+	void SetSavedGameDifficulty(EFightGameDifficulty InDifficultyToSave);
+
+	/**
+	 * @brief 初始读取已完成时立即调用，否则在读取完成时调用
+	 */
+	void CallOrRegister_OnSaveGameLoaded(FOnFightSaveGameLoadedDelegate::FDelegate&& InDelegate);
+
+	FORCEINLINE bool IsSaveGameLoaded() const { return bInitialLoadCompleted; }
+
+	/**
+	 * @brief 立即把未落盘的修改异步写入磁盘
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Fight|SaveGame")
+	void FlushPendingWrites();
+
+	FORCEINLINE const FString& GetSaveSlotName() const { return SaveSlotName; }
+
+	/**
+	 * @brief 记录新的一局生存模式开始
+	 */
+	void RecordRunStarted();
+
+	/**
+	 * @brief 波次完成时的进度检查点，只追加一条很小的记录
+	 */
+	void RecordWaveCheckpoint(int32 InWaveReached, int32 InEnemiesDefeated, float InRunDurationSeconds);
+
+	/**
+	 * @brief 记录武器已解锁，已解锁的武器不会重复写入
+	 */
+	void RecordWeaponUnlocked(FGameplayTag InWeaponTag);
+
+	UFUNCTION(BlueprintPure, Category = "Fight|SaveGame")
+	int32 GetHighestWaveReached() const;
+
+	UFUNCTION(BlueprintPure, Category = "Fight|SaveGame")
+	bool IsWeaponUnlocked(FGameplayTag InWeaponTag) const;
+
+protected:
+	/**
+	 * @brief 获取缓存的存档对象，不存在时创建一个新的
+	 */
+	UFightSaveGame* GetOrCreateCachedSaveGame();
+
+	/**
+	 * @brief 标记存档已修改，并延迟合并写入
+	 */
+	void MarkSaveGameDirty();
+
+	UPROPERTY()
+	UFightSaveGame* CachedSaveGame;
+
+private:
+	void OnInitialLoadCompleted(const FString& InSlotName, const int32 InUserIndex, USaveGame* InLoadedSaveGame);
+	void OnAsyncSaveCompleted(const FString& InSlotName, const int32 InUserIndex, bool bSuccess);
+
+	FString SaveSlotName;
+
+	FOnFightSaveGameLoadedDelegate OnSaveGameLoaded;
+
+	TUniquePtr<FFightProgressSaveFile> ProgressSaveFile;
+
+	FTimerHandle FlushTimerHandle;
+
+	bool bInitialLoadCompleted = false;
+	bool bIsDirty = false;
+	bool bIsSaveInFlight = false;
+};
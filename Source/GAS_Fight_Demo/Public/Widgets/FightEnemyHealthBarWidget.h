@@ -0,0 +1,36 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Widgets/FightWidgetBase.h"
+#include "FightEnemyHealthBarWidget.generated.h"
+
+
+class UProgressBar;
+
+
+/**
+ * @brief 共享血条覆盖层使用的池化血条控件
+ *
+ * 不绑定任何敌人，由UEnemyHealthBarOverlayComponent每帧直接推送血量百分比与屏幕位置
+ */
+UCLASS()
+class GAS_FIGHT_DEMO_API UFightEnemyHealthBarWidget : public UFightWidgetBase
+{
+	GENERATED_BODY()
+
+public:
+	/**
+	 * @brief 设置血量百分比，数值未变化时不会触发控件更新
+	 */
+	void SetHealthPercent(float InHealthPercent);
+
+protected:
+	// 蓝图中必须有同名的ProgressBar控件
+	UPROPERTY(meta = (BindWidget))
+	UProgressBar* HealthProgressBar;
+
+private:
+	float CachedHealthPercent = -1.f;
+};
@@ -0,0 +1,82 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "FightUIAssetCacheSubsystem.generated.h"
+
+
+struct FStreamableHandle;
+
+DECLARE_DELEGATE_OneParam(FFightOnUIAssetLoadedDelegate, UObject* /*LoadedAsset*/);
+
+
+/**
+ * @brief UI资源缓存项：同一资源的所有请求共享一个流式加载句柄
+ */
+USTRUCT()
+struct FFightUIAssetEntry
+{
+	GENERATED_BODY()
+
+	// 加载完成后持有强引用，直到引用计数归零
+	UPROPERTY()
+	UObject* LoadedAsset = nullptr;
+
+	TSharedPtr<FStreamableHandle> StreamableHandle;
+
+	// 加载完成前到达的请求，完成后统一回调
+	TArray<FFightOnUIAssetLoadedDelegate> PendingCallbacks;
+
+	int32 RefCount = 0;
+};
+
+
+/**
+ * @brief UI资源缓存子系统：武器图标、能力图标材质等UI资源的异步加载与引用计数
+ *
+ * @details
+ * 1. 武器生成时获取其UI资源的引用，被持有期间资源一直驻留内存
+ * 2. 同一资源的并发请求只发起一次异步加载，完成后依次回调
+ * 3. 资源已在内存中时直接回调，不再经过流式管理器
+ * 4. 引用计数归零时释放句柄，交由GC回收
+ */
+UCLASS()
+class GAS_FIGHT_DEMO_API UFightUIAssetCacheSubsystem : public UGameInstanceSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	// ~Begin USubsystem Interface
+	virtual void Deinitialize() override;
+	// ~End USubsystem Interface
+
+	/**
+	 * @brief 获取资源引用并在加载完成后回调，资源已加载时立即回调
+	 *
+	 * 加载失败时以nullptr回调；每次调用都必须有一次对应的ReleaseAsset
+	 */
+	void AcquireAsset(const FSoftObjectPath& InAssetPath, FFightOnUIAssetLoadedDelegate InOnLoaded = FFightOnUIAssetLoadedDelegate());
+
+	/**
+	 * @brief 释放一次资源引用
+	 */
+	void ReleaseAsset(const FSoftObjectPath& InAssetPath);
+
+	/**
+	 * @brief 获取已加载完成的资源，尚未加载或未被引用时返回nullptr
+	 */
+	UObject* GetLoadedAsset(const FSoftObjectPath& InAssetPath) const;
+
+private:
+	void OnAssetLoaded(FSoftObjectPath InAssetPath);
+
+	/**
+	 * @brief 资源就绪后执行并清空等待中的回调
+	 */
+	void FlushPendingCallbacks(const FSoftObjectPath& InAssetPath);
+
+	UPROPERTY()
+	TMap<FSoftObjectPath, FFightUIAssetEntry> AssetEntries;
+};